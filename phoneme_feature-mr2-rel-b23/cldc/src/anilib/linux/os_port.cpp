@@ -31,6 +31,12 @@
 
 #include <anilib_impl.h>
 
+#if OS_HAS_DESCRIPTOR_WAIT
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#endif
+
 Os_Event Os_CreateEvent(jboolean *status) {
   Os_Event event = (Os_Event) malloc(sizeof(Os_EventStruct));
 
@@ -146,3 +152,179 @@ Os_Thread Os_CreateThread(int proc(void *parameter), void *arg,
 void Os_DisposeThread(Os_Thread thread) {
   /* IMPL_NOTE: nothing to do? */
 }
+
+#if OS_HAS_DESCRIPTOR_WAIT
+
+static int epoll_fd = -1;
+
+/*
+ * PoolThreads write to this pipe when they finish, so that
+ * Os_WaitForDescriptors() also returns for them.
+ */
+static int wakeup_pipe[2] = {-1, -1};
+
+/*
+ * The ANI_WAIT_XXX events currently armed for each descriptor. All
+ * descriptors are registered with EPOLLONESHOT, so the events of
+ * several Java threads waiting for the same descriptor are merged
+ * and disarmed together when the descriptor fires.
+ */
+static unsigned char *armed_events;
+static int armed_events_size;
+
+jboolean Os_InitializeDescriptorWait() {
+  struct epoll_event ev;
+
+  epoll_fd = epoll_create(64);
+  if (epoll_fd < 0) {
+    return KNI_FALSE;
+  }
+  if (pipe(wakeup_pipe) != 0) {
+    wakeup_pipe[0] = wakeup_pipe[1] = -1;
+    Os_DisposeDescriptorWait();
+    return KNI_FALSE;
+  }
+  fcntl(wakeup_pipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(wakeup_pipe[1], F_SETFL, O_NONBLOCK);
+
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = wakeup_pipe[0];
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_pipe[0], &ev) != 0) {
+    Os_DisposeDescriptorWait();
+    return KNI_FALSE;
+  }
+  return KNI_TRUE;
+}
+
+void Os_DisposeDescriptorWait() {
+  if (wakeup_pipe[0] >= 0) {
+    close(wakeup_pipe[0]);
+    close(wakeup_pipe[1]);
+    wakeup_pipe[0] = wakeup_pipe[1] = -1;
+  }
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+    epoll_fd = -1;
+  }
+  free(armed_events);
+  armed_events = NULL;
+  armed_events_size = 0;
+}
+
+static unsigned int to_epoll_events(int events) {
+  unsigned int result = EPOLLONESHOT;
+  if (events & ANI_WAIT_READ) {
+    result |= EPOLLIN;
+  }
+  if (events & ANI_WAIT_WRITE) {
+    result |= EPOLLOUT;
+  }
+  return result;
+}
+
+jboolean Os_AddDescriptorWait(int fd, int events) {
+  struct epoll_event ev;
+
+  if (fd < 0) {
+    return KNI_FALSE;
+  }
+  if (fd >= armed_events_size) {
+    int new_size = armed_events_size * 2;
+    unsigned char *new_events;
+    if (new_size <= fd) {
+      new_size = fd + 64;
+    }
+    new_events = (unsigned char*)realloc(armed_events, new_size);
+    if (new_events == NULL) {
+      return KNI_FALSE;
+    }
+    memset(new_events + armed_events_size, 0, new_size - armed_events_size);
+    armed_events = new_events;
+    armed_events_size = new_size;
+  }
+
+  memset(&ev, 0, sizeof(ev));
+  ev.data.fd = fd;
+  ev.events = to_epoll_events(events);
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    if (errno != EEXIST) {
+      return KNI_FALSE;
+    }
+    /* Another Java thread is waiting for this descriptor as well */
+    events |= armed_events[fd];
+    ev.events = to_epoll_events(events);
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev) != 0) {
+      return KNI_FALSE;
+    }
+  }
+  armed_events[fd] = (unsigned char)events;
+  return KNI_TRUE;
+}
+
+/*
+ * Called before fd is closed: a closed descriptor would silently drop
+ * out of the epoll set, and its number may be reused right away.
+ */
+void Os_RemoveDescriptorWait(int fd) {
+  struct epoll_event ev;
+
+  if (fd < 0) {
+    return;
+  }
+  /* Pre-2.6.9 kernels need a non-NULL event for EPOLL_CTL_DEL */
+  memset(&ev, 0, sizeof(ev));
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, &ev);
+  if (fd < armed_events_size) {
+    armed_events[fd] = 0;
+  }
+}
+
+int Os_WaitForDescriptors(int *ready_fds, int max_ready, jlong ms) {
+  struct epoll_event events[64];
+  int timeout, n, i, ready_count = 0;
+
+  if (ms < 0) {
+    timeout = -1;
+  } else if (ms > 0x7fffffff) {
+    timeout = 0x7fffffff;
+  } else {
+    timeout = (int)ms;
+  }
+  if (max_ready > (int)(sizeof(events) / sizeof(events[0]))) {
+    max_ready = sizeof(events) / sizeof(events[0]);
+  }
+
+  n = epoll_wait(epoll_fd, events, max_ready, timeout);
+  for (i=0; i<n; i++) {
+    int fd = events[i].data.fd;
+    if (fd == wakeup_pipe[0]) {
+      char buffer[64];
+      while (read(fd, buffer, sizeof(buffer)) > 0) {
+        /* drain the wakeup pipe */
+      }
+    } else {
+      /* EPOLLONESHOT has disarmed the descriptor */
+      armed_events[fd] = 0;
+      ready_fds[ready_count++] = fd;
+    }
+  }
+  return ready_count;
+}
+
+void Os_WakeupDescriptorWait() {
+  if (wakeup_pipe[1] >= 0) {
+    char c = 0;
+    int n;
+    do {
+      n = write(wakeup_pipe[1], &c, 1);
+    } while (n < 0 && errno == EINTR);
+    /*
+     * A full pipe (EAGAIN) already holds a pending wakeup. If the pipe
+     * is broken, the waits fall back to their timeouts.
+     */
+    JVM_ASSERT(n == 1 || errno == EAGAIN, "cannot write wakeup pipe");
+  }
+}
+
+#endif /* OS_HAS_DESCRIPTOR_WAIT */
@@ -37,6 +37,16 @@
 #include <sys/time.h>
 #include <sys/times.h>
 #include <errno.h>
+
+/*
+ * Blocked socket operations wait in a single epoll set instead of
+ * occupying a PoolThread each. epoll requires Linux 2.6 and glibc 2.3.2;
+ * build with -DOS_HAS_DESCRIPTOR_WAIT=0 for older systems.
+ */
+#ifndef OS_HAS_DESCRIPTOR_WAIT
+#define OS_HAS_DESCRIPTOR_WAIT 1
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -60,6 +70,15 @@ extern Os_Thread Os_CreateThread(int proc(void *parameter), void *arg,
                                  jboolean *status);
 extern void Os_DisposeThread(Os_Thread thread);
 
+#if OS_HAS_DESCRIPTOR_WAIT
+extern jboolean Os_InitializeDescriptorWait();
+extern void Os_DisposeDescriptorWait();
+extern jboolean Os_AddDescriptorWait(int fd, int events);
+extern void Os_RemoveDescriptorWait(int fd);
+extern int  Os_WaitForDescriptors(int *ready_fds, int max_ready, jlong ms);
+extern void Os_WakeupDescriptorWait();
+#endif
+
 extern void Os_DisposeEvent(Os_Event event);
 
 #ifdef __cplusplus
@@ -29,18 +29,80 @@
 
 static jint waiter_count;
 
+#if OS_HAS_DESCRIPTOR_WAIT
+static jboolean descriptor_wait_initialized;
+
+/* Maximum number of ready descriptors handled per wait */
+#define MAX_READY_DESCRIPTORS 32
+
+/*
+ * Every ANI_WaitForDescriptor() and ANI_CloseDescriptor() takes the
+ * next serial number. A wait for a descriptor is ended by a close if
+ * the close has a later serial number, which is recorded per descriptor
+ * in closed_serials.
+ */
+static unsigned int descriptor_serial;
+static unsigned int *closed_serials;
+static int closed_serials_size;
+
+/* Set by ANI_CloseDescriptor() until the waiters have been resumed */
+static jboolean descriptors_closed;
+
+static jboolean is_closed_since(int fd, unsigned int serial) {
+  return fd >= 0 && fd < closed_serials_size &&
+         (jint)(closed_serials[fd] - serial) > 0;
+}
+
+/* Makes room for the closes of fd before anyone waits for it */
+static jboolean reserve_closed_serial(int fd) {
+  int new_size;
+  unsigned int *new_serials;
+
+  if (fd < closed_serials_size) {
+    return KNI_TRUE;
+  }
+  new_size = closed_serials_size * 2;
+  if (new_size <= fd) {
+    new_size = fd + 64;
+  }
+  new_serials = (unsigned int*)realloc(closed_serials,
+                                       new_size * sizeof(unsigned int));
+  if (new_serials == NULL) {
+    return KNI_FALSE;
+  }
+  memset(new_serials + closed_serials_size, 0,
+         (new_size - closed_serials_size) * sizeof(unsigned int));
+  closed_serials = new_serials;
+  closed_serials_size = new_size;
+  return KNI_TRUE;
+}
+#endif
+
 void ANI_Initialize() {
   PoolThread_InitializePool();
   waiter_count = 0;
+#if OS_HAS_DESCRIPTOR_WAIT
+  descriptor_wait_initialized = Os_InitializeDescriptorWait();
+#endif
 }
 
 void ANI_Dispose() {
+#if OS_HAS_DESCRIPTOR_WAIT
+  if (descriptor_wait_initialized) {
+    Os_DisposeDescriptorWait();
+    descriptor_wait_initialized = KNI_FALSE;
+  }
+  free(closed_serials);
+  closed_serials = NULL;
+  closed_serials_size = 0;
+  descriptors_closed = KNI_FALSE;
+#endif
   PoolThread_DisposePool();
 }
 
 jboolean ANI_Start() {
   ANI_BlockingInfo * p = (ANI_BlockingInfo*)SNI_GetReentryData(NULL);
-  if (p == NULL) {
+  if (p == NULL || p->type != ANI_BLOCK_INFO) {
     /*
      * Called for the first time for this ANI method invocation. We need to
      * allocate a PoolThread for this invocation
@@ -149,6 +211,122 @@ void ANI_End() {
   }
 }
 
+jboolean ANI_CanWaitForDescriptor() {
+#if OS_HAS_DESCRIPTOR_WAIT
+  ANI_DescriptorInfo * p = (ANI_DescriptorInfo*)SNI_GetReentryData(NULL);
+  return descriptor_wait_initialized &&
+         (p == NULL || p->type == ANI_DESCRIPTOR_INFO);
+#else
+  return KNI_FALSE;
+#endif
+}
+
+jboolean ANI_WaitForDescriptor(int fd, int events) {
+#if OS_HAS_DESCRIPTOR_WAIT
+  ANI_DescriptorInfo * p;
+
+  if (!descriptor_wait_initialized) {
+    return KNI_FALSE;
+  }
+  p = (ANI_DescriptorInfo*)SNI_GetReentryData(NULL);
+  JVM_ASSERT(p == NULL || p->type == ANI_DESCRIPTOR_INFO,
+             "cannot wait for a descriptor after ANI_Start()");
+  if (p == NULL) {
+    p = (ANI_DescriptorInfo*)SNI_AllocateReentryData(sizeof(*p));
+    if (p == NULL) {
+      return KNI_FALSE;
+    }
+  }
+  if (!reserve_closed_serial(fd) || !Os_AddDescriptorWait(fd, events)) {
+    return KNI_FALSE;
+  }
+  p->type = ANI_DESCRIPTOR_INFO;
+  p->fd = fd;
+  p->serial = ++descriptor_serial;
+  SNI_BlockThread();
+  return KNI_TRUE;
+#else
+  return KNI_FALSE;
+#endif
+}
+
+int ANI_GetWaitedDescriptor() {
+  ANI_DescriptorInfo * p = (ANI_DescriptorInfo*)SNI_GetReentryData(NULL);
+  if (p != NULL && p->type == ANI_DESCRIPTOR_INFO) {
+    return p->fd;
+  }
+  return -1;
+}
+
+void ANI_CloseDescriptor(int fd) {
+#if OS_HAS_DESCRIPTOR_WAIT
+  if (!descriptor_wait_initialized || fd < 0 || fd >= closed_serials_size) {
+    /* Nobody has ever waited for this descriptor */
+    return;
+  }
+  Os_RemoveDescriptorWait(fd);
+  closed_serials[fd] = ++descriptor_serial;
+  descriptors_closed = KNI_TRUE;
+#endif
+}
+
+jboolean ANI_IsWaitedDescriptorClosed() {
+#if OS_HAS_DESCRIPTOR_WAIT
+  ANI_DescriptorInfo * p = (ANI_DescriptorInfo*)SNI_GetReentryData(NULL);
+  return p != NULL && p->type == ANI_DESCRIPTOR_INFO &&
+         is_closed_since(p->fd, p->serial);
+#else
+  return KNI_FALSE;
+#endif
+}
+
+#if OS_HAS_DESCRIPTOR_WAIT
+/*
+ * Waits for the descriptors registered by ANI_WaitForDescriptor(). A
+ * finishing PoolThread wakes up this wait as well, so both kinds of
+ * blocked Java threads are served by a single wait.
+ */
+static void wait_for_descriptors(JVMSPI_BlockedThreadInfo * blocked_threads,
+                                 int blocked_threads_count, 
+                                 jlong timeout_milli_seconds) {
+  int ready_fds[MAX_READY_DESCRIPTORS];
+  int ready_count, i, j;
+
+  /* The waiters of closed descriptors need no wait to be resumed */
+  ready_count = Os_WaitForDescriptors(ready_fds, MAX_READY_DESCRIPTORS,
+                                      descriptors_closed ? 0 :
+                                      timeout_milli_seconds);
+
+  /*
+   * The blocked thread list holds the thread oops, which move during GC,
+   * so we can only look up the waiters of the ready descriptors here.
+   */
+  if (ready_count > 0 || descriptors_closed) {
+    for (i=0; i<blocked_threads_count; i++) {
+      JVMSPI_BlockedThreadInfo *info = &blocked_threads[i];
+      ANI_DescriptorInfo *p = (ANI_DescriptorInfo *)info->reentry_data;
+
+      if (info->reentry_data_size >= (int)sizeof(*p) &&
+          p->type == ANI_DESCRIPTOR_INFO) {
+        if (is_closed_since(p->fd, p->serial)) {
+          SNI_UnblockThread(info->thread_id);
+          continue;
+        }
+        for (j=0; j<ready_count; j++) {
+          if (p->fd == ready_fds[j]) {
+            SNI_UnblockThread(info->thread_id);
+            break;
+          }
+        }
+      }
+    }
+    descriptors_closed = KNI_FALSE;
+  }
+
+  PoolThread_UnblockFinished(blocked_threads, blocked_threads_count);
+}
+#endif
+
 void ANI_WaitForThreadUnblocking(JVMSPI_BlockedThreadInfo * blocked_threads,
                                  int blocked_threads_count, 
                                  jlong timeout_milli_seconds) {
@@ -185,6 +363,13 @@ void ANI_WaitForThreadUnblocking(JVMSPI_BlockedThreadInfo * blocked_threads,
 
     timeout_milli_seconds = 0;
   }
+#if OS_HAS_DESCRIPTOR_WAIT
+  if (descriptor_wait_initialized) {
+    wait_for_descriptors(blocked_threads, blocked_threads_count,
+                         timeout_milli_seconds);
+    return;
+  }
+#endif
   PoolThread_WaitForFinishOrTimeout(blocked_threads, blocked_threads_count,
                                     timeout_milli_seconds);
 }
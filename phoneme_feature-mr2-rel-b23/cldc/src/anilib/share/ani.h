@@ -221,6 +221,65 @@ void ANI_WaitForThreadUnblocking(JVMSPI_BlockedThreadInfo *blocked_threads,
                                  int blocked_threads_count,
                                  jlong timeout_milli_seconds);
 
+/**---------------------------------------------------------------------
+ *
+ * Waiting for descriptors without a native thread:
+ *
+ *----------------------------------------------------------------------*/
+
+/**
+ * Values for the 'events' parameter of 'ANI_WaitForDescriptor()'.
+ */
+#define ANI_WAIT_READ    0x01
+#define ANI_WAIT_WRITE   0x02
+
+/**
+ * Returns 'KNI_TRUE' if the current native method activation may wait
+ * for a descriptor with 'ANI_WaitForDescriptor()', i.e. if the platform
+ * provides an event-driven wait for descriptors and this activation is
+ * either the first one or a reentry after 'ANI_WaitForDescriptor()'.
+ *
+ * Returns 'KNI_FALSE' on a reentry after 'ANI_Start()'; the native
+ * method must then continue with its native thread.
+ */
+jboolean ANI_CanWaitForDescriptor();
+
+/**
+ * Suspend the current Java thread until the descriptor 'fd' becomes
+ * ready for the operations given by 'events', without tying up a native
+ * thread. Call this after a non-blocking operation on 'fd' has failed
+ * because it would block, then return from the native method. The
+ * native method is reentered when 'fd' is ready (or has an error) and
+ * should simply retry the operation.
+ *
+ * Returns 'KNI_FALSE' if the descriptor could not be registered. The
+ * current Java thread is then not suspended and the native method
+ * should fall back to 'ANI_Start()'.
+ */
+jboolean ANI_WaitForDescriptor(int fd, int events);
+
+/**
+ * On a reentry after 'ANI_WaitForDescriptor()', returns the descriptor
+ * that was waited for. Returns -1 otherwise.
+ */
+int ANI_GetWaitedDescriptor();
+
+/**
+ * Call this before closing a descriptor that Java threads may be
+ * waiting for with 'ANI_WaitForDescriptor()'. The descriptor is no
+ * longer waited for, and the waiting threads are reentered soon with
+ * 'ANI_IsWaitedDescriptorClosed()' returning 'KNI_TRUE'.
+ */
+void ANI_CloseDescriptor(int fd);
+
+/**
+ * On a reentry after 'ANI_WaitForDescriptor()', returns 'KNI_TRUE' if
+ * the descriptor was closed with 'ANI_CloseDescriptor()' meanwhile. The
+ * native method must then fail instead of retrying the operation, as
+ * the descriptor may already have been reused for another file.
+ */
+jboolean ANI_IsWaitedDescriptorClosed();
+
 /*
  * Initialize the ANI library for the VM.
  */
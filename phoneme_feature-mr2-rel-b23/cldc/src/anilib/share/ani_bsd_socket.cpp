@@ -130,6 +130,150 @@ static jboolean set_blocking_flags(int *fd, jboolean is_blocking) {
 #endif
 }
 
+#if USE_UNISTD_SOCKETS
+/*
+ * The socket operations below first try to complete without blocking.
+ * If the socket is not ready, the Java thread waits for it with
+ * ANI_WaitForDescriptor() and the native method retries the operation
+ * when it is reentered, so no PoolThread is tied up while the peer is
+ * silent. They return KNI_FALSE if the caller has to fall back to a
+ * PoolThread.
+ */
+#define WOULD_BLOCK(error) ((error) == EWOULDBLOCK || (error) == EAGAIN)
+
+static jboolean try_socket_read(int fd, char *buffer, int size, int *result) {
+  int n;
+
+  if (!ANI_CanWaitForDescriptor()) {
+    return KNI_FALSE;
+  }
+  if (ANI_IsWaitedDescriptorClosed()) {
+    // The socket was closed while we were waiting for it
+    *result = -1;
+    return KNI_TRUE;
+  }
+  n = recv(fd, buffer, size, MSG_DONTWAIT);
+  if (n < 0 && WOULD_BLOCK(errno)) {
+    if (!ANI_WaitForDescriptor(fd, ANI_WAIT_READ)) {
+      return KNI_FALSE;
+    }
+  } else if (n == 0) {
+    // The remote side has shut down the connection gracefully, see
+    // asynchronous_socket_read()
+    n = -1;
+  }
+  *result = n;
+  return KNI_TRUE;
+}
+
+static jboolean try_socket_write(int fd, char *buffer, int size, int *result) {
+  int n;
+
+  if (!ANI_CanWaitForDescriptor()) {
+    return KNI_FALSE;
+  }
+  if (ANI_IsWaitedDescriptorClosed()) {
+    // The socket was closed while we were waiting for it
+    *result = -1;
+    return KNI_TRUE;
+  }
+  n = send(fd, buffer, size, MSG_DONTWAIT);
+  if (n < 0 && WOULD_BLOCK(errno)) {
+    if (!ANI_WaitForDescriptor(fd, ANI_WAIT_WRITE)) {
+      return KNI_FALSE;
+    }
+  }
+  *result = n;
+  return KNI_TRUE;
+}
+#endif
+
+/*
+ * Resolves the host name and port passed to open0().
+ */
+static jboolean get_destination(struct sockaddr_in *destination_sin) {
+  struct hostent *phostent;
+  char *hostname;
+
+  KNI_StartHandles(1);
+  KNI_DeclareHandle(hostname_object);
+  KNI_GetParameterAsObject(1, hostname_object);
+
+  // hostname is always NUL terminated. See socket/Protocol.java for detail.
+  hostname = (char *)(SNI_GetRawArrayPointer(hostname_object));
+  // 'gethostbyname()' is NON-REENTRANT and its result is in global memory!
+  // => its call must not be moved to 'asynchronous_connect_socket()'!
+  phostent = gethostbyname(hostname);
+  KNI_EndHandles();
+
+  if (phostent == NULL) {
+    return KNI_FALSE;
+  }
+  destination_sin->sin_family = AF_INET;
+  destination_sin->sin_port = htons((short)KNI_GetParameterAsInt(2));
+  memcpy((char *) &destination_sin->sin_addr,
+         phostent->h_addr, phostent->h_length);
+  return KNI_TRUE;
+}
+
+#if USE_UNISTD_SOCKETS
+/*
+ * Connects without a PoolThread, see try_socket_read(). On success,
+ * *result is the connected socket (switched back to blocking mode for
+ * the PoolThread fallbacks of the other operations) or -1.
+ */
+static jboolean try_socket_connect(int *result) {
+  int fd;
+
+  if (!ANI_CanWaitForDescriptor()) {
+    return KNI_FALSE;
+  }
+  fd = ANI_GetWaitedDescriptor();
+  if (fd < 0) {
+    struct sockaddr_in destination_sin;
+
+    *result = -1;
+    if (!get_destination(&destination_sin)) {
+      return KNI_TRUE;
+    }
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || !set_blocking_flags(&fd, /*is_blocking*/ KNI_FALSE)) {
+      return KNI_TRUE;
+    }
+    if (connect(fd, (struct sockaddr *) &destination_sin,
+                sizeof(destination_sin)) != 0) {
+      int error = errno;
+      jboolean waiting = KNI_FALSE;
+      if (error == EINPROGRESS) {
+        waiting = ANI_WaitForDescriptor(fd, ANI_WAIT_WRITE);
+      }
+      if (!waiting) {
+        shutdown(fd, 2);
+        closesocket(fd);
+        // Let a PoolThread try again if we could not wait for the socket
+        return error != EINPROGRESS;
+      }
+      // We are reentered when the connection is established or failed
+      return KNI_TRUE;
+    }
+  } else {
+    // Reentered after waiting for the connection
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 ||
+        error != 0) {
+      shutdown(fd, 2);
+      closesocket(fd);
+      *result = -1;
+      return KNI_TRUE;
+    }
+  }
+  set_blocking_flags(&fd, /*is_blocking*/ KNI_TRUE);
+  *result = fd;
+  return KNI_TRUE;
+}
+#endif
+
 static jboolean
 asynchronous_connect_socket(void* parameter, jboolean is_non_blocking) {
   SocketOpenParameter *p = (SocketOpenParameter *)(parameter);
@@ -145,13 +289,16 @@ asynchronous_connect_socket(void* parameter, jboolean is_non_blocking) {
 KNIEXPORT KNI_RETURNTYPE_INT
 Java_com_sun_cldc_io_j2me_socket_Protocol_open0() {
   SocketOpenParameter *p;
-  struct hostent *phostent;
-  char *hostname;
-  int port;
   int result;
 
   init_sockets();
 
+#if USE_UNISTD_SOCKETS
+  if (try_socket_connect(&result)) {
+    KNI_ReturnInt(result);
+  }
+#endif
+
   if (!ANI_Start()) {
     ANI_Wait();
     KNI_ReturnInt(-1);
@@ -163,23 +310,7 @@ Java_com_sun_cldc_io_j2me_socket_Protocol_open0() {
         (ANI_AllocateParameterBlock(sizeof(SocketOpenParameter)));
     p->fd = -1;
 
-    KNI_StartHandles(1);
-    KNI_DeclareHandle(hostname_object);
-    KNI_GetParameterAsObject(1, hostname_object);
-
-    // hostname is always NUL terminated. See socket/Protocol.java for detail.
-    hostname = (char *)(SNI_GetRawArrayPointer(hostname_object));
-    // 'gethostbyname()' is NON-REENTRANT and its result is in global memory!
-    // => its call must not be moved to 'asynchronous_connect_socket()'!
-    phostent = gethostbyname(hostname);
-    KNI_EndHandles();
-
-    if (phostent != NULL) {
-      p->destination_sin.sin_family = AF_INET;
-      port = KNI_GetParameterAsInt(2);
-      p->destination_sin.sin_port = htons((short)port);
-      memcpy((char *) &p->destination_sin.sin_addr,
-             phostent->h_addr, phostent->h_length);
+    if (get_destination(&p->destination_sin)) {
       p->fd = socket(AF_INET, SOCK_STREAM, 0);
       if (p->fd >= 0 && set_blocking_flags(&p->fd, /*is_blocking*/ KNI_TRUE) &&
           !ANI_UseFunction(asynchronous_connect_socket,
@@ -247,6 +378,24 @@ Java_com_sun_cldc_io_j2me_socket_Protocol_readBuf() {
   int result = -1;
   SocketBufferParameter *p;
 
+#if USE_UNISTD_SOCKETS
+  {
+    jboolean done;
+    KNI_StartHandles(1);
+    KNI_DeclareHandle(buffer_object);
+    KNI_GetParameterAsObject(2, buffer_object);
+    done = try_socket_read(/*fd*/ KNI_GetParameterAsInt(1),
+                           (char *)SNI_GetRawArrayPointer(buffer_object) +
+                           KNI_GetParameterAsInt(3),
+                           /*buffer_size*/ KNI_GetParameterAsInt(4),
+                           &result);
+    KNI_EndHandles();
+    if (done) {
+      KNI_ReturnInt(result);
+    }
+  }
+#endif
+
   if (!ANI_Start()) {
     ANI_Wait();
     KNI_ReturnInt(-1);
@@ -284,6 +433,16 @@ Java_com_sun_cldc_io_j2me_socket_Protocol_readByte() {
   int result = -1;
   SocketBufferParameter *p;
 
+#if USE_UNISTD_SOCKETS
+  {
+    unsigned char b;
+    if (try_socket_read(/*fd*/ KNI_GetParameterAsInt(1), (char *)&b,
+                        /*buffer_size*/ 1, &result)) {
+      KNI_ReturnInt(result == 1 ? b : -1);
+    }
+  }
+#endif
+
   if (!ANI_Start()) {
     ANI_Wait();
     KNI_ReturnInt(-1);
@@ -332,6 +491,24 @@ Java_com_sun_cldc_io_j2me_socket_Protocol_writeBuf() {
   int result = -1;
   SocketBufferParameter *p;
 
+#if USE_UNISTD_SOCKETS
+  {
+    jboolean done;
+    KNI_StartHandles(1);
+    KNI_DeclareHandle(buffer_object);
+    KNI_GetParameterAsObject(2, buffer_object);
+    done = try_socket_write(/*fd*/ KNI_GetParameterAsInt(1),
+                            (char *)SNI_GetRawArrayPointer(buffer_object) +
+                            KNI_GetParameterAsInt(3),
+                            /*buffer_size*/ KNI_GetParameterAsInt(4),
+                            &result);
+    KNI_EndHandles();
+    if (done) {
+      KNI_ReturnInt(result);
+    }
+  }
+#endif
+
   if (!ANI_Start()) {
     ANI_Wait();
     KNI_ReturnInt(-1);
@@ -368,6 +545,16 @@ Java_com_sun_cldc_io_j2me_socket_Protocol_writeByte() {
   int result = -1;
   SocketBufferParameter *p;
 
+#if USE_UNISTD_SOCKETS
+  {
+    char b = (char)(KNI_GetParameterAsInt(2) & 0x000000ff);
+    if (try_socket_write(/*fd*/ KNI_GetParameterAsInt(1), &b,
+                         /*buffer_size*/ 1, &result)) {
+      KNI_ReturnInt(result);
+    }
+  }
+#endif
+
   if (!ANI_Start()) {
     ANI_Wait();
     KNI_ReturnInt(-1);
@@ -405,6 +592,10 @@ KNIEXPORT KNI_RETURNTYPE_VOID
 Java_com_sun_cldc_io_j2me_socket_Protocol_close0() {
   jint sock = KNI_GetParameterAsInt(1);
 
+  // Resume the threads waiting for this socket before its number can
+  // be reused
+  ANI_CloseDescriptor(sock);
+
   // NOTE: this would block the VM. A real implementation should
   // make this a async native method.
   shutdown(sock, 2);
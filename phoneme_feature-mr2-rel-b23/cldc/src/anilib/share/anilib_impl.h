@@ -73,6 +73,18 @@ typedef struct _ANI_BlockingInfo {
 
 #define ANI_BLOCK_INFO 0x12340000
 
+/*
+ * This datastructure records the descriptor a Java thread waits for
+ * in ANI_WaitForDescriptor().
+ */
+typedef struct _ANI_DescriptorInfo {
+  jint type;
+  jint fd;
+  unsigned int serial; /* orders this wait against the closes of 'fd' */
+} ANI_DescriptorInfo;
+
+#define ANI_DESCRIPTOR_INFO 0x12340001
+
 #define OS_TIMEOUT   0
 #define OS_SIGNALED  1
 
@@ -164,6 +164,9 @@ static int PoolThread_Run(void* arg) {
     pt->is_idle = KNI_TRUE;
     pt->function = NULL;
     Os_SignalEvent(thread_finished_event);
+#if OS_HAS_DESCRIPTOR_WAIT
+    Os_WakeupDescriptorWait();
+#endif
   }
 
   Os_DisposeEvent(pt->execute_event);
@@ -190,27 +193,11 @@ void PoolThread_StartExecution(PoolThread *pt) {
   Os_SignalEvent(pt->execute_event);
 }
 
-void 
-PoolThread_WaitForFinishOrTimeout(JVMSPI_BlockedThreadInfo * blocked_threads,
-                                  int blocked_threads_count, 
-                                  jlong timeout_milli_seconds) {
+static void unblock_finished(JVMSPI_BlockedThreadInfo * blocked_threads,
+                             int blocked_threads_count) {
   int i, j;
   ANI_BlockingInfo *p;
 
-  if (timeout_milli_seconds < 0) {
-    /* wait forever */
-    Os_WaitForEvent(thread_finished_event);
-  } else {
-    int retval = Os_WaitForEventOrTimeout(thread_finished_event, 
-                                          timeout_milli_seconds);
-    if (retval == OS_TIMEOUT) {
-      /*
-       * We just timed out without any PoolThread finishing.
-       */
-        return;
-    }
-  }
-
   for (i=0; i<NUM_POOL_THREADS; i++) {
     PoolThread * pt = &pool_threads[i];
     if (!pt->is_idle) {
@@ -237,6 +224,41 @@ PoolThread_WaitForFinishOrTimeout(JVMSPI_BlockedThreadInfo * blocked_threads,
   }
 }
 
+void 
+PoolThread_WaitForFinishOrTimeout(JVMSPI_BlockedThreadInfo * blocked_threads,
+                                  int blocked_threads_count, 
+                                  jlong timeout_milli_seconds) {
+  if (timeout_milli_seconds < 0) {
+    /* wait forever */
+    Os_WaitForEvent(thread_finished_event);
+  } else {
+    int retval = Os_WaitForEventOrTimeout(thread_finished_event, 
+                                          timeout_milli_seconds);
+    if (retval == OS_TIMEOUT) {
+      /*
+       * We just timed out without any PoolThread finishing.
+       */
+        return;
+    }
+  }
+
+  unblock_finished(blocked_threads, blocked_threads_count);
+}
+
+#if OS_HAS_DESCRIPTOR_WAIT
+/*
+ * Used when the caller has waited for the descriptor wait instead of
+ * thread_finished_event: PoolThread_Run() wakes up both.
+ */
+void PoolThread_UnblockFinished(JVMSPI_BlockedThreadInfo * blocked_threads,
+                                int blocked_threads_count) {
+  while (Os_WaitForEventOrTimeout(thread_finished_event, 0) == OS_SIGNALED) {
+    /* consume the signals we have not waited for */
+  }
+  unblock_finished(blocked_threads, blocked_threads_count);
+}
+#endif
+
 void PoolThread_Release(PoolThread *pt) {
   JVM_ASSERT(pt->is_idle, "must not be executing!");
   pt->is_used = KNI_FALSE;
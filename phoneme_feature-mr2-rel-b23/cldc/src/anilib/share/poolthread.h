@@ -64,6 +64,11 @@ extern void PoolThread_WaitForFinishOrTimeout(
                          JVMSPI_BlockedThreadInfo * blocked_threads,
                          int blocked_threads_count, 
                          jlong timeout_milli_seconds);
+#if OS_HAS_DESCRIPTOR_WAIT
+extern void PoolThread_UnblockFinished(
+                         JVMSPI_BlockedThreadInfo * blocked_threads,
+                         int blocked_threads_count);
+#endif
 extern void PoolThread_Release(PoolThread *pt);
 extern void PoolThread_StartExecution(PoolThread *pt);
 
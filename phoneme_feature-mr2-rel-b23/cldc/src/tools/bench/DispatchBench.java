@@ -0,0 +1,164 @@
+/*
+ *   
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+/**
+ * Dispatch benchmark of the C interpreter.
+ *
+ * <p>Runs small kernels that are dominated by the bytecodes the threaded
+ * dispatch loop handles inline -- local loads and stores, integer
+ * arithmetic, branches, array elements and fields -- and prints the best
+ * time of each. Run it with +UseThreadedDispatch and -UseThreadedDispatch
+ * to compare the two loops; with ENABLE_DETAILED_PERFORMANCE_COUNTERS,
+ * +PrintPerformanceCounters also reports bytecodes_per_sec. See
+ * GNUmakefile.
+ */
+public class DispatchBench {
+    static final int RUNS = 5;
+
+    static class Node {
+        int value;
+        Node next;
+    }
+
+    public static void main(String[] args) {
+        int checksum = 0;
+        checksum += report("sieve", new Runnable() {
+            public void run() { result = sieve(8192, 20); }
+        });
+        checksum += report("matrix", new Runnable() {
+            public void run() { result = matrix(24, 4); }
+        });
+        checksum += report("sort", new Runnable() {
+            public void run() { result = sort(1024, 2); }
+        });
+        checksum += report("list", new Runnable() {
+            public void run() { result = list(1024, 100); }
+        });
+        System.out.println("DispatchBench: checksum " + checksum);
+    }
+
+    static int result;
+
+    static int report(String name, Runnable kernel) {
+        long best = Long.MAX_VALUE;
+        for (int run = 0; run < RUNS; run++) {
+            long start = System.currentTimeMillis();
+            kernel.run();
+            long time = System.currentTimeMillis() - start;
+            if (time < best) {
+                best = time;
+            }
+        }
+        System.out.println("DispatchBench: " + name + " " + best + " ms");
+        return result;
+    }
+
+    static int sieve(int size, int passes) {
+        boolean[] composite = new boolean[size];
+        int primes = 0;
+        for (int pass = 0; pass < passes; pass++) {
+            primes = 0;
+            for (int i = 0; i < size; i++) {
+                composite[i] = false;
+            }
+            for (int i = 2; i < size; i++) {
+                if (!composite[i]) {
+                    primes++;
+                    for (int j = i + i; j < size; j += i) {
+                        composite[j] = true;
+                    }
+                }
+            }
+        }
+        return primes;
+    }
+
+    static int matrix(int n, int passes) {
+        int[][] a = new int[n][n];
+        int[][] b = new int[n][n];
+        int[][] c = new int[n][n];
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                a[i][j] = i + j;
+                b[i][j] = i - j;
+            }
+        }
+        for (int pass = 0; pass < passes; pass++) {
+            for (int i = 0; i < n; i++) {
+                int[] ai = a[i];
+                int[] ci = c[i];
+                for (int j = 0; j < n; j++) {
+                    int sum = 0;
+                    for (int k = 0; k < n; k++) {
+                        sum += ai[k] * b[k][j];
+                    }
+                    ci[j] = sum;
+                }
+            }
+        }
+        return c[n - 1][n - 1];
+    }
+
+    static int sort(int size, int passes) {
+        int[] data = new int[size];
+        int seed = 1;
+        for (int pass = 0; pass < passes; pass++) {
+            for (int i = 0; i < size; i++) {
+                seed = seed * 1103515245 + 12345;
+                data[i] = seed >>> 16;
+            }
+            // insertion sort
+            for (int i = 1; i < size; i++) {
+                int v = data[i];
+                int j = i - 1;
+                while (j >= 0 && data[j] > v) {
+                    data[j + 1] = data[j];
+                    j--;
+                }
+                data[j + 1] = v;
+            }
+        }
+        return data[size / 2];
+    }
+
+    static int list(int size, int passes) {
+        Node head = null;
+        for (int i = 0; i < size; i++) {
+            Node node = new Node();
+            node.value = i;
+            node.next = head;
+            head = node;
+        }
+        int sum = 0;
+        for (int pass = 0; pass < passes; pass++) {
+            for (Node node = head; node != null; node = node.next) {
+                node.value += pass;
+                sum ^= node.value;
+            }
+        }
+        return sum;
+    }
+}
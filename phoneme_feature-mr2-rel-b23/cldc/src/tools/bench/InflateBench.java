@@ -0,0 +1,106 @@
+/*
+ *   
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+import java.io.InputStream;
+import java.io.IOException;
+import java.util.Vector;
+
+/**
+ * Inflater benchmark.
+ *
+ * <p>Reads every resource named in the /inflate.lst resource, several
+ * times, and prints the best throughput in KB per second. The resources
+ * are read through the VM's Inflater, so they should come from a
+ * compressed JAR: "make run-inflate" builds one from the class files of
+ * cldc_classes.zip, renamed because .class resources cannot be read, and
+ * adds +PrintLoadingPerformanceCounters to get the inflated_kb_per_sec
+ * counter as well. See GNUmakefile.
+ */
+public class InflateBench {
+    static final int RUNS = 5;
+
+    public static void main(String[] args) throws IOException {
+        String[] names = readList("/inflate.lst");
+        byte[] buffer = new byte[4096];
+        long bytes = 0;
+        long best = Long.MAX_VALUE;
+        for (int run = 0; run < RUNS; run++) {
+            long start = System.currentTimeMillis();
+            bytes = 0;
+            for (int i = 0; i < names.length; i++) {
+                InputStream in =
+                    InflateBench.class.getResourceAsStream(names[i]);
+                if (in == null) {
+                    throw new IOException("Cannot read " + names[i]);
+                }
+                int n;
+                while ((n = in.read(buffer, 0, buffer.length)) > 0) {
+                    bytes += n;
+                }
+                in.close();
+            }
+            long time = System.currentTimeMillis() - start;
+            if (time < best) {
+                best = time;
+            }
+        }
+        if (best == 0) {
+            best = 1;
+        }
+        System.out.println("InflateBench: " + names.length + " entries, " +
+                           bytes / 1024 + " KB, " +
+                           bytes * 1000 / 1024 / best + " KB/s (best of " +
+                           RUNS + " runs: " + best + " ms)");
+    }
+
+    // One resource name per line
+    static String[] readList(String name) throws IOException {
+        InputStream in = InflateBench.class.getResourceAsStream(name);
+        if (in == null) {
+            throw new IOException("Cannot read " + name);
+        }
+        Vector names = new Vector();
+        StringBuffer line = new StringBuffer();
+        int c;
+        while ((c = in.read()) >= 0) {
+            if (c == '\n') {
+                if (line.length() > 0) {
+                    names.addElement(line.toString());
+                }
+                line.setLength(0);
+            } else if (c != '\r') {
+                line.append((char)c);
+            }
+        }
+        in.close();
+        if (line.length() > 0) {
+            names.addElement(line.toString());
+        }
+        String[] result = new String[names.size()];
+        names.copyInto(result);
+        return result;
+    }
+}
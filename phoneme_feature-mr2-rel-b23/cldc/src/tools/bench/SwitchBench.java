@@ -0,0 +1,200 @@
+/*
+ *   
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+/**
+ * Switch-heavy parser benchmark for the lookupswitch bytecode.
+ *
+ * <p>Tokenizes a generated Java-like source text many times. The token
+ * loop switches on each character over 24 sparse keys, and each
+ * identifier is classified with a switch on its hash code over 16
+ * keywords; javac compiles both switches to lookupswitch. The best time
+ * of several runs is printed in tokens per second.
+ *
+ * <p>Run with +PrintPerformanceCounters to also get the average number
+ * of keys compared per lookupswitch ("probes/lookupswitch x100") in the
+ * interpreter; see GNUmakefile.
+ */
+public class SwitchBench {
+    static final int RUNS = 5;
+    static final int PASSES = 40;
+
+    static final String[] WORDS = {
+        "if", "else", "while", "for", "return", "int", "char", "class",
+        "new", "null", "this", "static", "void", "public", "private",
+        "final", "count", "index", "value", "buffer", "length", "next"
+    };
+
+    // Token kinds
+    static final int SPACE = 0, PUNCT = 1, OPERATOR = 2, NUMBER = 3,
+        IDENT = 4, KEYWORD = 5, STRING = 6, OTHER = 7;
+
+    static int[] counts = new int[8];
+
+    public static void main(String[] args) {
+        char[] text = generate(64 * 1024);
+        int tokens = tokenize(text);
+        long best = Long.MAX_VALUE;
+        for (int run = 0; run < RUNS; run++) {
+            long start = System.currentTimeMillis();
+            for (int pass = 0; pass < PASSES; pass++) {
+                tokenize(text);
+            }
+            long time = System.currentTimeMillis() - start;
+            if (time < best) {
+                best = time;
+            }
+        }
+        if (best == 0) {
+            best = 1;
+        }
+        System.out.println("SwitchBench: " + tokens + " tokens, " +
+                           (long)tokens * PASSES * 1000 / best +
+                           " tokens/s (best of " + RUNS + " runs: " +
+                           best + " ms)");
+    }
+
+    // Pseudo-random statements made of the keywords and operators above
+    static char[] generate(int size) {
+        StringBuffer sb = new StringBuffer(size + 64);
+        String ops = "=+-*/<>!&|";
+        int seed = 12345;
+        while (sb.length() < size) {
+            seed = seed * 1103515245 + 12345;
+            int r = (seed >>> 8) & 0xffff;
+            switch (r & 7) {
+            case 0: case 1: case 2:
+                sb.append(WORDS[r % WORDS.length]).append(' ');
+                break;
+            case 3:
+                sb.append(ops.charAt(r % ops.length())).append(' ');
+                break;
+            case 4:
+                sb.append(r % 1000).append(';').append('\n');
+                break;
+            case 5:
+                sb.append("(\"s\", x[").append(r % 10).append("]) ");
+                break;
+            case 6:
+                sb.append("{\n\t");
+                break;
+            default:
+                sb.append("}.");
+                break;
+            }
+        }
+        char[] text = new char[sb.length()];
+        sb.getChars(0, text.length, text, 0);
+        return text;
+    }
+
+    static int tokenize(char[] text) {
+        int tokens = 0;
+        int i = 0;
+        final int n = text.length;
+        while (i < n) {
+            char c = text[i];
+            int kind;
+            switch (c) {
+            case ' ': case '\t': case '\n': case '\r':
+                kind = SPACE;
+                i++;
+                break;
+            case '(': case ')': case '{': case '}': case '[': case ']':
+            case ';': case ',': case '.':
+                kind = PUNCT;
+                i++;
+                break;
+            case '=': case '+': case '-': case '*': case '/': case '<':
+            case '>': case '!': case '&': case '|':
+                kind = OPERATOR;
+                i++;
+                break;
+            case '"':
+                kind = STRING;
+                for (i++; i < n && text[i] != '"'; i++) {
+                }
+                i++;
+                break;
+            default:
+                if (c >= '0' && c <= '9') {
+                    kind = NUMBER;
+                    for (i++; i < n && text[i] >= '0' && text[i] <= '9'; i++) {
+                    }
+                } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+                    int start = i;
+                    int hash = 0;
+                    for (; i < n && ((text[i] >= 'a' && text[i] <= 'z') ||
+                                     (text[i] >= 'A' && text[i] <= 'Z')); i++) {
+                        hash = 31 * hash + text[i];
+                    }
+                    kind = keyword(hash, text, start, i - start) ? KEYWORD
+                                                                 : IDENT;
+                } else {
+                    kind = OTHER;
+                    i++;
+                }
+                break;
+            }
+            counts[kind]++;
+            tokens++;
+        }
+        return tokens;
+    }
+
+    // The case labels are the String.hashCode() values of the keywords
+    static boolean keyword(int hash, char[] text, int start, int length) {
+        String word;
+        switch (hash) {
+        case 3357:       word = "if";      break;
+        case 3116345:    word = "else";    break;
+        case 113101617:  word = "while";   break;
+        case 101577:     word = "for";     break;
+        case -934396624: word = "return";  break;
+        case 104431:     word = "int";     break;
+        case 3052374:    word = "char";    break;
+        case 94742904:   word = "class";   break;
+        case 108960:     word = "new";     break;
+        case 3392903:    word = "null";    break;
+        case 3559070:    word = "this";    break;
+        case -892481938: word = "static";  break;
+        case 3625364:    word = "void";    break;
+        case -977423767: word = "public";  break;
+        case -314497661: word = "private"; break;
+        case 97436022:   word = "final";   break;
+        default:
+            return false;
+        }
+        if (word.length() != length) {
+            return false;
+        }
+        for (int k = 0; k < length; k++) {
+            if (word.charAt(k) != text[start + k]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
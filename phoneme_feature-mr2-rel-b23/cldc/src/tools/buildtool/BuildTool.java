@@ -49,6 +49,8 @@ public class BuildTool {
         p("romtestclasses ...:                  Create romtestclasses.zip");
         p("testcases ...:                       Create testcases.make");
         p("testjarentries ...:                  Create test JAR entries");
+        p("superinstructions <histogramfile> <outputfile> [<cutoff>]:");
+        p("                                     Create superinstructions.h");
         System.exit(1);
     }
 
@@ -75,6 +77,9 @@ public class BuildTool {
             else if ("mjpp".equals(app)) {
                 mjpp.Main.main(appArgs);
             }
+            else if ("superinstructions".equals(app)) {
+                superinst.Main.main(appArgs);
+            }
             else if ("help".equals(app)) {
                 usage();
             }
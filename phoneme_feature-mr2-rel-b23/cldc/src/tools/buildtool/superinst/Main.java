@@ -0,0 +1,145 @@
+/*
+ *   
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+package superinst;
+
+import java.io.*;
+import java.util.*;
+import java.util.regex.*;
+
+/**
+ * Creates superinstructions.h, the selection of superinstructions used by
+ * the threaded loop of the C interpreter, from the output of a VM run
+ * with +PrintPairHistogram. See src/vm/cpu/c/Superinstructions_c.hpp.
+ *
+ * A superinstruction is enabled if the bytecode pairs it covers account
+ * for at least <cutoff> percent of all executed pairs. Pairs below
+ * PairHistogramCutOff are not printed by the VM, so the profile should be
+ * taken with a low PairHistogramCutOff (e.g. =PairHistogramCutOff0).
+ */
+public class Main {
+    static void usage() {
+        System.out.println("Usage: java -jar buildtool.jar " +
+                           "superinstructions <histogramfile> <outputfile> " +
+                           "[<cutoff>]");
+    }
+
+    static final String ILOADS[] = {
+        "iload", "iload_0", "iload_1", "iload_2", "iload_3"
+    };
+
+    /**
+     * The superinstructions implemented by the C interpreter. Each entry
+     * is {name, first bytecodes, second bytecodes, required entry}.
+     * This table must be kept in sync with Superinstructions_c.hpp.
+     */
+    static final Object MENU[][] = {
+        {"ALOAD_0_GETFIELD",  new String[] {"aload_0"},
+                              new String[] {"fast_igetfield",
+                                            "fast_agetfield"}, null},
+        {"ILOAD_ILOAD",       ILOADS, ILOADS, null},
+        {"ILOAD_ILOAD_IADD",  ILOADS, new String[] {"iadd"}, "ILOAD_ILOAD"},
+        {"IGETFIELD_IRETURN", new String[] {"fast_igetfield"},
+                              new String[] {"ireturn"}, null},
+        {"IINC_GOTO",         new String[] {"iinc"},
+                              new String[] {"goto"}, null},
+    };
+
+    // Matches a line printed by PairHistogram::print(), e.g.
+    //     1234567    5.27%    (0x2a,0xd5)    (aload_0,fast_igetfield)
+    static final Pattern LINE = Pattern.compile(
+        "^\\s*\\d+\\s+([0-9.]+)%\\s+\\(0x[0-9a-fA-F]+,0x[0-9a-fA-F]+\\)" +
+        "\\s+\\((\\w+),(\\w+)\\)");
+
+    public static void main(String args[]) throws Throwable {
+        if (args.length < 2) {
+            usage();
+            System.exit(1);
+        }
+        double cutoff = 1.0;
+        if (args.length > 2) {
+            cutoff = Double.parseDouble(args[2]);
+        }
+
+        Hashtable pairs = readHistogram(args[0]);
+        Hashtable enabled = new Hashtable();
+
+        PrintWriter out = new PrintWriter(new FileWriter(args[1]));
+        out.println("// auto-generated by buildtool.jar superinstructions " +
+                    "from");
+        out.println("// " + args[0] + ", cutoff = " + cutoff + "%.");
+        out.println("// Do not edit.");
+        out.println();
+
+        for (int i=0; i<MENU.length; i++) {
+            String name     = (String)  MENU[i][0];
+            String first[]  = (String[])MENU[i][1];
+            String second[] = (String[])MENU[i][2];
+            String requires = (String)  MENU[i][3];
+
+            double frequency = 0.0;
+            for (int f=0; f<first.length; f++) {
+                for (int s=0; s<second.length; s++) {
+                    Double d = (Double)pairs.get(first[f] + "," + second[s]);
+                    if (d != null) {
+                        frequency += d.doubleValue();
+                    }
+                }
+            }
+            boolean on = (frequency >= cutoff) &&
+                         (requires == null || enabled.get(requires) != null);
+            if (on) {
+                enabled.put(name, name);
+            }
+            String macro = "#define SUPERINSTRUCTION_" + name;
+            while (macro.length() < 48) {
+                macro += " ";
+            }
+            out.println(macro + (on ? "1" : "0") + "  // " +
+                        round(frequency) + "%");
+        }
+        out.close();
+    }
+
+    static Hashtable readHistogram(String file) throws IOException {
+        Hashtable pairs = new Hashtable();
+        BufferedReader in = new BufferedReader(new FileReader(file));
+        String line;
+        while ((line = in.readLine()) != null) {
+            Matcher m = LINE.matcher(line);
+            if (m.find()) {
+                String key = m.group(2) + "," + m.group(3);
+                pairs.put(key, new Double(m.group(1)));
+            }
+        }
+        in.close();
+        return pairs;
+    }
+
+    static String round(double d) {
+        return Double.toString(Math.round(d * 100.0) / 100.0);
+    }
+}
@@ -3934,21 +3934,8 @@ void CodeGenerator::lookup_switch(Value& index, jint table_index,
     return;
   }
 
-  // (3) compile it the slow way
-  CompilerLiteralAccessor cla;
-  for (i = 0, offset = table_index + 8; i < num_of_pairs; i++, offset += 8) {
-    int key = method()->get_java_switch_int(offset);
-    int jump_offset = method()->get_java_switch_int(offset + 4);
-    cmp_imm(index.lo_register(), key, &cla);
-    conditional_jump(BytecodeClosure::eq, bci() + jump_offset, false JVM_CHECK);
-  }
-  branch(default_dest JVM_NO_CHECK_AT_BOTTOM);
-}
-
-#if NOT_CURRENTLY_USED
-
-void CodeGenerator::lookup_switch(Value& index, jint table_index,
-                                  jint default_dest, jint num_of_pairs JVM_TRAPS) {
+  // (3) compile it the slow way. The keys are sorted, so search them
+  // with a balanced tree of compares rather than a linear chain.
   lookup_switch(index.lo_register(), table_index, 0, num_of_pairs - 1,
                 default_dest JVM_CHECK);
   branch(default_dest JVM_NO_CHECK_AT_BOTTOM);
@@ -4010,8 +3997,6 @@ void CodeGenerator::lookup_switch(Register index, jint table_index,
   }
 }
 
-#endif
-
 void CodeGenerator::invoke(const Method* method, 
                            bool must_do_null_check JVM_TRAPS) {
   bool is_native = method->is_native();
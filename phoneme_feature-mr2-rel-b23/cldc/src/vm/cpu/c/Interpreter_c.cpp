@@ -67,6 +67,9 @@ extern "C" {
 
   // global defines
 #define WIDE_OFFSET       255
+  // lookupswitch tables up to this many pairs are scanned linearly;
+  // larger ones are indexed directly (if dense) or binary-searched.
+#define LOOKUPSWITCH_LINEAR_LIMIT 8
 
   // types
   typedef void       (*func_t)();
@@ -106,8 +109,14 @@ extern "C" {
   /* bytecodes dispatch table */
   static func_t interpreter_dispatch_table[256+WIDE_OFFSET];
 
+#if USE_DEBUG_PRINTING
+  // has_Interpreter, has_FloatingPoint, has_TraceBytecodes,
+  // has_PrintBytecodeHistogram, has_PrintPairHistogram
+  jint assembler_loop_type = 0x1 + 0x40 + 0x4 + 0x10 + 0x20;
+#else
   // has_Interpreter, has_FloatingPoint, has_TraceBytecodes
   jint assembler_loop_type = 0x1 + 0x40 + 0x4;
+#endif
 
 #if !defined(PRODUCT) || USE_DEBUG_PRINTING
   jlong interpreter_pair_counters[Bytecodes::number_of_java_codes *
@@ -3471,12 +3480,49 @@ enum {
     // get default target
     jint    target = int_from_addr(aligned_jpc);
     jint    npairs = int_from_addr(aligned_jpc + 4);
-
-    while (npairs-- > 0) {
-      aligned_jpc += 8;
-      if (int_from_addr(aligned_jpc) == key) {
-        target = int_from_addr(aligned_jpc + 4);
-        break;
+    // The verifier guarantees that the match keys are sorted in
+    // increasing order, so we can stop early on short tables, index
+    // directly into dense ones, and binary-search the rest.
+    address pairs  = aligned_jpc + 8;
+
+    PERFORMANCE_COUNTER_INCREMENT(num_of_lookupswitch, 1);
+    if (npairs <= LOOKUPSWITCH_LINEAR_LIMIT) {
+      for (; npairs > 0; npairs--, pairs += 8) {
+        PERFORMANCE_COUNTER_INCREMENT(num_of_lookupswitch_probes, 1);
+        const jint match = int_from_addr(pairs);
+        if (match >= key) {
+          if (match == key) {
+            target = int_from_addr(pairs + 4);
+          }
+          break;
+        }
+      }
+    } else {
+      const jint first = int_from_addr(pairs);
+      const jint last  = int_from_addr(pairs + 8 * (npairs - 1));
+      if ((juint)last - (juint)first == (juint)(npairs - 1)) {
+        // Dense keys: the table is a tableswitch in disguise.
+        PERFORMANCE_COUNTER_INCREMENT(num_of_lookupswitch_probes, 1);
+        const juint index = (juint)key - (juint)first;
+        if (index < (juint)npairs) {
+          target = int_from_addr(pairs + 8 * index + 4);
+        }
+      } else {
+        jint low  = 0;
+        jint high = npairs - 1;
+        while (low <= high) {
+          PERFORMANCE_COUNTER_INCREMENT(num_of_lookupswitch_probes, 1);
+          const jint mid = (juint)(low + high) >> 1;
+          const jint match = int_from_addr(pairs + 8 * mid);
+          if (match < key) {
+            low = mid + 1;
+          } else if (match > key) {
+            high = mid - 1;
+          } else {
+            target = int_from_addr(pairs + 8 * mid + 4);
+            break;
+          }
+        }
       }
     }
     // branch to target offset
@@ -3870,6 +3916,35 @@ enum {
     fast_invoke_internal(true, false, 3);
   BYTECODE_IMPL_END
 
+  // Inline caches of fast_invokeinterface.
+  //
+  // A call site (the address of its bytecode) hashes to one entry that
+  // remembers the methods found for the last two receiver classes seen
+  // there, most recent first. The entries hold raw ClassInfo and Method
+  // pointers, so the whole cache is flushed whenever objects move and
+  // when a class is loaded.
+#define INTERFACE_CALL_CACHE_SIZE 128 // must be a power of 2
+#define INTERFACE_CALL_CACHE_WAYS 2
+
+  struct InterfaceCallCacheEntry {
+    address site;
+    address class_info[INTERFACE_CALL_CACHE_WAYS];
+    address method[INTERFACE_CALL_CACHE_WAYS];
+  };
+
+  static InterfaceCallCacheEntry
+      interface_call_cache[INTERFACE_CALL_CACHE_SIZE];
+
+  void interpreter_flush_interface_call_cache() {
+    jvm_memset(interface_call_cache, 0, sizeof(interface_call_cache));
+  }
+
+  static inline InterfaceCallCacheEntry* interface_call_cache_entry(
+                                                               address site) {
+    const juint hash = (juint)site ^ ((juint)site >> 7);
+    return interface_call_cache + (hash & (INTERFACE_CALL_CACHE_SIZE - 1));
+  }
+
   BYTECODE_IMPL(fast_invokeinterface)
     // read arguments
     jushort index = GET_SHORT(0);
@@ -3893,6 +3968,26 @@ enum {
     // Get the itable from the class of the receiver object
     // Get the ClassInfo
     address ci = *(address*)(receiver + JavaClass::class_info_offset());
+
+    InterfaceCallCacheEntry* entry = interface_call_cache_entry(g_jpc);
+    if (UseInterfaceCallCache) {
+      if (entry->site == g_jpc) {
+        if (entry->class_info[0] == ci) {
+          PERFORMANCE_COUNTER_INCREMENT(num_of_interface_cache_hits, 1);
+          invoke_java_method(entry->method[0], 5);
+          return;
+        }
+        if (entry->class_info[1] == ci) {
+          PERFORMANCE_COUNTER_INCREMENT(num_of_interface_cache_hits, 1);
+          PERFORMANCE_COUNTER_INCREMENT(
+              num_of_interface_cache_polymorphic_hits, 1);
+          invoke_java_method(entry->method[1], 5);
+          return;
+        }
+      }
+      PERFORMANCE_COUNTER_INCREMENT(num_of_interface_cache_misses, 1);
+    }
+
     // get length of vtable and itable
     jushort vlength = *(jushort*)(ci + ClassInfo::vtable_length_offset());
     jint ilength = *(jushort*)(ci + ClassInfo::itable_length_offset());
@@ -3918,6 +4013,20 @@ enum {
     // method table of the receiver class
     address table = int_from_addr(itable + 4) + ci;
     address method = *(address*)(table + method_index * 4);
+
+    if (UseInterfaceCallCache) {
+      if (entry->site == g_jpc) {
+        // Keep the previous receiver class as the second choice
+        entry->class_info[1] = entry->class_info[0];
+        entry->method[1]     = entry->method[0];
+      } else {
+        entry->site          = g_jpc;
+        entry->class_info[1] = NULL;
+        entry->method[1]     = NULL;
+      }
+      entry->class_info[0] = ci;
+      entry->method[0]     = method;
+    }
     invoke_java_method(method, 5);
   BYTECODE_IMPL_END
 
@@ -4472,12 +4581,571 @@ static void init() {
 }
 #undef MY_GUARANTEE
 
+#if USE_C_INTERPRETER_THREADED_DISPATCH
+// Threaded interpreter loop.
+//
+// The most frequent bytecodes are implemented inline and dispatched with
+// computed gotos (GCC labels-as-values), while jpc, sp and locals are kept
+// in local variables, i.e. in registers. Everything else falls back to the
+// regular bc_impl_* handlers through interpreter_dispatch_table: before
+// calling a handler the cached values are written back to g_jpc/g_jsp/
+// g_jlocals, and they are re-read when it returns, since the handler may
+// have called the VM, invoked a method or switched threads.
+//
+// An inline handler never throws: if a null or bounds check fails it
+// leaves the expression stack untouched and goes to the fallback, which
+// re-executes the bytecode with the regular handler and raises the
+// exception there.
+//
+// Some handlers also recognize the superinstructions selected in
+// Superinstructions_c.hpp: they look at the bytecode(s) that follow and
+// execute a whole hot sequence with a single dispatch. Every bytecode a
+// sequence covers beyond the first is still counted with TD_COUNT().
+
+#define TD_SYNC_OUT()        g_jpc = jpc; g_jsp = jsp; g_jlocals = jlocals; \
+                             TD_FLUSH_COUNTER()
+#define TD_SYNC_IN()         jpc = g_jpc; jsp = g_jsp; jlocals = g_jlocals
+
+#if ENABLE_PERFORMANCE_COUNTERS && ENABLE_DETAILED_PERFORMANCE_COUNTERS
+#define TD_COUNT()           bytecode_count++
+#define TD_FLUSH_COUNTER()   jvm_perf_count.num_of_interpreted_bytecodes += \
+                               bytecode_count; bytecode_count = 0
+#else
+#define TD_COUNT()
+#define TD_FLUSH_COUNTER()
+#endif
+
+#define TD_DISPATCH()        TD_COUNT(); goto *labels[*jpc]
+#define TD_NEXT(n)           jpc += (n); TD_DISPATCH()
+
+#define TD_BYTE(x)           (*(jubyte*)(jpc + (x) + 1))
+#define TD_SIGNED_BYTE(x)    (*(jbyte*)(jpc + (x) + 1))
+#define TD_SIGNED_SHORT(x) \
+        (jshort)(((jint)(TD_BYTE(x)) << 8) | (jint)TD_BYTE(x+1))
+#if HARDWARE_LITTLE_ENDIAN && ENABLE_NATIVE_ORDER_REWRITING
+#define TD_SHORT_NATIVE(x) \
+        (((jint)(TD_BYTE(x+1)) << 8) | (jint)(TD_BYTE(x)))
+#else
+#define TD_SHORT_NATIVE(x) \
+        ((((TD_BYTE(x))) << 8) | TD_BYTE(x+1))
+#endif
+
+#define TD_LOCAL(n)          (*((jint*)jlocals - (n)))
+#define TD_TOS(n)            (*((jint*)jsp + (n)))
+#define TD_OBJ_TOS(n)        (*((address*)jsp + (n)))
+#define TD_PUSH(v)           jsp -= sizeof(jint); *(jint*)jsp = (v)
+#define TD_DROP(n)           jsp += (n) * sizeof(jint)
+
+#if ENABLE_PAGE_PROTECTION
+#define TD_CHECK_TIMER_TICK() \
+        TD_SYNC_OUT(); check_timer_tick(); TD_SYNC_IN()
+#else
+#define TD_CHECK_TIMER_TICK()                      \
+        if (_rt_timer_ticks > 0) {                 \
+          TD_SYNC_OUT();                           \
+          check_timer_tick();                      \
+          TD_SYNC_IN();                            \
+        }
+#endif
+
+// Pops as many words as the comparison consumed, then branches.
+#define TD_BRANCH(npop, cond)                      \
+        {                                          \
+          const bool taken = (cond);               \
+          TD_DROP(npop);                           \
+          if (taken) {                             \
+            jpc += TD_SIGNED_SHORT(0);             \
+            TD_CHECK_TIMER_TICK();                 \
+            TD_DISPATCH();                         \
+          }                                        \
+          TD_NEXT(3);                              \
+        }
+
+#if SUPERINSTRUCTION_ILOAD_ILOAD
+#define TD_IS_ILOAD(code)                          \
+        ((code) == Bytecodes::_iload ||            \
+         (juint)((code) - Bytecodes::_iload_0) <= 3)
+// Continues with the next int load, if any, without a dispatch
+#define TD_NEXT_ILOAD(n)                           \
+        jpc += (n);                                \
+        if (TD_IS_ILOAD(*jpc)) {                   \
+          TD_COUNT();                              \
+          goto td_super_iload_iload;               \
+        }                                          \
+        TD_DISPATCH()
+#else
+#define TD_NEXT_ILOAD(n)     TD_NEXT(n)
+#endif
+
+#define TD_BINARY_OP(op)                           \
+        TD_TOS(1) = TD_TOS(1) op TD_TOS(0);        \
+        TD_DROP(1);                                \
+        TD_NEXT(1)
+
+#define TD_DEF(name)         labels[Bytecodes::_##name] = &&td_##name
+#define TD_IMPL(name)        td_##name:
+
+static void interpret_threaded() {
+  static void* labels[256];
+  static bool labels_initialized = false;
+
+  address jpc;
+  address jsp;
+  address jlocals;
+#if ENABLE_PERFORMANCE_COUNTERS && ENABLE_DETAILED_PERFORMANCE_COUNTERS
+  jlong bytecode_count = 0;
+#endif
+
+  if (!labels_initialized) {
+    for (int i = 0; i < 256; i++) {
+      labels[i] = &&td_fallback;
+    }
+    TD_DEF(nop);
+    TD_DEF(aconst_null);
+    TD_DEF(iconst_m1);
+    TD_DEF(iconst_0);
+    TD_DEF(iconst_1);
+    TD_DEF(iconst_2);
+    TD_DEF(iconst_3);
+    TD_DEF(iconst_4);
+    TD_DEF(iconst_5);
+    TD_DEF(bipush);
+    TD_DEF(sipush);
+    TD_DEF(iload);
+    TD_DEF(fload);
+    TD_DEF(aload);
+    TD_DEF(iload_0);
+    TD_DEF(iload_1);
+    TD_DEF(iload_2);
+    TD_DEF(iload_3);
+    TD_DEF(fload_0);
+    TD_DEF(fload_1);
+    TD_DEF(fload_2);
+    TD_DEF(fload_3);
+    TD_DEF(aload_0);
+    TD_DEF(aload_1);
+    TD_DEF(aload_2);
+    TD_DEF(aload_3);
+    TD_DEF(istore);
+    TD_DEF(fstore);
+    TD_DEF(astore);
+    TD_DEF(istore_0);
+    TD_DEF(istore_1);
+    TD_DEF(istore_2);
+    TD_DEF(istore_3);
+    TD_DEF(fstore_0);
+    TD_DEF(fstore_1);
+    TD_DEF(fstore_2);
+    TD_DEF(fstore_3);
+    TD_DEF(astore_0);
+    TD_DEF(astore_1);
+    TD_DEF(astore_2);
+    TD_DEF(astore_3);
+    TD_DEF(iaload);
+    TD_DEF(aaload);
+    TD_DEF(baload);
+    TD_DEF(caload);
+    TD_DEF(saload);
+    TD_DEF(iastore);
+    TD_DEF(bastore);
+    TD_DEF(castore);
+    TD_DEF(sastore);
+    TD_DEF(pop);
+    TD_DEF(pop2);
+    TD_DEF(dup);
+    TD_DEF(swap);
+    TD_DEF(iadd);
+    TD_DEF(isub);
+    TD_DEF(imul);
+    TD_DEF(ineg);
+    TD_DEF(ishl);
+    TD_DEF(ishr);
+    TD_DEF(iushr);
+    TD_DEF(iand);
+    TD_DEF(ior);
+    TD_DEF(ixor);
+    TD_DEF(iinc);
+    TD_DEF(i2b);
+    TD_DEF(i2c);
+    TD_DEF(i2s);
+    TD_DEF(ifeq);
+    TD_DEF(ifne);
+    TD_DEF(iflt);
+    TD_DEF(ifge);
+    TD_DEF(ifgt);
+    TD_DEF(ifle);
+    TD_DEF(if_icmpeq);
+    TD_DEF(if_icmpne);
+    TD_DEF(if_icmplt);
+    TD_DEF(if_icmpge);
+    TD_DEF(if_icmpgt);
+    TD_DEF(if_icmple);
+    TD_DEF(if_acmpeq);
+    TD_DEF(if_acmpne);
+    TD_DEF(ifnull);
+    TD_DEF(ifnonnull);
+    TD_DEF(goto);
+    TD_DEF(arraylength);
+    TD_DEF(fast_bgetfield);
+    TD_DEF(fast_sgetfield);
+    TD_DEF(fast_cgetfield);
+    TD_DEF(fast_igetfield);
+    TD_DEF(fast_fgetfield);
+    TD_DEF(fast_agetfield);
+    TD_DEF(fast_igetfield_1);
+    TD_DEF(fast_agetfield_1);
+    TD_DEF(fast_iputfield);
+    TD_DEF(fast_fputfield);
+#if !ENABLE_CPU_VARIANT
+    TD_DEF(aload_0_fast_igetfield_1);
+    TD_DEF(aload_0_fast_agetfield_1);
+    TD_DEF(aload_0_fast_igetfield_4);
+    TD_DEF(aload_0_fast_igetfield_8);
+    TD_DEF(aload_0_fast_agetfield_4);
+    TD_DEF(aload_0_fast_agetfield_8);
+#endif
+    labels_initialized = true;
+  }
+
+  TD_SYNC_IN();
+  TD_DISPATCH();
+
+TD_IMPL(fallback)
+  // Not handled inline (or about to throw): use the regular handler
+  TD_SYNC_OUT();
+  interpreter_dispatch_table[*jpc]();
+  TD_SYNC_IN();
+  TD_DISPATCH();
+
+TD_IMPL(nop)          TD_NEXT(1);
+TD_IMPL(aconst_null)  TD_PUSH(0);  TD_NEXT(1);
+TD_IMPL(iconst_m1)    TD_PUSH(-1); TD_NEXT(1);
+TD_IMPL(iconst_0)     TD_PUSH(0);  TD_NEXT(1);
+TD_IMPL(iconst_1)     TD_PUSH(1);  TD_NEXT(1);
+TD_IMPL(iconst_2)     TD_PUSH(2);  TD_NEXT(1);
+TD_IMPL(iconst_3)     TD_PUSH(3);  TD_NEXT(1);
+TD_IMPL(iconst_4)     TD_PUSH(4);  TD_NEXT(1);
+TD_IMPL(iconst_5)     TD_PUSH(5);  TD_NEXT(1);
+TD_IMPL(bipush)       TD_PUSH(TD_SIGNED_BYTE(0));  TD_NEXT(2);
+TD_IMPL(sipush)       TD_PUSH(TD_SIGNED_SHORT(0)); TD_NEXT(3);
+
+TD_IMPL(iload)        TD_PUSH(TD_LOCAL(TD_BYTE(0))); TD_NEXT_ILOAD(2);
+TD_IMPL(iload_0)      TD_PUSH(TD_LOCAL(0)); TD_NEXT_ILOAD(1);
+TD_IMPL(iload_1)      TD_PUSH(TD_LOCAL(1)); TD_NEXT_ILOAD(1);
+TD_IMPL(iload_2)      TD_PUSH(TD_LOCAL(2)); TD_NEXT_ILOAD(1);
+TD_IMPL(iload_3)      TD_PUSH(TD_LOCAL(3)); TD_NEXT_ILOAD(1);
+
+#if SUPERINSTRUCTION_ILOAD_ILOAD
+TD_IMPL(super_iload_iload)
+  // jpc is at the second int load of the sequence
+  {
+    jint value;
+    if (*jpc == Bytecodes::_iload) {
+      value = TD_LOCAL(TD_BYTE(0));
+      jpc += 2;
+    } else {
+      value = TD_LOCAL(*jpc - Bytecodes::_iload_0);
+      jpc += 1;
+    }
+#if SUPERINSTRUCTION_ILOAD_ILOAD_IADD
+    if (*jpc == Bytecodes::_iadd) {
+      TD_COUNT();
+      TD_TOS(0) += value;
+      TD_NEXT(1);
+    }
+#endif
+    TD_PUSH(value);
+    TD_DISPATCH();
+  }
+#endif
+
+TD_IMPL(aload_0)
+#if SUPERINSTRUCTION_ALOAD_0_GETFIELD
+  {
+    const address obj = *(address*)&TD_LOCAL(0);
+    if (obj != NULL && (jpc[1] == Bytecodes::_fast_igetfield ||
+                        jpc[1] == Bytecodes::_fast_agetfield)) {
+      jpc += 1;
+      TD_COUNT();
+      TD_PUSH(*(jint*)(obj + TD_SHORT_NATIVE(0) * 4));
+      TD_NEXT(3);
+    }
+  }
+#endif
+  TD_PUSH(TD_LOCAL(0));
+  TD_NEXT(1);
+
+TD_IMPL(fload)
+TD_IMPL(aload)        TD_PUSH(TD_LOCAL(TD_BYTE(0))); TD_NEXT(2);
+TD_IMPL(fload_0)      TD_PUSH(TD_LOCAL(0)); TD_NEXT(1);
+TD_IMPL(fload_1)
+TD_IMPL(aload_1)      TD_PUSH(TD_LOCAL(1)); TD_NEXT(1);
+TD_IMPL(fload_2)
+TD_IMPL(aload_2)      TD_PUSH(TD_LOCAL(2)); TD_NEXT(1);
+TD_IMPL(fload_3)
+TD_IMPL(aload_3)      TD_PUSH(TD_LOCAL(3)); TD_NEXT(1);
+
+TD_IMPL(istore)
+TD_IMPL(fstore)
+TD_IMPL(astore)       TD_LOCAL(TD_BYTE(0)) = TD_TOS(0); TD_DROP(1); TD_NEXT(2);
+TD_IMPL(istore_0)
+TD_IMPL(fstore_0)
+TD_IMPL(astore_0)     TD_LOCAL(0) = TD_TOS(0); TD_DROP(1); TD_NEXT(1);
+TD_IMPL(istore_1)
+TD_IMPL(fstore_1)
+TD_IMPL(astore_1)     TD_LOCAL(1) = TD_TOS(0); TD_DROP(1); TD_NEXT(1);
+TD_IMPL(istore_2)
+TD_IMPL(fstore_2)
+TD_IMPL(astore_2)     TD_LOCAL(2) = TD_TOS(0); TD_DROP(1); TD_NEXT(1);
+TD_IMPL(istore_3)
+TD_IMPL(fstore_3)
+TD_IMPL(astore_3)     TD_LOCAL(3) = TD_TOS(0); TD_DROP(1); TD_NEXT(1);
+
+#define TD_ARRAY_LOAD(type)                                            \
+  {                                                                    \
+    const jint idx = TD_TOS(0);                                        \
+    const address ref = TD_OBJ_TOS(1);                                 \
+    if (ref == NULL || (juint)idx >= (juint)GET_ARRAY_LENGTH(ref)) {   \
+      goto td_fallback;                                                \
+    }                                                                  \
+    TD_DROP(1);                                                        \
+    TD_TOS(0) = GET_ARRAY_ELEMENT(ref, idx, type);                     \
+    TD_NEXT(1);                                                        \
+  }
+
+TD_IMPL(iaload)       TD_ARRAY_LOAD(jint);
+TD_IMPL(aaload)       TD_ARRAY_LOAD(jint);
+TD_IMPL(baload)       TD_ARRAY_LOAD(jbyte);
+TD_IMPL(caload)       TD_ARRAY_LOAD(jchar);
+TD_IMPL(saload)       TD_ARRAY_LOAD(jshort);
+
+#define TD_ARRAY_STORE(type)                                           \
+  {                                                                    \
+    const jint idx = TD_TOS(1);                                        \
+    const address ref = TD_OBJ_TOS(2);                                 \
+    if (ref == NULL || (juint)idx >= (juint)GET_ARRAY_LENGTH(ref)) {   \
+      goto td_fallback;                                                \
+    }                                                                  \
+    SET_ARRAY_ELEMENT(ref, idx, type, (type)TD_TOS(0));                \
+    TD_DROP(3);                                                        \
+    TD_NEXT(1);                                                        \
+  }
+
+TD_IMPL(iastore)      TD_ARRAY_STORE(jint);
+TD_IMPL(bastore)      TD_ARRAY_STORE(jbyte);
+TD_IMPL(castore)      TD_ARRAY_STORE(jushort);
+TD_IMPL(sastore)      TD_ARRAY_STORE(jshort);
+
+TD_IMPL(pop)          TD_DROP(1); TD_NEXT(1);
+TD_IMPL(pop2)         TD_DROP(2); TD_NEXT(1);
+TD_IMPL(dup)
+  {
+    const jint v = TD_TOS(0);
+    TD_PUSH(v);
+    TD_NEXT(1);
+  }
+TD_IMPL(swap)
+  {
+    const jint v = TD_TOS(0);
+    TD_TOS(0) = TD_TOS(1);
+    TD_TOS(1) = v;
+    TD_NEXT(1);
+  }
+
+TD_IMPL(iadd)         TD_BINARY_OP(+);
+TD_IMPL(isub)         TD_BINARY_OP(-);
+TD_IMPL(imul)         TD_BINARY_OP(*);
+TD_IMPL(iand)         TD_BINARY_OP(&);
+TD_IMPL(ior)          TD_BINARY_OP(|);
+TD_IMPL(ixor)         TD_BINARY_OP(^);
+TD_IMPL(ineg)         TD_TOS(0) = -TD_TOS(0); TD_NEXT(1);
+TD_IMPL(ishl)
+  TD_TOS(1) = TD_TOS(1) << (TD_TOS(0) & 0x1f);
+  TD_DROP(1);
+  TD_NEXT(1);
+TD_IMPL(ishr)
+  TD_TOS(1) = TD_TOS(1) >> (TD_TOS(0) & 0x1f);
+  TD_DROP(1);
+  TD_NEXT(1);
+TD_IMPL(iushr)
+  TD_TOS(1) = (jint)((juint)TD_TOS(1) >> (TD_TOS(0) & 0x1f));
+  TD_DROP(1);
+  TD_NEXT(1);
+TD_IMPL(iinc)
+  TD_LOCAL(TD_BYTE(0)) += TD_SIGNED_BYTE(1);
+#if SUPERINSTRUCTION_IINC_GOTO
+  if (jpc[3] == Bytecodes::_goto) {
+    jpc += 3;
+    TD_COUNT();
+    goto td_goto;
+  }
+#endif
+  TD_NEXT(3);
+TD_IMPL(i2b)          TD_TOS(0) = (jbyte)TD_TOS(0);  TD_NEXT(1);
+TD_IMPL(i2c)          TD_TOS(0) = (jchar)TD_TOS(0);  TD_NEXT(1);
+TD_IMPL(i2s)          TD_TOS(0) = (jshort)TD_TOS(0); TD_NEXT(1);
+
+TD_IMPL(ifeq)         TD_BRANCH(1, TD_TOS(0) == 0);
+TD_IMPL(ifne)         TD_BRANCH(1, TD_TOS(0) != 0);
+TD_IMPL(iflt)         TD_BRANCH(1, TD_TOS(0) <  0);
+TD_IMPL(ifge)         TD_BRANCH(1, TD_TOS(0) >= 0);
+TD_IMPL(ifgt)         TD_BRANCH(1, TD_TOS(0) >  0);
+TD_IMPL(ifle)         TD_BRANCH(1, TD_TOS(0) <= 0);
+TD_IMPL(ifnull)       TD_BRANCH(1, TD_TOS(0) == 0);
+TD_IMPL(ifnonnull)    TD_BRANCH(1, TD_TOS(0) != 0);
+TD_IMPL(if_icmpeq)
+TD_IMPL(if_acmpeq)    TD_BRANCH(2, TD_TOS(1) == TD_TOS(0));
+TD_IMPL(if_icmpne)
+TD_IMPL(if_acmpne)    TD_BRANCH(2, TD_TOS(1) != TD_TOS(0));
+TD_IMPL(if_icmplt)    TD_BRANCH(2, TD_TOS(1) <  TD_TOS(0));
+TD_IMPL(if_icmpge)    TD_BRANCH(2, TD_TOS(1) >= TD_TOS(0));
+TD_IMPL(if_icmpgt)    TD_BRANCH(2, TD_TOS(1) >  TD_TOS(0));
+TD_IMPL(if_icmple)    TD_BRANCH(2, TD_TOS(1) <= TD_TOS(0));
+TD_IMPL(goto)         TD_BRANCH(0, true);
+
+TD_IMPL(arraylength)
+  {
+    const address ref = TD_OBJ_TOS(0);
+    if (ref == NULL) {
+      goto td_fallback;
+    }
+    TD_TOS(0) = GET_ARRAY_LENGTH(ref);
+    TD_NEXT(1);
+  }
+
+// Replaces the receiver on top of stack with the value of the field
+#define TD_GETFIELD(type, offset, length)                              \
+  {                                                                    \
+    const address obj = TD_OBJ_TOS(0);                                 \
+    if (obj == NULL) {                                                 \
+      goto td_fallback;                                                \
+    }                                                                  \
+    TD_TOS(0) = (jint)*(type*)(obj + (offset));                        \
+    TD_NEXT(length);                                                   \
+  }
+
+// Pushes the value of a field of local 0
+#define TD_ALOAD_0_GETFIELD(offset, length)                            \
+  {                                                                    \
+    const address obj = *(address*)&TD_LOCAL(0);                      \
+    if (obj == NULL) {                                                 \
+      goto td_fallback;                                                \
+    }                                                                  \
+    TD_PUSH(*(jint*)(obj + (offset)));                                 \
+    TD_NEXT(length);                                                   \
+  }
+
+TD_IMPL(fast_bgetfield)  TD_GETFIELD(jbyte,   TD_SHORT_NATIVE(0),     3);
+TD_IMPL(fast_sgetfield)  TD_GETFIELD(jshort,  TD_SHORT_NATIVE(0),     3);
+TD_IMPL(fast_cgetfield)  TD_GETFIELD(jushort, TD_SHORT_NATIVE(0),     3);
+TD_IMPL(fast_igetfield)
+#if SUPERINSTRUCTION_IGETFIELD_IRETURN
+  if (jpc[3] == Bytecodes::_ireturn) {
+    const address obj = TD_OBJ_TOS(0);
+    if (obj != NULL) {
+      TD_TOS(0) = *(jint*)(obj + TD_SHORT_NATIVE(0) * 4);
+      jpc += 3;
+      TD_COUNT();
+      TD_SYNC_OUT();
+      bc_impl_ireturn();
+      TD_SYNC_IN();
+      TD_DISPATCH();
+    }
+  }
+#endif
+  // Fall through
+TD_IMPL(fast_fgetfield)
+TD_IMPL(fast_agetfield)  TD_GETFIELD(jint,    TD_SHORT_NATIVE(0) * 4, 3);
+TD_IMPL(fast_igetfield_1)
+TD_IMPL(fast_agetfield_1) TD_GETFIELD(jint,   TD_BYTE(0) * 4,         2);
+
+#if !ENABLE_CPU_VARIANT
+TD_IMPL(aload_0_fast_igetfield_1)
+TD_IMPL(aload_0_fast_agetfield_1) TD_ALOAD_0_GETFIELD(TD_BYTE(0) * 4, 2);
+TD_IMPL(aload_0_fast_igetfield_4)
+TD_IMPL(aload_0_fast_agetfield_4) TD_ALOAD_0_GETFIELD(4, 1);
+TD_IMPL(aload_0_fast_igetfield_8)
+TD_IMPL(aload_0_fast_agetfield_8) TD_ALOAD_0_GETFIELD(8, 1);
+#endif
+
+TD_IMPL(fast_iputfield)
+TD_IMPL(fast_fputfield)
+  {
+    const address obj = TD_OBJ_TOS(1);
+    if (obj == NULL) {
+      goto td_fallback;
+    }
+    *(jint*)(obj + TD_SHORT_NATIVE(0) * 4) = TD_TOS(0);
+    TD_DROP(2);
+    TD_NEXT(3);
+  }
+}
+
+#undef TD_ALOAD_0_GETFIELD
+#undef TD_GETFIELD
+#undef TD_ARRAY_STORE
+#undef TD_ARRAY_LOAD
+#undef TD_IMPL
+#undef TD_DEF
+#undef TD_BINARY_OP
+#undef TD_NEXT_ILOAD
+#undef TD_IS_ILOAD
+#undef TD_BRANCH
+#undef TD_CHECK_TIMER_TICK
+#undef TD_DROP
+#undef TD_PUSH
+#undef TD_OBJ_TOS
+#undef TD_TOS
+#undef TD_LOCAL
+#undef TD_SHORT_NATIVE
+#undef TD_SIGNED_SHORT
+#undef TD_SIGNED_BYTE
+#undef TD_BYTE
+#undef TD_NEXT
+#undef TD_DISPATCH
+#undef TD_FLUSH_COUNTER
+#undef TD_COUNT
+#undef TD_SYNC_IN
+#undef TD_SYNC_OUT
+#endif // USE_C_INTERPRETER_THREADED_DISPATCH
+
+#if USE_DEBUG_PRINTING
+// Interpreter loop that collects the data for +PrintBytecodeHistogram and
+// +PrintPairHistogram.
+static void interpret_with_histograms() {
+  int last_code = -1;
+  for (;;) {
+    if (TraceBytecodes) {
+      interpreter_call_vm((address)&trace_bytecode, T_VOID);
+    }
+    const int code = *g_jpc;
+    interpreter_bytecode_counters[code]++;
+    if (last_code >= 0) {
+      interpreter_pair_counters[last_code * Bytecodes::number_of_java_codes +
+                                code]++;
+    }
+    last_code = code;
+    interpreter_dispatch_table[code]();
+  }
+}
+#endif
+
 // interpreter
 static void Interpret() {
   // Start a new thread or continue in another existing thread
   // after thread termination.
   // NOTE that it also can invoke longjmp, so it must be called after setjmp
   resume_thread();
+#if USE_DEBUG_PRINTING
+  if (PrintBytecodeHistogram || PrintPairHistogram) {
+    interpret_with_histograms();
+  }
+#endif
+#if USE_C_INTERPRETER_THREADED_DISPATCH
+  if (UseThreadedDispatch && !TraceBytecodes) {
+    interpret_threaded();
+  }
+#endif
   // process bytecodes in the infinite loop
   if (TraceBytecodes) {
     for (;;) {
@@ -4486,6 +5154,9 @@ static void Interpret() {
     }
   } else {
     for (;;) {
+#if ENABLE_DETAILED_PERFORMANCE_COUNTERS
+      PERFORMANCE_COUNTER_INCREMENT(num_of_interpreted_bytecodes, 1);
+#endif
       interpreter_dispatch_table[*g_jpc]();
     }
   }
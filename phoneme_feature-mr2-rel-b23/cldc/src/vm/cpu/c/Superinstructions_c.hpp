@@ -0,0 +1,63 @@
+/*
+ *
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+// Superinstructions of the threaded C interpreter loop, see
+// interpret_threaded() in Interpreter_c.cpp.
+//
+// Each SUPERINSTRUCTION_XXX macro enables one fused bytecode sequence. A
+// fused sequence is recognized when its first bytecode is dispatched and
+// the rest of it is executed with a single dispatch, without pushing and
+// popping the intermediate values. The bytecodes themselves are not
+// rewritten, so the rest of the VM never sees the fused sequences.
+//
+// The selection should follow the pair histogram of the applications
+// that matter. To generate it, run a non-product VM with
+// +PrintPairHistogram =PairHistogramCutOff0, save the output and rebuild
+// with
+//
+//     SUPERINSTRUCTION_PROFILE=<saved output>
+//
+// which makes the build run "buildtool.jar superinstructions" to create
+// superinstructions.h in the generated directory. Otherwise the defaults
+// below are used; they cover the sequences that dominate typical MIDlet
+// code.
+//
+// SUPERINSTRUCTION_ALOAD_0_GETFIELD   aload_0, fast_{i,a}getfield
+// SUPERINSTRUCTION_ILOAD_ILOAD        two consecutive int local loads
+// SUPERINSTRUCTION_ILOAD_ILOAD_IADD   iload*, iload*, iadd
+//                                     (requires ILOAD_ILOAD)
+// SUPERINSTRUCTION_IGETFIELD_IRETURN  fast_igetfield, ireturn
+// SUPERINSTRUCTION_IINC_GOTO          iinc, goto (loop back branch)
+
+#if USE_GENERATED_SUPERINSTRUCTIONS
+#include "superinstructions.h"
+#else
+#define SUPERINSTRUCTION_ALOAD_0_GETFIELD       1
+#define SUPERINSTRUCTION_ILOAD_ILOAD            1
+#define SUPERINSTRUCTION_ILOAD_ILOAD_IADD       1
+#define SUPERINSTRUCTION_IGETFIELD_IRETURN      1
+#define SUPERINSTRUCTION_IINC_GOTO              1
+#endif
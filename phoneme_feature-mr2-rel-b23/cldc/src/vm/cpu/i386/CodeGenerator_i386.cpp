@@ -2298,18 +2298,60 @@ void CodeGenerator::lookup_switch(Value& index, jint table_index,
                                   jint default_dest,
                                   jint num_of_pairs JVM_TRAPS) { 
   for (int i = 0; i < num_of_pairs; i++) { 
-    int key = method()->get_java_switch_int(8 * i + table_index + 8);
     int jump_offset = method()->get_java_switch_int(8 * i + table_index + 12);
     if (jump_offset <= 0) {
       // Negative offset in a branch table is not a usual case
       Compiler::abort_active_compilation(true JVM_THROW);
     }
-    cmpl(index.lo_register(),  key);
-    conditional_jump(BytecodeClosure::eq, bci() + jump_offset, false JVM_CHECK);
   }
+  // The keys are sorted, so a large table is searched with a balanced
+  // tree of compares: log2(num_of_pairs) + 1 compares instead of
+  // num_of_pairs for the default case.
+  lookup_switch(index.lo_register(), table_index, 0, num_of_pairs - 1,
+                default_dest JVM_CHECK);
   branch(default_dest JVM_NO_CHECK_AT_BOTTOM);
 }
 
+void CodeGenerator::lookup_switch(Register index, jint table_index,
+                                  jint start, jint end,
+                                  jint default_dest JVM_TRAPS) {
+  if (end - start + 1 < LookupSwitchLinearLimit) {
+    for (int i = start; i <= end; i++) {
+      int key = method()->get_java_switch_int(8 * i + table_index + 8);
+      int jump_offset = method()->get_java_switch_int(8 * i + table_index + 12);
+      cmpl(index, key);
+      conditional_jump(BytecodeClosure::eq, bci() + jump_offset, false
+                       JVM_CHECK);
+    }
+    // Allowed to fall through on default
+  } else {
+    Label larger, smaller_default;
+    int i = (start + end) >> 1;
+    int key = method()->get_java_switch_int(8 * i + table_index + 8);
+    int jump_offset = method()->get_java_switch_int(8 * i + table_index + 12);
+
+    cmpl(index, key);
+    conditional_jump(BytecodeClosure::eq, bci() + jump_offset, false
+                     JVM_CHECK);
+    jcc(greater, larger);
+    {
+      PreserveVirtualStackFrameState state(frame() JVM_CHECK);
+      // Handle start .. i - 1
+      lookup_switch(index, table_index, start, i - 1, default_dest JVM_CHECK);
+      jmp(smaller_default);
+      CompilationContinuation::insert(default_dest, smaller_default
+                                      JVM_CHECK);
+    }
+  bind(larger);
+    {
+      PreserveVirtualStackFrameState state(frame() JVM_CHECK);
+      // Handle i + 1 .. end
+      lookup_switch(index, table_index, i + 1, end, default_dest JVM_CHECK);
+      // Allowed to fall through
+    }
+  }
+}
+
 
 void CodeGenerator::invoke(const Method* method, 
                            bool must_do_null_check JVM_TRAPS) {
@@ -42,6 +42,14 @@ private:
     call_from_compiled_code(entry, 0 JVM_NO_CHECK_AT_BOTTOM);
   }
 
+  void lookup_switch(Register index, jint table_index,
+                     jint start, jint end, jint default_dest JVM_TRAPS);
+  enum {
+    // lookupswitch ranges with fewer pairs than this are compiled as a
+    // compare chain rather than split further.
+    LookupSwitchLinearLimit = 4
+  };
+
   void ishift_helper(Value& result, Value& op1, Value& op2);
   void idiv_helper(Value& result, Value& op1, Value& op2 JVM_TRAPS);
   void verify_fpu() PRODUCT_RETURN;
@@ -93,7 +93,7 @@ int OsFile_remove(const char *filename) {
 }
 #endif // !ENABLE_PCSL
 
-#if USE_IMAGE_MAPPING
+#if USE_IMAGE_MAPPING || USE_JAR_ENTRY_MAPPING
 
 struct Linux_MappedImage : public OsFile_MappedImage {
   size_t  ro_length;
@@ -267,7 +267,7 @@ bool OsFile_UnmapImage(OsFile_MappedImageHandle mapped_image) {
   return ok;
 }
 
-#endif // USE_IMAGE_MAPPING
+#endif // USE_IMAGE_MAPPING || USE_JAR_ENTRY_MAPPING
 
 #ifdef __cplusplus
 }
@@ -31,6 +31,10 @@
 #include "incls/_precompiled.incl"
 #include "incls/_OsMisc_linux.cpp.incl"
 
+#if ENABLE_PARALLEL_GC
+#include <pthread.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -81,6 +85,122 @@ void OsMisc_page_unprotect() {
 }
 #endif // ENABLE_PAGE_PROTECTION
 
+#if ENABLE_PARALLEL_GC
+
+#define MAX_PARALLEL_THREADS 16
+
+// The helper threads are created once by OsMisc_parallel_initialize() and
+// wait on parallel_start between calls of OsMisc_parallel_do(). Helper i
+// does index i of the current call when parallel_work[i] is set. All of
+// the fields below are protected by parallel_lock.
+static pthread_mutex_t parallel_lock  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  parallel_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  parallel_done  = PTHREAD_COND_INITIALIZER;
+
+static pthread_t parallel_threads[MAX_PARALLEL_THREADS];
+static bool      parallel_work[MAX_PARALLEL_THREADS];
+static int       parallel_helpers;         // helper threads running
+static int       parallel_pending;         // helpers busy with this call
+static bool      parallel_stopping;
+static void    (*parallel_proc)(int, void*);
+static void*     parallel_param;
+
+static void* parallel_thread_routine(void* arg) {
+  const int index = (int)(size_t)arg;
+
+  pthread_mutex_lock(&parallel_lock);
+  for (;;) {
+    while (!parallel_work[index] && !parallel_stopping) {
+      pthread_cond_wait(&parallel_start, &parallel_lock);
+    }
+    if (parallel_stopping) {
+      break;
+    }
+    parallel_work[index] = false;
+    void (*proc)(int, void*) = parallel_proc;
+    void* param = parallel_param;
+
+    pthread_mutex_unlock(&parallel_lock);
+    proc(index, param);
+    pthread_mutex_lock(&parallel_lock);
+
+    if (--parallel_pending == 0) {
+      pthread_cond_signal(&parallel_done);
+    }
+  }
+  pthread_mutex_unlock(&parallel_lock);
+  return NULL;
+}
+
+void OsMisc_parallel_initialize(int count) {
+  GUARANTEE(parallel_helpers == 0, "already initialized");
+  if (count > MAX_PARALLEL_THREADS) {
+    count = MAX_PARALLEL_THREADS;
+  }
+  parallel_stopping = false;
+  // Index 0 is always done by the calling thread. If a helper thread
+  // cannot be created, the pool just stays smaller.
+  for (int i = 1; i < count; i++) {
+    parallel_work[i] = false;
+    if (pthread_create(&parallel_threads[i], NULL, parallel_thread_routine,
+                       (void*)(size_t)i) != 0) {
+      break;
+    }
+    parallel_helpers = i;
+  }
+}
+
+void OsMisc_parallel_dispose() {
+  pthread_mutex_lock(&parallel_lock);
+  parallel_stopping = true;
+  pthread_cond_broadcast(&parallel_start);
+  pthread_mutex_unlock(&parallel_lock);
+
+  for (int i = 1; i <= parallel_helpers; i++) {
+    pthread_join(parallel_threads[i], NULL);
+  }
+  parallel_helpers = 0;
+}
+
+void OsMisc_parallel_do(void proc(int index, void* param), void* param,
+                        int count) {
+  GUARANTEE(count <= MAX_PARALLEL_THREADS, "too many threads");
+
+  int helpers = count - 1;
+  if (helpers > parallel_helpers) {
+    helpers = parallel_helpers;
+  }
+
+  if (helpers > 0) {
+    pthread_mutex_lock(&parallel_lock);
+    parallel_proc    = proc;
+    parallel_param   = param;
+    parallel_pending = helpers;
+    for (int i = 1; i <= helpers; i++) {
+      parallel_work[i] = true;
+    }
+    pthread_cond_broadcast(&parallel_start);
+    pthread_mutex_unlock(&parallel_lock);
+  }
+
+  // The work of the indices the pool has no thread for is done by the
+  // caller, too.
+  proc(0, param);
+  for (int j = helpers + 1; j < count; j++) {
+    proc(j, param);
+  }
+
+  if (helpers > 0) {
+    pthread_mutex_lock(&parallel_lock);
+    while (parallel_pending > 0) {
+      pthread_cond_wait(&parallel_done, &parallel_lock);
+    }
+    pthread_mutex_unlock(&parallel_lock);
+  }
+}
+
+#endif // ENABLE_PARALLEL_GC
+
 #ifdef __cplusplus
 }
 #endif
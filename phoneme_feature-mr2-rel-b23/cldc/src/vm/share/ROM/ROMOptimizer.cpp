@@ -403,6 +403,10 @@ void ROMOptimizer::initialize(Stream *log_stream JVM_TRAPS) {
 
 #endif // USE_SOURCE_IMAGE_GENERATOR
 
+#if USE_AOT_COMPILATION
+  read_precompile_profile(JVM_SINGLE_ARG_CHECK);
+#endif
+
   allocate_empty_arrays(JVM_SINGLE_ARG_CHECK);
   initialize_subclasses_cache(JVM_SINGLE_ARG_CHECK);
 }
@@ -932,7 +936,9 @@ void ROMOptimizer::quicken_methods(JVM_SINGLE_ARG_TRAPS) {
       }
     
 #if USE_BINARY_IMAGE_GENERATOR && USE_AOT_COMPILATION
-      {
+      // With -precompileprofile the profile selects the methods to
+      // precompile (see read_precompile_profile()).
+      if (Arguments::precompile_profile_file() == NULL) {
         UsingFastOops level2;
         Symbol::Fast method_name = method().name();
         Signature::Fast signature = method().signature();
@@ -3548,6 +3554,132 @@ void ROMOptimizer::resolve_constant_pool(JVM_SINGLE_ARG_TRAPS) {
 #endif
 
 #if USE_AOT_COMPILATION
+
+class PrecompileMatcher : public JavaClassPatternMatcher {
+  ROMVector *_log_vector;
+public:
+  PrecompileMatcher(ROMVector *log_vector) {
+    _log_vector = log_vector;
+  }
+  virtual void handle_matching_method(Method *m JVM_TRAPS) {
+    if (m->is_quick_native() 
+          || m->is_impossible_to_compile()
+          || m->is_fast_get_accessor()
+          || _log_vector->contains(m)) { 
+      return;
+    }
+    _log_vector->add_element(m JVM_NO_CHECK_AT_BOTTOM);
+  }
+};
+
+void ROMOptimizer::enable_precompile(char * pattern JVM_TRAPS) {
+  PrecompileMatcher matcher(precompile_method_list());
+  matcher.run(pattern JVM_NO_CHECK_AT_BOTTOM);
+}
+
+// Each method line of a flat profile written by the statistical profiler
+// (see FlatProfiler::print) looks like
+//
+//   " 12.3%      1.230      100       23     java.lang.String.charAt"
+//
+// i.e., the share of all ticks, the time, the interpreted and compiled
+// ticks, and the method. Returns the method if its share is at least
+// PrecompileProfileThreshold tenths of a percent, or NULL otherwise.
+static char* hot_method_in_profile_line(char* line) {
+  char* p = line;
+  while (*p == ' ') {
+    p++;
+  }
+  int share = 0;
+  for (; '0' <= *p && *p <= '9'; p++) {
+    share = share * 10 + (*p - '0');
+  }
+  share *= 10;
+  if (*p == '.') {
+    p++;
+    if ('0' <= *p && *p <= '9') {
+      share += *p++ - '0';
+    }
+  }
+  if (p == line || *p != '%' || share < PrecompileProfileThreshold) {
+    return NULL;
+  }
+  p++;
+
+  // Skip the time and the tick counts.
+  for (int i = 0; i < 3; i++) {
+    while (*p == ' ') {
+      p++;
+    }
+    while (*p != ' ' && *p != 0) {
+      p++;
+    }
+  }
+  while (*p == ' ') {
+    p++;
+  }
+
+  // Overloaded methods may be followed by their decoded signature,
+  // which is not a valid pattern -- match all overloads instead.
+  char* end = p;
+  while (*end != 0 && *end != '(' && *end != ' ') {
+    end++;
+  }
+  *end = 0;
+  if (jvm_strchr(p, '.') == NULL) {
+    // Not a method, e.g., "Garbage collector".
+    return NULL;
+  }
+  return p;
+}
+
+void ROMOptimizer::read_precompile_profile(JVM_SINGLE_ARG_TRAPS) {
+  const JvmPathChar* profile_file = Arguments::precompile_profile_file();
+  if (profile_file == NULL) {
+    return;
+  }
+
+  OsFile_Handle f = OsFile_open(profile_file, "r");
+  if (f == NULL) {
+    tty->print_cr("Error: precompilation profile not found: %s",
+                  profile_file);
+    JVM::exit(0);
+  }
+#if USE_ROM_LOGGING
+  _log_stream->print_cr("Reading precompilation profile %s", profile_file);
+#endif
+
+  char buff[1024];
+  for (;;) {
+    char c;
+    char* s = buff;
+    int max = (sizeof(buff) / sizeof(char)) - 1;
+    int n = 0;
+    while (((s - buff) < max) && (n = OsFile_read(f, &c, 1, 1)) == 1) {
+      if (c == '\r') {
+        continue;
+      } else if (c == '\n') {
+        break;
+      }
+      *s++ = c;
+    }
+    if (s == buff && n < 1) {
+      break;
+    }
+    *s = 0;
+
+    char* method = hot_method_in_profile_line(buff);
+    if (method != NULL) {
+      enable_precompile(method JVM_NO_CHECK);
+      if (CURRENT_HAS_PENDING_EXCEPTION) {
+        break;
+      }
+    }
+  }
+
+  OsFile_close(f);
+}
+
 void ROMOptimizer::precompile_methods(JVM_SINGLE_ARG_TRAPS) {
   // AOT is supported only on ARM right now.
   // Note that AOT cross-compiler uses different Java Frame layout than
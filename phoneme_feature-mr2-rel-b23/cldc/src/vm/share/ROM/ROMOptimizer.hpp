@@ -376,6 +376,7 @@ private:
   void write_kvm_natives_log();
 #if USE_AOT_COMPILATION
   void enable_precompile(char* pattern JVM_TRAPS);
+  void read_precompile_profile(JVM_SINGLE_ARG_TRAPS);
 #endif
 
   bool dont_rename_class(InstanceClass *klass) {
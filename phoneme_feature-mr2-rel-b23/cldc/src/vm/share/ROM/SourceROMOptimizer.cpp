@@ -946,31 +946,6 @@ void ROMOptimizer::write_quick_natives_log() {
 }
 #endif
 
-#if USE_AOT_COMPILATION
-
-class PrecompileMatcher : public JavaClassPatternMatcher {
-  ROMVector *_log_vector;
-public:
-  PrecompileMatcher(ROMVector *log_vector) {
-    _log_vector = log_vector;
-  }
-  virtual void handle_matching_method(Method *m JVM_TRAPS) {
-    if (m->is_quick_native() 
-          || m->is_impossible_to_compile()
-          || m->is_fast_get_accessor()) { 
-      return;
-    }
-    _log_vector->add_element(m JVM_NO_CHECK_AT_BOTTOM);
-  }
-};
-
-void ROMOptimizer::enable_precompile(char * pattern JVM_TRAPS) {
-  PrecompileMatcher matcher(precompile_method_list());
-  matcher.run(pattern JVM_NO_CHECK_AT_BOTTOM);
-}
-
-#endif
-
 class KvmNativesMatcher : public JavaClassPatternMatcher {
   ROMVector *_log_vector;
 public:
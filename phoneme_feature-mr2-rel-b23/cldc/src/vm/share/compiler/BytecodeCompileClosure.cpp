@@ -1852,6 +1852,34 @@ void BytecodeCompileClosure::invoke_interface(int index, int num_of_args
   if (receiver.must_be_null()) {
     throw_null_pointer_exception(JVM_SINGLE_ARG_NO_CHECK_AT_BOTTOM);
   } else {
+#if ENABLE_COMPILER_TYPE_INFO
+    // If the class of the receiver is known, the itable lookup can be done
+    // now, and the call becomes a direct one.
+    const jushort receiver_class_id = receiver.class_id();
+    JavaClass::Fast receiver_class =
+      Universe::class_from_id(receiver_class_id);
+    if (receiver.is_exact_type() || receiver_class().is_final_type()) {
+      ClassInfo::Fast info = receiver_class().class_info();
+      Method::Fast callee = info().interface_method_at(class_id, itable_index);
+      if (callee.not_null()) {
+        receiver.destroy();
+        if (is_active_bci()) {
+          __ osr_entry(JVM_SINGLE_ARG_CHECK);
+        }
+        if (TraceMethodInlining) {
+          tty->print("Method ");
+          callee().print_name_on_tty();
+          tty->print(" devirtualized in ");
+          method()->print_name_on_tty();
+          tty->cr();
+        }
+        do_direct_invoke(&callee, true/*need null check*/
+                         JVM_NO_CHECK_AT_BOTTOM);
+        return;
+      }
+    }
+#endif
+
     // Make sure that invoke_interface can use whatever registers it
     // wants to
     receiver.destroy();
@@ -1862,12 +1890,78 @@ void BytecodeCompileClosure::invoke_interface(int index, int num_of_args
       __ osr_entry(JVM_SINGLE_ARG_CHECK);
     }
 
+#if ENABLE_TYPE_PROFILE
+    if (guarded_invoke(class_id, itable_index, true, num_of_args JVM_CHECK)) {
+      return;
+    }
+#endif
+
     // Call the method.
     __ invoke_interface(&klass, itable_index, num_of_args, result_type 
                         JVM_NO_CHECK_AT_BOTTOM);
   }
 }
 
+#if ENABLE_TYPE_PROFILE
+bool BytecodeCompileClosure::guarded_invoke(int class_id, int index,
+                                            bool is_interface,
+                                            int size_of_parameters
+                                            JVM_TRAPS) {
+  // The guard needs an uncommon trap, which is not possible in precompiled
+  // or shared code, without a stack frame, or inside an inlined method.
+  if (GenerateROMImage || method()->is_shared() || Compiler::is_inlining() ||
+      Compiler::omit_stack_frame()) {
+    return false;
+  }
+
+  const int target_id = Compiler::monomorphic_call_site_target(method(),
+                                                               bci());
+  if (target_id < 0) {
+    return false;
+  }
+
+  UsingFastOops fast_oops;
+  JavaClass::Fast klass = Universe::class_from_id(class_id);
+  JavaClass::Fast holder = Universe::class_from_id(target_id);
+  if (holder.is_null() || !holder().is_instance_class() ||
+      !holder().is_subtype_of(&klass)) {
+    return false;
+  }
+
+  ClassInfo::Fast info = holder().class_info();
+  Method::Fast target;
+  if (is_interface) {
+    target = info().interface_method_at(class_id, index);
+  } else if (index < info().vtable_length()) {
+    target = info().vtable_method_at(index);
+  }
+  if (target.is_null() || target().is_abstract()) {
+    return false;
+  }
+
+  Value receiver(T_OBJECT);
+  frame()->receiver(receiver, size_of_parameters);
+  if (receiver.must_be_null()) {
+    return false;
+  }
+  __ check_receiver_target(receiver, &target, is_interface ? -1 : index
+                           JVM_CHECK_0);
+  receiver.destroy();
+
+  if (TraceMethodInlining) {
+    tty->print("Method ");
+    target().print_name_on_tty();
+    tty->print(" devirtualized by type profile in ");
+    method()->print_name_on_tty();
+    tty->cr();
+  }
+  PERFORMANCE_COUNTER_INCREMENT(type_profile_guarded_calls, 1);
+
+  do_direct_invoke(&target, true/*need null check*/ JVM_CHECK_0);
+  return true;
+}
+#endif
+
 void BytecodeCompileClosure::fast_invoke_virtual(int index JVM_TRAPS) {
   COMPILER_PERFORMANCE_COUNTER_IN_BLOCK(fast_invoke_virtual);
 
@@ -1944,6 +2038,12 @@ void BytecodeCompileClosure::fast_invoke_virtual(int index JVM_TRAPS) {
   } else
 #endif
   {
+#if ENABLE_TYPE_PROFILE
+    if (guarded_invoke(class_id, vtable_index, false,
+                       callee().size_of_parameters() JVM_CHECK)) {
+      return;
+    }
+#endif
     // Call the method.
     __ invoke_virtual(&callee, vtable_index, return_type 
                       JVM_NO_CHECK_AT_BOTTOM);
@@ -2182,6 +2282,17 @@ void BytecodeCompileClosure::throw_null_pointer_exception(JVM_SINGLE_ARG_TRAPS)
 }
 
 void BytecodeCompileClosure::array_check(Value& array, Value& index JVM_TRAPS) {
+  if (Compiler::current()->is_index_in_bounds(bci())) {
+    // a[i] inside "for (i = k; i < a.length; i++)", see
+    // Method::mark_counted_loop().
+#ifndef PRODUCT
+    __ comment("Elide index and null check in counted loop");
+#endif
+    if (array.in_register()) {
+      frame()->set_value_must_be_nonnull(array);
+    }
+    return;
+  }
   if (index.is_immediate()) {
     int length;
     if (array.has_known_min_length(length) &&
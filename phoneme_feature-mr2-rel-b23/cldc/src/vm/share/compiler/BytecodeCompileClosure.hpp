@@ -196,6 +196,15 @@ class BytecodeCompileClosure: public BytecodeClosure {
   // vtable or itable.
   void do_direct_invoke(Method * method, bool must_do_null_check JVM_TRAPS);
 
+#if ENABLE_TYPE_PROFILE
+  // Helper function for invoking the only target observed at a virtual
+  // (or interface) call site directly, after a guard that traps to the
+  // interpreter if the receiver dispatches elsewhere. Returns false if no
+  // such target is known.
+  bool guarded_invoke(int class_id, int index, bool is_interface,
+                      int size_of_parameters JVM_TRAPS);
+#endif
+
   // Helper function for invoking a method directly (w/o going through
   // vtable or itable.
   void direct_invoke(int index, bool must_do_null_check JVM_TRAPS);
@@ -180,6 +180,48 @@ void CodeGenerator::uncommon_trap(JVM_SINGLE_ARG_TRAPS) {
   call_vm((address) ::uncommon_trap, T_VOID JVM_NO_CHECK_AT_BOTTOM);
 }
 
+#if ENABLE_TYPE_PROFILE
+void CodeGenerator::check_receiver_target(Value& receiver, Method* target,
+                                          int vtable_index JVM_TRAPS) {
+  COMPILER_COMMENT(("Check the receiver against the profiled call target"));
+
+  // Load the near of the receiver. This is also the null check of the call.
+  Value near(T_OBJECT);
+  load_from_object(near, receiver, Oop::klass_offset(), true JVM_CHECK);
+
+  Value actual(T_OBJECT);
+  Value expected(T_OBJECT);
+  if (vtable_index >= 0) {
+    // Compare the vtable entry of the receiver with the target, so that
+    // subclasses that do not override the target pass the guard as well.
+    Value info(T_OBJECT);
+    load_from_object(info, near, JavaNear::class_info_offset(), false
+                     JVM_CHECK);
+    near.destroy();
+    load_from_object(actual, info,
+                     ClassInfo::vtable_offset_from_index(vtable_index), false
+                     JVM_CHECK);
+    info.destroy();
+    expected.set_obj(target);
+  } else {
+    // Compare the class of the receiver with the holder of the target.
+    load_from_object(actual, near, Oop::klass_offset(), false JVM_CHECK);
+    near.destroy();
+    UsingFastOops fast_oops;
+    JavaClass::Fast holder = target->holder();
+    expected.set_obj(&holder);
+  }
+
+  cmp_values(actual, expected);
+  actual.destroy();
+  expected.destroy();
+
+  Label guard_failed;
+  conditional_jump_do(BytecodeClosure::ne, guard_failed);
+  UncommonTrapStub::insert(bci(), guard_failed JVM_NO_CHECK_AT_BOTTOM);
+}
+#endif
+
 void CodeGenerator::osr_entry(bool force JVM_TRAPS) {
   GUARANTEE(!Compiler::is_inlining(),
             "OSR stubs not supported for inlined methods");
@@ -261,6 +261,15 @@ public:
   // Bail out to the interpreter.
   void uncommon_trap(JVM_SINGLE_ARG_TRAPS);
 
+#if ENABLE_TYPE_PROFILE
+  // Branch to an uncommon trap unless a call on <receiver> dispatches to
+  // <target>. With a non-negative <vtable_index> the vtable entry of the
+  // receiver is checked, otherwise the class of the receiver must be the
+  // holder of <target>.
+  void check_receiver_target(Value& receiver, Method* target,
+                             int vtable_index JVM_TRAPS);
+#endif
+
   void check_bytecode_counter();
 
   // Check for stack overflow and timer ticks
@@ -110,7 +110,8 @@ bool CompilationQueueElement::compile(JVM_SINGLE_ARG_TRAPS) {
     /* osr_stub                 */ (compile_func) &OSRStub::compile,
     /* stack_overflow_stub      */ (compile_func) &StackOverflowStub::compile,
     /* timer_tick_stub          */ (compile_func) &TimerTickStub::compile,
-    /* quick_catch_stub         */ (compile_func) &QuickCatchStub::compile
+    /* quick_catch_stub         */ (compile_func) &QuickCatchStub::compile,
+    /* uncommon_trap_stub       */ (compile_func) &UncommonTrapStub::compile
   };
 
   if (type() == compilation_continuation) {
@@ -146,7 +147,7 @@ bool CompilationQueueElement::compile(JVM_SINGLE_ARG_TRAPS) {
     return finished;
 #endif
   } else {
-    GUARANTEE(throw_exception_stub <= type() && type() <= quick_catch_stub,
+    GUARANTEE(throw_exception_stub <= type() && type() <= uncommon_trap_stub,
               "sanity");
     compile_func compile = funcs[type()];
     (this->*compile)(JVM_SINGLE_ARG_NO_CHECK);
@@ -426,6 +427,9 @@ bool CompilationContinuation::compile_bytecodes(JVM_SINGLE_ARG_TRAPS) {
           COMPILER_PERFORMANCE_COUNTER_IN_BLOCK(conformance_entry);
           frame->conformance_entry(true);
         }
+        if (Compiler::current()->has_loops()) {
+          frame->cache_loop_locals(Compiler::bci());
+        }
 
         // Emit code for an entry.
         BinaryAssembler::Label entry_label;
@@ -642,6 +646,24 @@ void QuickCatchStub::compile(JVM_SINGLE_ARG_TRAPS) {
                                   JVM_NO_CHECK_AT_BOTTOM);
 }
 
+void UncommonTrapStub::insert(int bci, BinaryAssembler::Label& entry_label
+                              JVM_TRAPS) {
+  UncommonTrapStub::Raw stub =
+      CompilationQueueElement::allocate(uncommon_trap_stub, bci JVM_NO_CHECK);
+  if (stub.not_null()) {
+    stub().set_entry_label(entry_label);
+    Compiler::current()->insert_compilation_queue_element(&stub);
+  }
+}
+
+void UncommonTrapStub::compile(JVM_SINGLE_ARG_TRAPS) {
+  COMPILER_COMMENT(("Uncommon trap stub"));
+
+  BinaryAssembler::Label stub = entry_label();
+  Compiler::code_generator()->bind(stub);
+  Compiler::code_generator()->uncommon_trap(JVM_SINGLE_ARG_NO_CHECK_AT_BOTTOM);
+}
+
 void TimerTickStub::compile(JVM_SINGLE_ARG_TRAPS) {
   COMPILER_PERFORMANCE_COUNTER_IN_BLOCK(timer_tick_stub);
   COMPILER_COMMENT(("Timer Tick"));
@@ -88,7 +88,8 @@ class CompilationQueueElement: public MixedOop {
     osr_stub,
     stack_overflow_stub,
     timer_tick_stub,
-    quick_catch_stub
+    quick_catch_stub,
+    uncommon_trap_stub
 #if ENABLE_INTERNAL_CODE_OPTIMIZER
     , entry_stub
 #endif
@@ -591,6 +592,20 @@ class QuickCatchStub: public CompilationQueueElement {
   }
 };
 
+class UncommonTrapStub: public CompilationQueueElement {
+ public:
+  HANDLE_DEFINITION(UncommonTrapStub, CompilationQueueElement);
+
+  void compile(JVM_SINGLE_ARG_TRAPS);
+
+  static void insert(int bci, BinaryAssembler::Label& entry_label JVM_TRAPS);
+
+  static UncommonTrapStub* cast(CompilationQueueElement* value) {
+    GUARANTEE(value->type() == uncommon_trap_stub, "Type check");
+    return (UncommonTrapStub*) value;
+  }
+};
+
 class OSRStub: public CompilationQueueElement {
  private:
   void emit_osr_entry_and_callinfo(CodeGenerator *gen JVM_TRAPS);
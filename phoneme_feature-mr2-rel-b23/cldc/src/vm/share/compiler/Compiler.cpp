@@ -239,6 +239,12 @@ void Compiler::on_timer_tick(bool is_real_time_tick JVM_TRAPS) {
     }
   }
 
+#if ENABLE_TYPE_PROFILE
+  if( UseTypeProfile ) {
+    record_call_site_sample(&frame);
+  }
+#endif
+
   CompiledMethodCache::on_timer_tick();
   if( --Universe::_compilation_abstinence_ticks >= 0 ) {
     return;
@@ -312,6 +318,203 @@ void Compiler::on_timer_tick(bool is_real_time_tick JVM_TRAPS) {
   }
 }
 
+// Called by the scheduler when no Java thread is ready to run. A
+// compilation suspended on a timer tick is resumed here for one more
+// slice of at most MaxCompilationTime, so that long compilations are
+// finished in idle time instead of in the time slices of Java threads.
+// Returns true if a slice was run.
+bool Compiler::on_idle(JVM_SINGLE_ARG_TRAPS) {
+  if( !IdleTimeCompilation || !is_suspended() || TestCompiler ||
+      !UseCompiler || !Universe::is_compilation_allowed() ) {
+    return false;
+  }
+
+  UsingFastOops fast_oops;
+  Method::Fast method;
+  {
+    CompiledMethod::Raw suspended_compiled_method = current_compiled_method();
+    if( suspended_compiled_method.is_null() ) {
+      return false;
+    }
+    method = suspended_compiled_method().method();
+  }
+  method().compile(0, true JVM_MUST_SUCCEED);
+  PERFORMANCE_COUNTER_INCREMENT(compilation_idle_resume_count, 1);
+  GUARANTEE( Compiler::is_suspended() ==
+             Compiler::current_compiled_method()->not_null(), "sanity");
+  return true;
+}
+
+#if ENABLE_TYPE_PROFILE
+// The call-site target profile is a small direct-mapped table filled in by
+// sampling: on each timer tick the method of the top frame is recorded as
+// the target of the virtual or interface call its caller is executing.
+// Methods move during GC, so a method is identified by the class id of its
+// holder and its index in the holder's method array.
+struct CallSiteProfile {
+  jushort _caller_id;
+  jushort _caller_index;
+  jushort _bci;
+  jushort _target_id;
+  jubyte  _samples;             // 0 if the entry is free
+  jubyte  _is_polymorphic;
+};
+
+static CallSiteProfile _call_site_profile[256];
+
+static int method_index_in_holder(const Method* m) {
+  InstanceClass::Raw holder = m->holder();
+  ObjArray::Raw methods = holder().methods();
+  for (int i = methods().length(); --i >= 0; ) {
+    if (methods().obj_at(i) == m->obj()) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Returns the entry for the given call site, or the entry that the call
+// site would replace if it is not in the table.
+static CallSiteProfile* call_site_profile_at(const int caller_id,
+                                             const int caller_index,
+                                             const int bci) {
+  const juint hash = (juint)(caller_id * 31 + caller_index) * 17 + bci;
+  const int size = ARRAY_SIZE(_call_site_profile);
+  return &_call_site_profile[hash & (size - 1)];
+}
+
+static bool call_site_matches(const CallSiteProfile* entry,
+                              const int caller_id, const int caller_index,
+                              const int bci) {
+  return entry->_samples != 0 && entry->_caller_id == caller_id &&
+         entry->_caller_index == caller_index && entry->_bci == bci;
+}
+
+void Compiler::record_call_site_sample(JavaFrame* callee_frame) {
+  UsingFastOops fast_oops;
+  Method::Fast callee = callee_frame->method();
+  if (callee().access_flags().is_static() ||
+      callee().holder_id() == 0xFFFF) {
+    return;
+  }
+
+  Frame fr(*callee_frame);
+  callee_frame->caller_is(fr);
+  if (fr.is_entry_frame()) {
+    return;
+  }
+  JavaFrame caller_frame = fr.as_JavaFrame();
+  Method::Fast caller = caller_frame.method();
+  const int bci = caller_frame.bci();
+  const Bytecodes::Code code = caller().bytecode_at(bci);
+  if (code != Bytecodes::_fast_invokevirtual &&
+      code != Bytecodes::_fast_invokeinterface) {
+    return;
+  }
+
+  const int caller_index = method_index_in_holder(&caller);
+  if (caller_index < 0) {
+    return;
+  }
+  const int caller_id = caller().holder_id();
+  CallSiteProfile* entry = call_site_profile_at(caller_id, caller_index, bci);
+
+  if (!call_site_matches(entry, caller_id, caller_index, bci)) {
+    // Another call site owns the entry. It is replaced only after it has
+    // lost all of its samples, so that a hot call site is not evicted by
+    // an occasional sample of a cold one.
+    if (entry->_samples > 0 && --entry->_samples > 0) {
+      return;
+    }
+    entry->_caller_id = (jushort)caller_id;
+    entry->_caller_index = (jushort)caller_index;
+    entry->_bci = (jushort)bci;
+    entry->_target_id = callee().holder_id();
+    entry->_samples = 1;
+    entry->_is_polymorphic = false;
+    return;
+  }
+
+  if (entry->_is_polymorphic) {
+    return;
+  }
+  if (entry->_target_id != callee().holder_id()) {
+    entry->_is_polymorphic = true;
+    return;
+  }
+  if (entry->_samples >= TypeProfileThreshold) {
+    return;
+  }
+  if (++entry->_samples < TypeProfileThreshold) {
+    return;
+  }
+
+  // The call site has just become monomorphic. If its caller is already
+  // compiled, unlink the code so that the caller is recompiled with a
+  // guarded direct call at this site on its next invocation.
+  if (caller().has_compiled_code() && !caller().is_shared()) {
+    CompiledMethod::Raw code = caller().compiled_code();
+    if (!ROM::system_contains(code.obj())) {
+      caller().unlink_compiled_code();
+      PERFORMANCE_COUNTER_INCREMENT(type_profile_recompilations, 1);
+#ifndef PRODUCT
+      if (TraceTypeProfile) {
+        TTY_TRACE(("TypeProfile: recompile "));
+        caller().print_name_on(tty);
+        TTY_TRACE_CR((" for bci %d", bci));
+      }
+#endif
+    }
+  }
+}
+
+// Called when the guard of a guarded direct call fails at <bci> in
+// <caller>. The call site is marked polymorphic, so that the recompiled
+// caller uses a normal dispatch and does not trap again.
+void Compiler::on_call_site_guard_failure(const Method* caller,
+                                          const int bci) {
+  const int caller_index = method_index_in_holder(caller);
+  if (caller_index < 0) {
+    return;
+  }
+  const int caller_id = caller->holder_id();
+  CallSiteProfile* entry = call_site_profile_at(caller_id, caller_index, bci);
+  entry->_caller_id = (jushort)caller_id;
+  entry->_caller_index = (jushort)caller_index;
+  entry->_bci = (jushort)bci;
+  entry->_samples = (jubyte)TypeProfileThreshold;
+  entry->_is_polymorphic = true;
+#ifndef PRODUCT
+  if (TraceTypeProfile) {
+    TTY_TRACE(("TypeProfile: guard failed in "));
+    caller->print_name_on(tty);
+    TTY_TRACE_CR((" at bci %d", bci));
+  }
+#endif
+}
+
+// Returns the class id of the holder of the only target observed at <bci>
+// in <caller>, or -1 if the call site is not known to be monomorphic.
+int Compiler::monomorphic_call_site_target(const Method* caller,
+                                           const int bci) {
+  if (!UseTypeProfile) {
+    return -1;
+  }
+  const int caller_index = method_index_in_holder(caller);
+  if (caller_index < 0) {
+    return -1;
+  }
+  const int caller_id = caller->holder_id();
+  const CallSiteProfile* entry =
+      call_site_profile_at(caller_id, caller_index, bci);
+  if (!call_site_matches(entry, caller_id, caller_index, bci) ||
+      entry->_is_polymorphic || entry->_samples < TypeProfileThreshold) {
+    return -1;
+  }
+  return entry->_target_id;
+}
+#endif // ENABLE_TYPE_PROFILE
+
 #if ENABLE_INTERPRETATION_LOG
 void Compiler::process_interpretation_log() {
   jlong now = Os::java_time_millis();
@@ -445,6 +445,16 @@ class Compiler: public StackObj {
                Method::bci_branch_taken));
   }
 
+  bool is_index_in_bounds(const jint bci) {
+    return (bci_flags_table()->byte_at(bci) & 
+            Method::bci_index_in_bounds) != 0;
+  }
+
+  bool is_loop_header(const jint bci) {
+    return (bci_flags_table()->byte_at(bci) & 
+            Method::bci_loop_header) != 0;
+  }
+
   // Entry accessor.
   ReturnOop entry_for(const jint bci)  {
     return entry_table()->obj_at(bci);
@@ -561,6 +571,13 @@ class Compiler: public StackObj {
   static CompilerContext _suspended_compiler_context;
  public:
   static void on_timer_tick(bool is_real_time_tick JVM_TRAPS);
+  static bool on_idle(JVM_SINGLE_ARG_TRAPS);
+#if ENABLE_TYPE_PROFILE
+  static void record_call_site_sample(JavaFrame* callee_frame);
+  static void on_call_site_guard_failure(const Method* caller, const int bci);
+  static int  monomorphic_call_site_target(const Method* caller,
+                                           const int bci);
+#endif
   static void process_interpretation_log();
   static void set_hint(int hint);
 
@@ -753,6 +753,56 @@ void VirtualStackFrame::conformance_entry(bool merging) {
   }
 }
 
+void VirtualStackFrame::cache_loop_locals(int bci) {
+  enum {
+    // Only the first locals are considered, as with the CSE bitmaps
+    max_cached_locals = 32,
+    // Registers left free for evaluating expressions in the loop body
+    reserved_registers = 3
+  };
+
+  if (!CacheLoopLocals || Compiler::is_inlining() ||
+      !Compiler::current()->is_loop_header(bci)) {
+    return;
+  }
+  const int max_locals = min(method()->max_locals(), max_cached_locals);
+  jubyte uses[max_cached_locals];
+  if (!method()->loop_local_uses(bci, uses, max_locals)) {
+    return;
+  }
+
+  for (;;) {
+    if (!RegisterAllocator::has_free(reserved_registers + 1)) {
+      return;
+    }
+
+    // Pick the flushed int or object local used most often in the loop.
+    // A local used only once gains nothing from being loaded here.
+    int best = -1;
+    int best_uses = 1;
+    for (int index = 0; index < max_locals; index++) {
+      if (uses[index] > best_uses) {
+        RawLocation *raw_location = raw_location_at(index);
+        const BasicType type = raw_location->type();
+        if (raw_location->is_flushed() &&
+            (type == T_INT || type == T_OBJECT)) {
+          best = index;
+          best_uses = uses[index];
+        }
+      }
+    }
+    if (best < 0) {
+      return;
+    }
+    uses[best] = 0;
+
+    COMPILER_COMMENT(("Cache local %d across loop", best));
+    Value value(raw_location_at(best)->type());
+    value_at(value, best);
+    PERFORMANCE_COUNTER_INCREMENT(cached_loop_locals, 1);
+  }
+}
+
 #if USE_COMPILER_FPU_MAP || ENABLE_ARM_VFP
 
 void VirtualStackFrame::flush_fpu() {
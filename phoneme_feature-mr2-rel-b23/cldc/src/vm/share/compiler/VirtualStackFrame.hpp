@@ -375,6 +375,10 @@ class VirtualStackFrame: public MixedOop {
   // one 
   void conformance_entry(bool merging);
 
+  // load the locals used most in the loop headed by bci into registers,
+  // so that they stay there across the back edges
+  void cache_loop_locals(int bci);
+
   // make sure a frame types conform to the stack map, and discard any
   // frame types that don't match
   void conform_to_stack_map(int bci);
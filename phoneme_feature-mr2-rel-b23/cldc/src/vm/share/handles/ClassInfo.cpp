@@ -31,6 +31,20 @@ int ClassInfo::itable_methods_offset() {
   return itable_offset_from_index(itable_length());
 }
 
+ReturnOop ClassInfo::interface_method_at(int interface_class_id,
+                                         int itable_index) {
+  for (int index = 0; index < itable_length(); index++) {
+    if (itable_interface_class_id_at(index) == interface_class_id) {
+      const int offset = itable_offset_at(index);
+      if (offset <= 0) {
+        break;
+      }
+      return obj_field(offset + itable_index * sizeof(jobject));
+    }
+  }
+  return NULL;
+}
+
 jint ClassInfo::itable_size() {
   int nof_methods = 0;
   for (int index = 0; index < itable_length(); index++) {
@@ -294,6 +294,10 @@ class ClassInfo: public Oop {
 
   int itable_methods_offset();
 
+  // Returns the implementation of method #itable_index of the interface
+  // with the given class_id, or NULL if this class does not implement it.
+  ReturnOop interface_method_at(int interface_class_id, int itable_index);
+
   // Is this a ClassInfo for an ArrayClass?
   bool is_array() {
     return access_flags().is_array_class();
@@ -2268,6 +2268,337 @@ inline void Method::add_entry( jubyte counts[], const int bci, const int inc ) {
 #define ADD_BACK_BRANCH_ENTRY(offset) ADD_BRANCH_ENTRY(offset); \
   if(dest <= bci) { has_loops = true; }
 
+#define MARK_LOOP_HEADER \
+  if(dest <= bci) { bci_flags[dest] |= bci_loop_header; }
+
+// Returns the local variable index used by the <op> (e.g. _iload) or
+// <op_0> ... <op_0> + 3 (e.g. _iload_0) bytecode at <bcptr>, or -1 if the
+// bytecode is of another kind.
+static int local_index_of(const jubyte* bcptr, const Bytecodes::Code op,
+                          const Bytecodes::Code op_0) {
+  const int code = bcptr[0];
+  if (code == op) {
+    return bcptr[1];
+  }
+  if (op_0 <= code && code <= op_0 + 3) {
+    return code - op_0;
+  }
+  if (code == Bytecodes::_wide && bcptr[1] == op) {
+    return Bytes::get_Java_u2(address(bcptr+2));
+  }
+  return -1;
+}
+
+// Returns true if control can enter the bytecodes in [start, end) from a
+// bytecode outside of this range other than <allowed_branch_bci>.
+bool Method::has_branch_into(const int start, const int end,
+                             const int allowed_branch_bci) const {
+  const jubyte* codebase = (jubyte*)code_base();
+  const int codesize = code_size();
+
+#define CHECK_BRANCH(offset)                            \
+  if (is_outside) {                                     \
+    const int dest = bci + (offset);                    \
+    if (start <= dest && dest < end) {                  \
+      return true;                                      \
+    }                                                   \
+  }
+
+  for (int bci = 0; bci < codesize; bci += Bytecodes::length_for(this, bci)) {
+    const jubyte* const bcptr = codebase + bci;
+    const bool is_outside = (bci < start || bci >= end) &&
+                            bci != allowed_branch_bci;
+    switch (bcptr[0]) {
+      case Bytecodes::_jsr:
+      case Bytecodes::_jsr_w:
+      case Bytecodes::_ret:
+        return true;
+      case Bytecodes::_ifeq:
+      case Bytecodes::_ifne:
+      case Bytecodes::_iflt:
+      case Bytecodes::_ifge:
+      case Bytecodes::_ifgt:
+      case Bytecodes::_ifle:
+      case Bytecodes::_if_icmpeq:
+      case Bytecodes::_if_icmpne:
+      case Bytecodes::_if_icmplt:
+      case Bytecodes::_if_icmpge:
+      case Bytecodes::_if_icmpgt:
+      case Bytecodes::_if_icmple:
+      case Bytecodes::_if_acmpeq:
+      case Bytecodes::_if_acmpne:
+      case Bytecodes::_ifnull:
+      case Bytecodes::_ifnonnull:
+      case Bytecodes::_goto: {
+        CHECK_BRANCH(jshort(Bytes::get_Java_u2(address(bcptr+1))));
+      } break;
+      case Bytecodes::_goto_w: {
+        CHECK_BRANCH(int(Bytes::get_Java_u4(address(bcptr+1))));
+      } break;
+      case Bytecodes::_lookupswitch: {
+        const int table_index  = align_size_up(bci + 1, sizeof(jint));
+        CHECK_BRANCH( get_java_switch_int(table_index + 0) );
+
+        const int num_of_pairs = get_java_switch_int(table_index + 4);
+        for( int i = 0; i < num_of_pairs; i++ ) {
+          CHECK_BRANCH( get_java_switch_int(8 * i + table_index + 12) );
+        }
+      } break;
+      case Bytecodes::_tableswitch: {
+        const int table_index  = align_size_up(bci + 1, sizeof(jint));
+        CHECK_BRANCH( get_java_switch_int(table_index + 0) );
+
+        const int size = get_java_switch_int(table_index + 8) -
+                         get_java_switch_int(table_index + 4);
+        for (int i = 0; i <= size; i++) {
+          CHECK_BRANCH( get_java_switch_int(4 * i + table_index + 12) );
+        }
+      } break;
+    }
+  }
+
+#undef CHECK_BRANCH
+
+  TypeArray::Raw exception_table = this->exception_table();
+  const int len = exception_table().length();
+  for (int i = 0; i < len; i += 4 ) {
+    const int handler_bci = exception_table().ushort_at(i + 2);
+    if (start <= handler_bci && handler_bci < end) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Checks if the <goto_bci> is the entry of a counted loop of the form
+//
+//        goto cond
+//  body: ...
+//        iinc i 1
+//  cond: iload i
+//        aload a
+//        arraylength
+//        if_icmplt body
+//
+// where i is not otherwise modified and a is not modified in the loop.
+// The caller has checked that i >= 0 on entry, so 0 <= i < a.length holds
+// in the body, and a is not null. The index and null checks of each
+// a[i] access in the body are marked as redundant.
+void Method::mark_counted_loop(const int goto_bci, const int index_local,
+                               const jubyte entry_counts[],
+                               jubyte bci_flags[]) const {
+  const jubyte* codebase = (jubyte*)code_base();
+  const int codesize = code_size();
+  const int body = goto_bci + 3;
+  const int cond =
+      goto_bci + jshort(Bytes::get_Java_u2(address(codebase+goto_bci+1)));
+  if (cond <= body || cond >= codesize) {
+    return;
+  }
+
+  // Match the loop condition.
+  int bci = cond;
+  if (local_index_of(codebase + bci, Bytecodes::_iload,
+                     Bytecodes::_iload_0) != index_local) {
+    return;
+  }
+  bci += Bytecodes::length_for(this, bci);
+  if (bci >= codesize || entry_counts[bci] != 1) {
+    return;
+  }
+  const int array_local = local_index_of(codebase + bci, Bytecodes::_aload,
+                                         Bytecodes::_aload_0);
+  if (array_local < 0) {
+    return;
+  }
+  bci += Bytecodes::length_for(this, bci);
+  if (bci >= codesize || entry_counts[bci] != 1 ||
+      codebase[bci] != Bytecodes::_arraylength) {
+    return;
+  }
+  bci += Bytecodes::length_for(this, bci);
+  if (bci >= codesize || entry_counts[bci] != 1 ||
+      codebase[bci] != Bytecodes::_if_icmplt ||
+      bci + jshort(Bytes::get_Java_u2(address(codebase+bci+1))) != body) {
+    return;
+  }
+  const int end = bci + Bytecodes::length_for(this, bci);
+
+  // The only change to i in the body must be the final "iinc i 1", and a
+  // must not change at all.
+  int last_bci = -1;
+  for (bci = body; bci < cond; bci += Bytecodes::length_for(this, bci)) {
+    const jubyte* const bcptr = codebase + bci;
+    if (local_index_of(bcptr, Bytecodes::_istore,
+                       Bytecodes::_istore_0) == index_local ||
+        local_index_of(bcptr, Bytecodes::_astore,
+                       Bytecodes::_astore_0) == array_local) {
+      return;
+    }
+    if (bcptr[0] == Bytecodes::_iinc && bcptr[1] == index_local &&
+        bci + 3 != cond) {
+      return;
+    }
+    if (bcptr[0] == Bytecodes::_wide && bcptr[1] == Bytecodes::_iinc &&
+        Bytes::get_Java_u2(address(bcptr+2)) == index_local) {
+      return;
+    }
+    last_bci = bci;
+  }
+  if (bci != cond || last_bci != cond - 3 ||
+      codebase[last_bci] != Bytecodes::_iinc ||
+      codebase[last_bci + 1] != index_local ||
+      jbyte(codebase[last_bci + 2]) != 1) {
+    return;
+  }
+
+  if (has_branch_into(body, end, goto_bci)) {
+    return;
+  }
+
+  // Mark "aload a; iload i; Xaload" and "aload a; iload i; <push>; Xastore"
+  // where no other path joins in the middle of the sequence.
+  int prev1 = -1, prev2 = -1, prev3 = -1;
+  for (bci = body; bci < cond; bci += Bytecodes::length_for(this, bci)) {
+    const int code = codebase[bci];
+    int array_bci = -1, index_bci = -1;
+    if (Bytecodes::_iaload <= code && code <= Bytecodes::_saload &&
+        prev2 >= 0 && entry_counts[prev1] == 1) {
+      array_bci = prev2;
+      index_bci = prev1;
+    } else if (Bytecodes::_iastore <= code && code <= Bytecodes::_sastore &&
+               prev3 >= 0 && entry_counts[prev2] == 1 &&
+               entry_counts[prev1] == 1 &&
+               codebase[prev1] >= Bytecodes::_aconst_null &&
+               codebase[prev1] <= Bytecodes::_aload_3) {
+      array_bci = prev3;
+      index_bci = prev2;
+    }
+    if (array_bci >= 0 && entry_counts[bci] == 1 &&
+        local_index_of(codebase + index_bci, Bytecodes::_iload,
+                       Bytecodes::_iload_0) == index_local &&
+        local_index_of(codebase + array_bci, Bytecodes::_aload,
+                       Bytecodes::_aload_0) == array_local) {
+      bci_flags[bci] |= bci_index_in_bounds;
+    }
+    prev3 = prev2;
+    prev2 = prev1;
+    prev1 = bci;
+  }
+}
+
+// Finds the counted loops whose index is initialized to a non-negative
+// constant right before the loop is entered, see mark_counted_loop().
+void Method::mark_counted_loops(const jubyte entry_counts[],
+                                jubyte bci_flags[]) const {
+  const jubyte* codebase = (jubyte*)code_base();
+  const int codesize = code_size();
+  int prev1 = -1, prev2 = -1;
+  for (int bci = 0; bci < codesize; bci += Bytecodes::length_for(this, bci)) {
+    if (codebase[bci] == Bytecodes::_goto && prev2 >= 0 &&
+        entry_counts[bci] == 1 && entry_counts[prev1] == 1) {
+      const int index_local = local_index_of(codebase + prev1,
+                                             Bytecodes::_istore,
+                                             Bytecodes::_istore_0);
+      const jubyte* const init = codebase + prev2;
+      const bool is_non_negative =
+          (Bytecodes::_iconst_0 <= init[0] && init[0] <= Bytecodes::_iconst_5)
+       || (init[0] == Bytecodes::_bipush && jbyte(init[1]) >= 0)
+       || (init[0] == Bytecodes::_sipush &&
+           jshort(Bytes::get_Java_u2(address(init+1))) >= 0);
+      if (index_local >= 0 && is_non_negative) {
+        mark_counted_loop(bci, index_local, entry_counts, bci_flags);
+      }
+    }
+    prev2 = prev1;
+    prev1 = bci;
+  }
+}
+
+// Counts the loads and stores of each of the first <max_locals> local
+// variables in the loop headed by <bci>, a bytecode flagged as
+// bci_loop_header: the bytecodes from <bci> to the first branch back to
+// it. Returns false if the loop invokes other methods -- every invocation
+// flushes the frame, so the locals cannot stay in registers anyway.
+bool Method::loop_local_uses(const int bci, jubyte uses[],
+                             const int max_locals) const {
+  const jubyte* codebase = (jubyte*)code_base();
+  const int codesize = code_size();
+
+  jvm_memset(uses, 0, max_locals);
+  for (int b = bci; b < codesize; b += Bytecodes::length_for(this, b)) {
+    const jubyte* const bcptr = codebase + b;
+    const Bytecodes::Code code = (Bytecodes::Code)bcptr[0];
+    int index;
+    switch (code) {
+      case Bytecodes::_ifeq:
+      case Bytecodes::_ifne:
+      case Bytecodes::_iflt:
+      case Bytecodes::_ifge:
+      case Bytecodes::_ifgt:
+      case Bytecodes::_ifle:
+      case Bytecodes::_if_icmpeq:
+      case Bytecodes::_if_icmpne:
+      case Bytecodes::_if_icmplt:
+      case Bytecodes::_if_icmpge:
+      case Bytecodes::_if_icmpgt:
+      case Bytecodes::_if_icmple:
+      case Bytecodes::_if_acmpeq:
+      case Bytecodes::_if_acmpne:
+      case Bytecodes::_ifnull:
+      case Bytecodes::_ifnonnull:
+      case Bytecodes::_goto:
+        if (b + jshort(Bytes::get_Java_u2(address(bcptr+1))) == bci) {
+          return true;
+        }
+        continue;
+      case Bytecodes::_goto_w:
+        if (b + int(Bytes::get_Java_u4(address(bcptr+1))) == bci) {
+          return true;
+        }
+        continue;
+      case Bytecodes::_invokevirtual:
+      case Bytecodes::_invokespecial:
+      case Bytecodes::_invokestatic:
+      case Bytecodes::_invokeinterface:
+      case Bytecodes::_fast_invokevirtual:
+      case Bytecodes::_fast_invokestatic:
+      case Bytecodes::_fast_init_invokestatic:
+      case Bytecodes::_fast_invokeinterface:
+      case Bytecodes::_fast_invokenative:
+      case Bytecodes::_fast_invokevirtual_final:
+      case Bytecodes::_fast_invokespecial:
+        return false;
+      case Bytecodes::_iinc:
+        index = bcptr[1];
+        break;
+      default:
+        if (code == Bytecodes::_wide && bcptr[1] == Bytecodes::_iinc) {
+          index = Bytes::get_Java_u2(address(bcptr+2));
+          break;
+        }
+        index = local_index_of(bcptr, Bytecodes::_iload, Bytecodes::_iload_0);
+        if (index < 0) {
+          index = local_index_of(bcptr, Bytecodes::_aload,
+                                 Bytecodes::_aload_0);
+        }
+        if (index < 0) {
+          index = local_index_of(bcptr, Bytecodes::_istore,
+                                 Bytecodes::_istore_0);
+        }
+        if (index < 0) {
+          index = local_index_of(bcptr, Bytecodes::_astore,
+                                 Bytecodes::_astore_0);
+        }
+    }
+    if (0 <= index && index < max_locals && uses[index] < 0xff) {
+      uses[index]++;
+    }
+  }
+  SHOULD_NOT_REACH_HERE();
+  return false;
+}
+
 void Method::compute_attributes(Attributes& attributes JVM_TRAPS) const {
   const int codesize = code_size();
 
@@ -2338,9 +2669,11 @@ void Method::compute_attributes(Attributes& attributes JVM_TRAPS) const {
             // Fall through
           case Bytecodes::_goto: {
             ADD_BACK_BRANCH_ENTRY(jshort(Bytes::get_Java_u2(address(bcptr+1))));
+            MARK_LOOP_HEADER;
           } break;
           case Bytecodes::_goto_w: {
             ADD_BACK_BRANCH_ENTRY(int(Bytes::get_Java_u4(address(bcptr+1))));
+            MARK_LOOP_HEADER;
           } break;
           case Bytecodes::_lookupswitch: {
             const int table_index  = align_size_up(bci + 1, sizeof(jint));
@@ -2412,11 +2745,16 @@ void Method::compute_attributes(Attributes& attributes JVM_TRAPS) const {
         add_entry(entry_counts, handler_bci, 2);
       }
     }
+
+    if (attributes.has_loops && EliminateLoopArrayChecks) {
+      mark_counted_loops(entry_counts, bci_flags);
+    }
   }
 }
 
 #undef ADD_BRANCH_ENTRY
 #undef ADD_BACK_BRANCH_ENTRY
+#undef MARK_LOOP_HEADER
 #endif
 
 bool Method::is_impossible_to_compile() const {
@@ -599,6 +599,13 @@ public:
 #if USE_COMPILER_STRUCTURES
  private:
   static void add_entry(jubyte counts[], const int bci, const int inc=1);
+  bool has_branch_into(const int start, const int end,
+                       const int allowed_branch_bci) const;
+  void mark_counted_loop(const int goto_bci, const int index_local,
+                         const jubyte entry_counts[],
+                         jubyte bci_flags[]) const;
+  void mark_counted_loops(const jubyte entry_counts[],
+                          jubyte bci_flags[]) const;
  public:
 
   struct Attributes : public StackObj {
@@ -615,11 +622,18 @@ public:
   // Bytecode attributes
   enum {
     bci_exception_has_osr_entry = 1,
-    bci_branch_taken = 1 << 1
+    bci_branch_taken = 1 << 1,
+    bci_index_in_bounds = 1 << 2,
+    bci_loop_header = 1 << 3
   };
 
   // Computes method attributes used by compiler and romizer.
   void compute_attributes(Attributes& attributes JVM_TRAPS) const;
+
+  // Counts the local variable accesses in the loop headed by <bci>, which
+  // must be flagged as bci_loop_header.
+  bool loop_local_uses(const int bci, jubyte uses[],
+                       const int max_locals) const;
 #endif
 
 #if ENABLE_COMPILER && ENABLE_INLINE
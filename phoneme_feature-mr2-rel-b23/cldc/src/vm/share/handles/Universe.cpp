@@ -1270,6 +1270,9 @@ void Universe::apocalypse() {
   Scheduler::dispose();  
   Thread::dispose();   
   JarFileParser::flush_caches();
+#if USE_JAR_ENTRY_MAPPING
+  JarFileParser::unmap_files();
+#endif
   ROM::dispose_binary_images();
 
   jvm_memset(persistent_handles, 0, sizeof(persistent_handles));
@@ -2187,6 +2190,12 @@ void Universe::update_relative_pointers() {
   _mirror_list_base += ObjArray::base_offset();
 #endif
   _interned_string_near_addr = interned_string_near()->obj();
+
+#if ENABLE_C_INTERPRETER
+  // Objects have moved or the class list has changed, so the cached
+  // ClassInfo and Method pointers may be stale
+  interpreter_flush_interface_call_cache();
+#endif
 }
 
 #if ENABLE_ISOLATES
@@ -955,6 +955,18 @@ extern "C" {
 
     CompiledMethod::Raw trapper = frame.compiled_method();
     CompiledMethod::Raw method_code;
+#if ENABLE_TYPE_PROFILE
+    {
+      // A trap at a resolved virtual or interface call comes from a failed
+      // guard of a guarded direct call.
+      const jint bci = frame.bci();
+      const Bytecodes::Code code = method().bytecode_at(bci);
+      if (code == Bytecodes::_fast_invokevirtual ||
+          code == Bytecodes::_fast_invokeinterface) {
+        Compiler::on_call_site_guard_failure(&method, bci);
+      }
+    }
+#endif
     frame.deoptimize();
     // Unlink the compiled code.
     if (method().has_compiled_code()) {
@@ -618,4 +618,331 @@ void CompiledMethodCache::cleanup_unmarked( void ) {
 
 #undef weights
 
+#if ENABLE_COMPILATION_PROFILE
+// Layout of the profile file, in native byte order (it is only read back
+// by the same VM build):
+//
+//   ProfileHeader
+//   ProfileRecord, followed by the bytes of the class name, the method
+//   name and the method signature, padded to a word boundary
+//   ...
+//
+// The key identifies the contents of the application and the VM: it is a
+// hash of the VM version, the number of classes in the system ROM image
+// and the length and central directory of every classpath JAR, which
+// holds the CRC-32 of each entry. For a classpath entry that is not a JAR
+// file, the name of the entry is hashed instead. A profile with another
+// key is ignored and overwritten at exit.
+//
+// Each classpath gets its own file, named after a hash of the classpath
+// string, in the directory given with -compileprofiledir. Without that
+// option the profile is not used.
+
+struct ProfileHeader {
+  juint magic;
+  juint key;
+  juint count;
+  juint size;   // Total size of the records in bytes
+};
+
+struct ProfileRecord {
+  juint   class_hash;
+  jushort class_name_length;
+  jushort name_length;
+  jushort signature_length;
+  jushort reserved;
+
+  const char* class_name( void ) const { return (const char*) (this + 1); }
+  const char* name      ( void ) const {
+    return class_name() + class_name_length;
+  }
+  const char* signature ( void ) const { return name() + name_length; }
+
+  size_t size( void ) const {
+    return align_size_up( sizeof(ProfileRecord) + class_name_length +
+                          name_length + signature_length, BytesPerWord );
+  }
+};
+
+enum { ProfileMagic = 0xCC0DEF11 };
+
+static ProfileRecord* _profile_records;
+static ProfileRecord* _profile_records_end;
+
+static juint profile_hash( const char* p, int length ) {
+  juint h = 0;
+  for( ; --length >= 0; p++ ) {
+    h = 31 * h + jubyte(*p);
+  }
+  return h;
+}
+
+static void profile_key_proc( const jubyte* data, int length, void* param ) {
+  juint* key = (juint*) param;
+  for( ; --length >= 0; data++ ) {
+    *key = 31 * *key + *data;
+  }
+}
+
+static juint profile_key( const JvmPathChar* classpath ) {
+  juint key = ROM::number_of_system_classes();
+  profile_key_proc( (const jubyte*) JVM_RELEASE_VERSION,
+                    jvm_strlen( JVM_RELEASE_VERSION ), &key );
+  profile_key_proc( (const jubyte*) JVM_BUILD_VERSION,
+                    jvm_strlen( JVM_BUILD_VERSION ), &key );
+
+  int length = 0;
+  while( classpath[length] != 0 ) {
+    length++;
+  }
+  JvmPathChar* entry =
+    (JvmPathChar*) OsMemory_allocate( (length + 1) * sizeof(JvmPathChar) );
+  if( entry == NULL ) {
+    return 0;
+  }
+  while( *classpath != 0 ) {
+    JvmPathChar* p = entry;
+    while( *classpath != 0 && *classpath != OsFile_path_separator_char ) {
+      *p++ = *classpath++;
+    }
+    *p = 0;
+    if( *classpath != 0 ) {
+      classpath++;
+    }
+
+    OsFile_Handle file = OsFile_open( entry, "rb" );
+    if( file != NULL &&
+        JarFileParser::central_directory_do( file, profile_key_proc, &key ) ) {
+      key = 31 * key + juint(OsFile_length( file ));
+    } else {
+      for( p = entry; *p; p++ ) {
+        key = 31 * key + juint(*p);
+      }
+    }
+    if( file != NULL ) {
+      OsFile_close( file );
+    }
+  }
+  OsMemory_free( entry );
+  return key;
+}
+
+// Returns the name of the profile file of the given classpath, allocated
+// with OsMemory_allocate, or NULL if no profile directory is given.
+static JvmPathChar* profile_file_name( const JvmPathChar* classpath ) {
+  const JvmPathChar* dir = Arguments::compilation_profile_dir();
+  if( dir == NULL || classpath == NULL ) {
+    return NULL;
+  }
+
+  juint hash = 0;
+  for( const JvmPathChar* p = classpath; *p; p++ ) {
+    hash = 31 * hash + juint(*p);
+  }
+  char base[] = "cldc_compile_00000000.prf";
+  static const char hex[] = "0123456789abcdef";
+  for( int i = 0; i < 8; i++ ) {
+    base[20 - i] = hex[(hash >> (4 * i)) & 0xf];
+  }
+
+  int dir_length = 0;
+  while( dir[dir_length] != 0 ) {
+    dir_length++;
+  }
+  const int base_length = sizeof base - 1;
+  JvmPathChar* name = (JvmPathChar*)
+    OsMemory_allocate( (dir_length + base_length + 2) * sizeof(JvmPathChar) );
+  if( name == NULL ) {
+    return NULL;
+  }
+  JvmPathChar* p = name;
+  for( int i = 0; i < dir_length; i++ ) {
+    *p++ = dir[i];
+  }
+  if( dir_length > 0 && dir[dir_length - 1] != OsFile_separator_char ) {
+    *p++ = OsFile_separator_char;
+  }
+  for( int i = 0; i < base_length; i++ ) {
+    *p++ = (JvmPathChar) base[i];
+  }
+  *p = 0;
+  return name;
+}
+
+static inline bool profile_matches( const Symbol* symbol, const char* bytes,
+                                    const int length ) {
+  return symbol->length() == length &&
+         jvm_memcmp( symbol->base_address(), bytes, length ) == 0;
+}
+
+static inline void profile_write_symbol( OsFile_Handle file,
+                                         const Symbol* symbol ) {
+  OsFile_write( file, symbol->base_address(), 1, symbol->length() );
+}
+
+static void profile_dispose( void ) {
+  if( _profile_records != NULL ) {
+    OsMemory_free( _profile_records );
+    _profile_records = NULL;
+    _profile_records_end = NULL;
+  }
+}
+
+void CompiledMethodCache::load_profile( void ) {
+  profile_dispose();
+  if( !UseCompilationProfile || !UseCompiler || !MixedMode ) {
+    return;
+  }
+
+  const JvmPathChar* classpath = Arguments::classpath();
+  JvmPathChar* name = profile_file_name( classpath );
+  if( name == NULL ) {
+    return;
+  }
+  OsFile_Handle file = OsFile_open( name, "rb" );
+  OsMemory_free( name );
+  if( file == NULL ) {
+    return;
+  }
+  ProfileHeader header;
+  if( OsFile_read( file, &header, sizeof header, 1 ) == 1 &&
+      header.magic == juint(ProfileMagic) &&
+      header.key == profile_key( classpath ) &&
+      header.size != 0 ) {
+    ProfileRecord* records = (ProfileRecord*)OsMemory_allocate( header.size );
+    if( records != NULL ) {
+      if( OsFile_read( file, records, 1, header.size ) == header.size ) {
+        _profile_records = records;
+        _profile_records_end = DERIVED( ProfileRecord*, records, header.size );
+      } else {
+        OsMemory_free( records );
+      }
+    }
+  }
+  OsFile_close( file );
+
+  // Discard a truncated or otherwise damaged profile
+  {
+    const ProfileRecord* p = _profile_records;
+    const ProfileRecord* const end = _profile_records_end;
+    while( p < end && DISTANCE( p, end ) >= int(sizeof(ProfileRecord)) &&
+           DISTANCE( p, end ) >= int(p->size()) ) {
+      p = DERIVED( const ProfileRecord*, p, p->size() );
+    }
+    if( p != end ) {
+      profile_dispose();
+      return;
+    }
+  }
+
+  // The system classes are already loaded
+  const int number_of_classes = Universe::number_of_java_classes();
+  for( int class_id = 0; class_id < number_of_classes; class_id++ ) {
+    JavaClass::Raw klass = Universe::class_from_id_or_null( class_id );
+    if( klass.not_null() && klass().is_instance_class() ) {
+      InstanceClass::Raw ic = klass.obj();
+      apply_profile( &ic );
+    }
+  }
+}
+
+void CompiledMethodCache::apply_profile( InstanceClass* klass ) {
+  if( _profile_records == NULL || klass->is_fake_class() ) {
+    return;
+  }
+
+  Symbol::Raw class_name = klass->name();
+  const juint class_hash =
+    profile_hash( class_name().base_address(), class_name().length() );
+  ObjArray::Raw methods = klass->methods();
+
+  const ProfileRecord* const end = _profile_records_end;
+  for( const ProfileRecord* p = _profile_records; p < end;
+       p = DERIVED( const ProfileRecord*, p, p->size() ) ) {
+    if( p->class_hash != class_hash ||
+        !profile_matches( &class_name, p->class_name(),
+                          p->class_name_length ) ) {
+      continue;
+    }
+    for( int i = methods().length(); --i >= 0; ) {
+      Method::Raw m = methods().obj_at( i );
+      Symbol::Raw name = m().name();
+      Symbol::Raw signature = m().signature();
+      if( profile_matches( &name, p->name(), p->name_length ) &&
+          profile_matches( &signature, p->signature(),
+                           p->signature_length ) ) {
+        if( m().can_be_compiled() && !m().is_native() &&
+            !m().is_abstract() ) {
+          m().set_execution_entry( (address) shared_invoke_compiler );
+        }
+        break;
+      }
+    }
+  }
+}
+
+void CompiledMethodCache::save_profile( void ) {
+  profile_dispose();
+  if( !UseCompilationProfile || !UseCompiler || !MixedMode ) {
+    return;
+  }
+
+  const JvmPathChar* classpath = Arguments::classpath();
+  JvmPathChar* name = profile_file_name( classpath );
+  if( name == NULL ) {
+    return;
+  }
+  OsFile_Handle file = OsFile_open( name, "wb" );
+  OsMemory_free( name );
+  if( file == NULL ) {
+    return;
+  }
+
+  ProfileHeader header;
+  header.magic = ProfileMagic;
+  header.key   = profile_key( classpath );
+  header.count = 0;
+  header.size  = 0;
+  OsFile_write( file, &header, sizeof header, 1 );
+
+  static const char padding[BytesPerWord] = {0};
+  for( int i = 0; i <= upb; i++ ) {
+    Method::Raw m = Map[ i ]->method();
+    InstanceClass::Raw klass = m().holder();
+    Symbol::Raw class_name = klass().name();
+    Symbol::Raw name = m().name();
+    Symbol::Raw signature = m().signature();
+
+    ProfileRecord record;
+    record.class_hash =
+      profile_hash( class_name().base_address(), class_name().length() );
+    record.class_name_length = class_name().length();
+    record.name_length       = name().length();
+    record.signature_length  = signature().length();
+    record.reserved          = 0;
+
+    const size_t size = record.size();
+    OsFile_write( file, &record, sizeof record, 1 );
+    profile_write_symbol( file, &class_name );
+    profile_write_symbol( file, &name );
+    profile_write_symbol( file, &signature );
+    OsFile_write( file, padding, 1, size - sizeof(ProfileRecord) -
+                  record.class_name_length - record.name_length -
+                  record.signature_length );
+
+    header.count++;
+    header.size += size;
+  }
+
+  OsFile_seek( file, 0L, SEEK_SET );
+  OsFile_write( file, &header, sizeof header, 1 );
+  OsFile_close( file );
+
+  if( TraceCompiledMethodCache ) {
+    TTY_TRACE_CR(( "CompiledMethodCache: saved %d methods to the profile",
+                   header.count ));
+  }
+}
+#endif // ENABLE_COMPILATION_PROFILE
+
 #endif //ENABLE_COMPILER
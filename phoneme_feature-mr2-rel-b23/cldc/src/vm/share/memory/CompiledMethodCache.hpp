@@ -29,6 +29,7 @@
  */
 
 class CompiledMethodDesc;
+class InstanceClass;
 
 class CompiledMethodCache {
 public:
@@ -82,6 +83,15 @@ public:
 #ifndef PRODUCT
   static void dump( void );
 #endif
+
+#if ENABLE_COMPILATION_PROFILE
+  // The compilation profile lists the methods that were compiled when the
+  // previous run of the same application exited. Listed methods are set
+  // to be compiled on their first invocation when their class is loaded.
+  static void load_profile  ( void );
+  static void save_profile  ( void );
+  static void apply_profile ( InstanceClass* klass );
+#endif
 //private:      // ADS compiler does not like private datatypes
   typedef unsigned char Byte;   // The shortest fast native integer
   typedef unsigned long DWord;  // The longest of the fast aligned integer types
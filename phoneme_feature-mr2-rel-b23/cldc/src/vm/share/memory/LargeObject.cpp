@@ -340,7 +340,11 @@ void LargeObject::move ( const int delta, const LargeObject limit[] ) {
     return;
   }
 
-  must_be_aligned( delta );  
+  must_be_aligned( delta );
+#if ENABLE_C_INTERPRETER
+  // Classes and methods of a binary image may be moving
+  interpreter_flush_interface_call_cache();
+#endif  
 
   const LargeObject* const src = bottom();
   if( src == limit ) {
@@ -367,7 +371,11 @@ void LargeObject::move ( const int delta, const LargeObject limit[] ) {
     return;
   }
 
-  must_be_aligned( delta );  
+  must_be_aligned( delta );
+#if ENABLE_C_INTERPRETER
+  // Classes and methods of a binary image may be moving
+  interpreter_flush_interface_call_cache();
+#endif  
   const LargeObject* const src = bottom();
   if( src == limit ) {
     set_bottom( DERIVED( LargeObject*, src, delta ) );
@@ -77,6 +77,15 @@ void ObjectHeap::update_compiler_area_top_fast() {
 
 #define CACHE_QUICK_VAR(v) _quick_vars.v = _ ## v
 
+#if ENABLE_PERFORMANCE_COUNTERS
+#define GC_PHASE_BEGIN(start)        start = Os::elapsed_counter()
+#define GC_PHASE_END(counter, start) \
+  jvm_perf_count.counter += Os::elapsed_counter() - start
+#else
+#define GC_PHASE_BEGIN(start)
+#define GC_PHASE_END(counter, start)
+#endif
+
 /*
  * This code is ugly, but we save more than 10% of full GC time by 
  * in-lining write_barrier_oops_do() calls (so that local variables
@@ -338,6 +347,34 @@ int ObjectHeap::available_for_current_task() {
   return available;
 }
 
+// The objects above the topmost boundary belong to _previous_task_id.
+// When another task is switched in, its allocation buffer starts with
+// a new boundary at the top of the heap. Doing this here rather than in
+// allocate() lets the interpreter and the compiled allocation stubs keep
+// allocating inline right after the switch; the buffer is charged to the
+// task by accumulate_current_task_memory_usage() like any inline
+// allocation. If nothing was allocated above the topmost boundary, the
+// empty range is simply handed over to the new task.
+//
+// Returns NULL if there is no room for the boundary, in which case the
+// allocation trap stays armed and allocate() takes care of the rest.
+OopDesc** ObjectHeap::open_task_allocation_buffer( const int task_id ) {
+  OopDesc** const inline_top = _inline_allocation_top;
+  OopDesc** const allocation_end = current_task_allocation_end();
+
+  const BoundaryDesc* const top_boundary = *get_boundary_list();
+  if( top_boundary == NULL || (OopDesc**)(top_boundary + 1) != inline_top ) {
+    if( DISTANCE( inline_top, allocation_end ) < int(sizeof(BoundaryDesc)) ) {
+      return NULL;
+    }
+    create_boundary( inline_top, _previous_task_id );
+    _inline_allocation_top = inline_top + sizeof(BoundaryDesc)/BytesPerWord;
+  }
+  _previous_task_id = task_id;
+  PERFORMANCE_COUNTER_INCREMENT(num_of_task_allocation_buffers, 1);
+  return allocation_end;
+}
+
 int ObjectHeap::on_task_switch ( const int task_id ) {
   GUARANTEE( unsigned(task_id) < unsigned(MAX_TASKS), "Invalid task id" );
   GUARANTEE( !_is_gc_active, "No task switching allowed during GC" );
@@ -347,8 +384,13 @@ int ObjectHeap::on_task_switch ( const int task_id ) {
   const int current_task_id = _current_task_id;
   _current_task_id = task_id;
 
-  _inline_allocation_end = _previous_task_id != task_id ? NULL :
-    current_task_allocation_end();
+  OopDesc** allocation_end = NULL;
+  if( _previous_task_id == task_id ) {
+    allocation_end = current_task_allocation_end();
+  } else if( TaskAllocationBuffers ) {
+    allocation_end = open_task_allocation_buffer( task_id );
+  }
+  _inline_allocation_end = allocation_end;
 
   return current_task_id;
 }
@@ -692,6 +734,19 @@ void ObjectHeap::finalize( FinalizerConsDesc** list ) {
   }
 }
 
+#if ENABLE_INCREMENTAL_MARKING
+OopDesc** ObjectHeap::_incremental_marking_start;
+OopDesc** ObjectHeap::_incremental_marking_end;
+int       ObjectHeap::_incremental_bitmap_words;
+juint*    ObjectHeap::_incremental_marks;
+juint*    ObjectHeap::_incremental_dirty_bits;
+OopDesc** ObjectHeap::_incremental_marking_stack_start;
+OopDesc** ObjectHeap::_incremental_marking_stack_top;
+OopDesc** ObjectHeap::_incremental_marking_stack_end;
+bool      ObjectHeap::_incremental_marking_failed;
+bool      ObjectHeap::_incremental_marks_installed;
+#endif
+
 #if ENABLE_PERFORMANCE_COUNTERS || ENABLE_TTY_TRACE
 jlong     ObjectHeap::_internal_collect_start_time;
 size_t    ObjectHeap::_old_gen_size_before;
@@ -1084,6 +1139,12 @@ bool ObjectHeap::expand_current_compiled_method(int delta) {
 #endif
 
 void ObjectHeap::dispose() {
+#if ENABLE_PARALLEL_GC
+  OsMisc_parallel_dispose();
+#endif
+#if ENABLE_INCREMENTAL_MARKING
+  incremental_marking_reset();
+#endif
   _inline_allocation_top = NULL;
   set_inline_allocation_end(NULL);
   _bitvector_base        = NULL;
@@ -1350,6 +1411,12 @@ bool ObjectHeap::create() {
   }
 #endif
 
+#if ENABLE_PARALLEL_GC
+  if (ParallelGCThreads > 1) {
+    OsMisc_parallel_initialize(ParallelGCThreads);
+  }
+#endif
+
   return true;
 }
 
@@ -1614,6 +1681,11 @@ inline void ObjectHeap::set_collection_area_boundary_no_reuse(
 
   _young_generation_start = _collection_area_start;
   verify_layout();
+#if ENABLE_INCREMENTAL_MARKING
+  if (_incremental_marking_end != NULL) {
+    incremental_marking_save_dirty_bits();
+  }
+#endif
   // Clear entire bitvector
   clear_bit_range(_heap_start, _old_generation_end);
 #ifdef PRODUCT
@@ -1813,6 +1885,242 @@ void ObjectHeap::roots_do_to( void do_oop(OopDesc**), const bool young_only,
 #endif
 }
 
+#if ENABLE_INCREMENTAL_MARKING
+// Incremental marking of the old generation.
+//
+// A cycle starts at the end of a young collection, when the old generation
+// has grown above IncrementalMarkingStartPercentage of the heap. The
+// objects in [_heap_start, _incremental_marking_end) -- the old generation
+// at that time -- are then marked in steps at the end of this and the
+// following young collections. A step ends when the pause of its young
+// collection reaches GCPauseTargetMillis.
+// The steps run while the collector is still active: objects in this area
+// do not move and the thread stacks are in GC state. The marks are kept
+// outside the bitvector, which every collection clears.
+//
+// A pointer can be stored into an object after the object has been
+// scanned. Such stores set the object's bits in the bitvector: the
+// interpreters and compiled code do it for all stores into the old
+// generation, and oop_write_barrier() does it for stores of lower
+// addresses during a cycle. These bits are saved in _incremental_dirty_bits
+// before anything clears them.
+//
+// The next full collection finishes the marking, copies the marks into
+// the bitvector and marks from the roots as usual. Marked objects are not
+// scanned again, except those with dirty bits and the execution stacks
+// (these are written without a write barrier). Objects allocated or
+// promoted during the cycle are above _incremental_marking_end and are
+// marked as usual. Objects that died after being marked are only
+// reclaimed by the following full collection.
+
+void ObjectHeap::incremental_mark_and_push(OopDesc** p) {
+  OopDesc** const obj = (OopDesc**) *p;
+  if (_heap_start <= obj && obj < _incremental_marking_end &&
+      !test_and_set_bit_for(obj, incremental_bitmap_base(_incremental_marks))){
+    if (_incremental_marking_stack_top == _incremental_marking_stack_end) {
+      const int size = DISTANCE(_incremental_marking_stack_start,
+                                _incremental_marking_stack_end);
+      OopDesc** stack = (OopDesc**) OsMemory_allocate(size * 2);
+      if (stack == NULL) {
+        // Give up this cycle, see incremental_marking_after_young_collect()
+        _incremental_marking_failed = true;
+        return;
+      }
+      jvm_memcpy(stack, _incremental_marking_stack_start, size);
+      OsMemory_free(_incremental_marking_stack_start);
+      _incremental_marking_stack_start = stack;
+      _incremental_marking_stack_top   = DERIVED(OopDesc**, stack, size);
+      _incremental_marking_stack_end   = DERIVED(OopDesc**, stack, size * 2);
+    }
+    *_incremental_marking_stack_top++ = (OopDesc*)obj;
+  }
+}
+
+void ObjectHeap::incremental_marking_start(void) {
+  GUARANTEE(_incremental_marking_end == NULL, "sanity");
+
+  OopDesc** const start = align_down(_heap_start);
+  const int bitmap_bytes = DISTANCE(start, align_up(_old_generation_end))
+                               >> (LogBytesPerWord + LogBitsPerByte);
+  const int stack_bytes = 1024 * sizeof(OopDesc*);
+
+  juint* marks = (juint*) OsMemory_allocate(bitmap_bytes);
+  juint* dirty_bits = (juint*) OsMemory_allocate(bitmap_bytes);
+  OopDesc** stack = (OopDesc**) OsMemory_allocate(stack_bytes);
+  if (marks == NULL || dirty_bits == NULL || stack == NULL) {
+    if (marks != NULL) {
+      OsMemory_free(marks);
+    }
+    if (dirty_bits != NULL) {
+      OsMemory_free(dirty_bits);
+    }
+    if (stack != NULL) {
+      OsMemory_free(stack);
+    }
+    return;
+  }
+
+  jvm_memset(marks, 0, bitmap_bytes);
+  // The bits now set in the old generation record pointers to the young
+  // generation, which is above _incremental_marking_end. Treat them as dirty.
+  jvm_memcpy(dirty_bits, get_bitvectorword_for_aligned(start), bitmap_bytes);
+
+  _incremental_marking_start       = start;
+  _incremental_marking_end         = _old_generation_end;
+  _incremental_bitmap_words        = bitmap_bytes / sizeof(juint);
+  _incremental_marks               = marks;
+  _incremental_dirty_bits          = dirty_bits;
+  _incremental_marking_stack_start = stack;
+  _incremental_marking_stack_top   = stack;
+  _incremental_marking_stack_end   = DERIVED(OopDesc**, stack, stack_bytes);
+  _incremental_marking_failed      = false;
+
+  if (VerboseGC || TraceGC) {
+    TTY_TRACE_CR(("Incremental marking of 0x%x-0x%x",
+                  _heap_start, _incremental_marking_end));
+  }
+
+  roots_do(incremental_mark_and_push);
+  ROM::oops_do(incremental_mark_and_push, true, false);
+  global_refs_do(incremental_mark_and_push, STRONG);
+}
+
+void ObjectHeap::incremental_marking_step(const jlong deadline) {
+  int count = 0;
+  while (_incremental_marking_stack_top > _incremental_marking_stack_start
+         && !_incremental_marking_failed) {
+    OopDesc* obj = *--_incremental_marking_stack_top;
+    FarClassDesc* const blueprint = obj->blueprint();
+    incremental_mark_and_push(&(obj->_klass));
+    if (!blueprint->instance_is_execution_stack()) {
+      obj->oops_do_for(blueprint, incremental_mark_and_push);
+    }
+    // Check the clock every 1024 objects, so each step makes some progress
+    if ((++count & 0x3ff) == 0 && deadline != 0 &&
+        Os::java_time_millis() >= deadline) {
+      break;
+    }
+  }
+}
+
+void
+ObjectHeap::incremental_marking_after_young_collect(const jlong deadline) {
+  if (_incremental_marking_end == NULL) {
+    if (!IncrementalMarking || GenerateROMImage || _debugger_active ||
+        (size_t)DISTANCE(_heap_start, _old_generation_end) <
+            _heap_size / 100 * IncrementalMarkingStartPercentage) {
+      return;
+    }
+    incremental_marking_start();
+    if (_incremental_marking_end == NULL) {
+      return;
+    }
+  }
+  if (_incremental_marking_stack_top > _incremental_marking_stack_start) {
+    incremental_marking_step(deadline);
+    PERFORMANCE_COUNTER_INCREMENT(num_of_incremental_marking_steps, 1);
+  }
+  if (_incremental_marking_failed) {
+    incremental_marking_reset();
+  }
+}
+
+void ObjectHeap::incremental_marking_save_dirty_bits(void) {
+  const juint* bitvector_words =
+      get_bitvectorword_for_aligned(_incremental_marking_start);
+  juint* dirty_bits = _incremental_dirty_bits;
+  for (int i = _incremental_bitmap_words; --i >= 0; ) {
+    dirty_bits[i] |= bitvector_words[i];
+  }
+}
+
+void ObjectHeap::incremental_marking_install_marks(void) {
+#if ENABLE_ISOLATES
+  if (_some_tasks_terminated) {
+    // Objects of the terminated tasks must not survive this collection
+    _incremental_marking_failed = true;
+  }
+#endif
+  incremental_marking_step(0);
+  if (_incremental_marking_failed) {
+    incremental_marking_reset();
+    return;
+  }
+  const juint* marks = _incremental_marks;
+  juint* bitvector_words =
+      get_bitvectorword_for_aligned(_incremental_marking_start);
+  for (int i = _incremental_bitmap_words; --i >= 0; ) {
+    bitvector_words[i] |= marks[i];
+  }
+  _incremental_marks_installed = true;
+  PERFORMANCE_COUNTER_INCREMENT(num_of_incremental_full_gc, 1);
+}
+
+// Scan again each marked object that contains a dirty bit, and each
+// marked execution stack.
+void ObjectHeap::incremental_marking_rescan_dirty_objects(void) {
+  address const dirty_base = incremental_bitmap_base(_incremental_dirty_bits);
+  for (ExecutionStackDesc* stack = ExecutionStackDesc::_stack_list;
+       stack != NULL; stack = stack->_next_stack) {
+    OopDesc** const p = (OopDesc**)stack;
+    if (_incremental_marking_start <= p && p < _incremental_marking_end) {
+      set_bit_for(p, dirty_base);
+    }
+  }
+
+  const juint* marks = _incremental_marks;
+  const juint* dirty_bits = _incremental_dirty_bits;
+  OopDesc** object = NULL;      // the last marked object seen
+  OopDesc** object_end = NULL;  // computed when needed
+  bool rescanned = false;
+  for (int i = 0; i < _incremental_bitmap_words; i++) {
+    const juint mark_word = marks[i];
+    const juint dirty_word = dirty_bits[i];
+    juint bits = mark_word | dirty_word;
+    OopDesc** const p = _incremental_marking_start + i * BitsPerWord;
+    for (int bit = 0; bits != 0; bit++, bits >>= 1) {
+      if ((bits & 1) == 0) {
+        continue;
+      }
+      const juint mask = 1 << bit;
+      if (mark_word & mask) {
+        object = p + bit;
+        object_end = NULL;
+        rescanned = false;
+      }
+      if ((dirty_word & mask) && object != NULL && !rescanned) {
+        if (object_end == NULL) {
+          object_end = DERIVED(OopDesc**, object,
+                               ((OopDesc*)object)->object_size());
+        }
+        if (p + bit < object_end) {
+          mark_and_stack_root_and_interior_pointers(object);
+          rescanned = true;
+        }
+      }
+    }
+  }
+}
+
+void ObjectHeap::incremental_marking_reset(void) {
+  if (_incremental_marks != NULL) {
+    OsMemory_free(_incremental_marks);
+    OsMemory_free(_incremental_dirty_bits);
+    OsMemory_free(_incremental_marking_stack_start);
+  }
+  _incremental_marking_start       = NULL;
+  _incremental_marking_end         = NULL;
+  _incremental_bitmap_words        = 0;
+  _incremental_marks               = NULL;
+  _incremental_dirty_bits          = NULL;
+  _incremental_marking_stack_start = NULL;
+  _incremental_marking_stack_top   = NULL;
+  _incremental_marking_stack_end   = NULL;
+  _incremental_marking_failed      = false;
+  _incremental_marks_installed     = false;
+}
+#endif // ENABLE_INCREMENTAL_MARKING
+
 inline void ObjectHeap::mark_objects( const bool is_full_collect ) {
 #if ENABLE_COMPILER
   int upb = CompiledMethodCache::upb;
@@ -1836,6 +2144,12 @@ inline void ObjectHeap::mark_objects( const bool is_full_collect ) {
   }
 #endif
 
+#if ENABLE_INCREMENTAL_MARKING
+  if( is_full_collect && _incremental_marking_end != NULL ) {
+    incremental_marking_install_marks();
+  }
+#endif
+
   // Mark roots
   roots_do_to( mark_root_and_stack, !is_full_collect, upb );
 
@@ -1849,6 +2163,14 @@ inline void ObjectHeap::mark_objects( const bool is_full_collect ) {
   // Mark global references
   global_refs_do(mark_root_and_stack, STRONG);
 
+#if ENABLE_INCREMENTAL_MARKING
+  if( _incremental_marks_installed ) {
+    // Follow the pointers stored into incrementally marked objects
+    incremental_marking_rescan_dirty_objects();
+    incremental_marking_reset();
+  }
+#endif
+
   // All non-finalizer-reachable roots are marked, handle potential marking
   // stack overflow
   check_marking_stack_overflow();
@@ -2351,18 +2673,16 @@ inline void ObjectHeap::update_object_pointers() {
   // (3) Update interior object pointers (near pointers unchanged yet)
   // Execution stacks in compaction space have already been handled.
   if( is_full_collect ) {
-    write_barrier_oops_update_moving_object_interior_pointers(
-                          compaction_start, old_generation_end);
+    update_moving_object_interior_pointers(compaction_start,
+                                           old_generation_end);
     OopDesc** start = young_generation_start;
     if (start < end_fixed_objects) {
       start = end_fixed_objects;
     }
-    write_barrier_oops_update_moving_object_interior_pointers(
-                          start, inline_allocation_top);
+    update_moving_object_interior_pointers(start, inline_allocation_top);
   } else {
-    write_barrier_oops_update_moving_object_interior_pointers(
-                          compaction_start,
-                          inline_allocation_top);
+    update_moving_object_interior_pointers(compaction_start,
+                                           inline_allocation_top);
   }
 
   // _end_fixed_objects == compaction_start always,
@@ -2471,6 +2791,58 @@ void ObjectHeap::write_barrier_oops_update_moving_object_interior_pointers(
   WRITE_BARRIER_OOPS_LOOP_END;
 }
 
+#if ENABLE_PARALLEL_GC
+// IMPL_NOTE: only this pass runs in parallel. Parallel marking needs
+// atomic updates of the bitvector, which the write barrier shares, a
+// marking stack per thread with work stealing in place of the single
+// stack and its overflow rescans, and root callbacks that are safe to
+// call from helper threads. Compaction could move each slice on its own
+// thread once destinations are computed per slice, so that no slice is
+// moved over live objects of a slice that has not been moved yet.
+struct ParallelUpdateRange {
+  OopDesc** start;
+  OopDesc** end;
+  int count;
+};
+
+// Each moving object only has its own interior pointers updated, and the
+// destinations are read from encoded near pointers, which do not change
+// until step (4) of update_object_pointers(). So disjoint sub-ranges can
+// be updated concurrently.
+void ObjectHeap::parallel_update_moving_object_interior_pointers(int index,
+                                                                 void* param) {
+  const ParallelUpdateRange* range = (const ParallelUpdateRange*)param;
+  const size_t chunk =
+      align_size_up(DISTANCE(range->start, range->end) / range->count,
+                    BitsPerWord * BytesPerWord);
+  OopDesc** start = DERIVED(OopDesc**, range->start, chunk * index);
+  OopDesc** end   = DERIVED(OopDesc**, start, chunk);
+  if (end > range->end || index == range->count - 1) {
+    end = range->end;
+  }
+  if (start < end) {
+    write_barrier_oops_update_moving_object_interior_pointers(start, end);
+  }
+}
+#endif
+
+inline void ObjectHeap::update_moving_object_interior_pointers(
+                               OopDesc** start, OopDesc** end) {
+#if ENABLE_PARALLEL_GC
+  if (ParallelGCThreads > 1 && !TraceGC &&
+      start < end && (int)DISTANCE(start, end) >= ParallelGCMinBytes) {
+    ParallelUpdateRange range;
+    range.start = start;
+    range.end   = end;
+    range.count = ParallelGCThreads > 16 ? 16 : ParallelGCThreads;
+    OsMisc_parallel_do(parallel_update_moving_object_interior_pointers,
+                       &range, range.count);
+    return;
+  }
+#endif
+  write_barrier_oops_update_moving_object_interior_pointers(start, end);
+}
+
 void ObjectHeap::write_barrier_oops_update_moving_object_near_pointer(
                                OopDesc** start, OopDesc** end) {
   const QuickVars& qv = _quick_vars;
@@ -3094,6 +3466,22 @@ inline void ObjectHeap::internal_collect_epilogue(bool is_full_collect,
   PERFORMANCE_COUNTER_SET_MAX(max_gc_hrticks, elapsed);
 #endif
 
+#if ENABLE_PERFORMANCE_COUNTERS
+  {
+    // Pause-time histogram, see JVM::print_performance_counters()
+    const jlong ticks_per_ms = Os::elapsed_frequency() / 1000;
+    int bucket = 3;
+    if (elapsed < ticks_per_ms) {
+      bucket = 0;
+    } else if (elapsed < 10 * ticks_per_ms) {
+      bucket = 1;
+    } else if (elapsed < 100 * ticks_per_ms) {
+      bucket = 2;
+    }
+    jvm_perf_count.num_of_gc_pauses[bucket] ++;
+  }
+#endif
+
 #if ENABLE_TTY_TRACE
   if (VerboseGC || TraceGC) {
     if (is_full_collect) {
@@ -3190,6 +3578,10 @@ bool ObjectHeap::internal_collect(size_t min_free_after_collection JVM_TRAPS) {
   internal_collect_prologue(min_free_after_collection);
   _is_gc_active = true;
 
+#if ENABLE_INCREMENTAL_MARKING
+  const jlong pause_deadline = Os::java_time_millis() + GCPauseTargetMillis;
+#endif
+
   // Evict compiled methods, etc
   const bool is_full_collect = _collection_area_start == _heap_start;
 
@@ -3202,17 +3594,29 @@ bool ObjectHeap::internal_collect(size_t min_free_after_collection JVM_TRAPS) {
 
   setup_marking_stack();
 
+#if ENABLE_INCREMENTAL_MARKING
+  if (_incremental_marking_end != NULL) {
+    incremental_marking_save_dirty_bits();
+  }
+#endif
+
   // Clear bitvector for target collection area (can contain "dirty" bits)
   clear_bit_range( is_full_collect ? _heap_start : _young_generation_start,
                    _inline_allocation_top );
   _compaction_start = _collection_area_end; // sentinel value
   CACHE_QUICK_VAR(compaction_start);
 
+#if ENABLE_PERFORMANCE_COUNTERS
+  jlong gc_phase_start;
+#endif
+
   // Phase1: Mark objects transitively from roots
   if (TraceGC) {
     TTY_TRACE_CR(("TraceGC:  *** MARKING PHASE ***"));
   }
+  GC_PHASE_BEGIN(gc_phase_start);
   mark_objects( is_full_collect );
+  GC_PHASE_END(total_gc_mark_hrticks, gc_phase_start);
 
   // Phase2: Insert forward pointers in unused near object bits
   if (TraceGC) {
@@ -3253,17 +3657,28 @@ bool ObjectHeap::internal_collect(size_t min_free_after_collection JVM_TRAPS) {
   if (TraceGC) {
     TTY_TRACE_CR(("TraceGC:  *** UPDATE OBJECT POINTERS ***"));
   }
+  GC_PHASE_BEGIN(gc_phase_start);
   update_object_pointers();
+  GC_PHASE_END(total_gc_update_hrticks, gc_phase_start);
 
   // Phase4; Compact
   if (TraceGC) {
     TTY_TRACE_CR(("TraceGC:  *** COMPACT OBJECTS ***"));
   }
+  GC_PHASE_BEGIN(gc_phase_start);
   compact_objects(reuse_young_generation);
+  GC_PHASE_END(total_gc_compact_hrticks, gc_phase_start);
 
   // Update _class_list_base, etc
   Universe::update_relative_pointers();
 
+#if ENABLE_INCREMENTAL_MARKING
+  if (!is_full_collect) {
+    // Old objects are in place and stacks are still in GC state
+    incremental_marking_after_young_collect(pause_deadline);
+  }
+#endif
+
   // Restore bci, pc, and stack pointer locks in heap
   Scheduler::gc_epilogue();
 
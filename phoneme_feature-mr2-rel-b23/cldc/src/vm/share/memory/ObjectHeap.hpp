@@ -636,6 +636,13 @@ public:
 
   static bool is_gc_active(void) { return _is_gc_active; }
   static void force_full_collect(void);
+#if ENABLE_INCREMENTAL_MARKING
+  // End of the old-generation area being marked incrementally, or NULL if
+  // no incremental marking cycle is in progress.
+  static OopDesc** incremental_marking_end(void) {
+    return _incremental_marking_end;
+  }
+#endif
   static bool expand_current_compiled_method(int delta);
 
 #if ENABLE_ISOLATES && (USE_IMAGE_MAPPING || USE_LARGE_OBJECT_AREA)
@@ -718,6 +725,7 @@ private:
   static int get_owner( const BoundaryDesc* p, const OopDesc* const classes[] );
 
   static void create_boundary( OopDesc** p, const int task );
+  static OopDesc** open_task_allocation_buffer( const int task_id );
   static void accumulate_memory_usage( OopDesc* lwb[], OopDesc* upb[] );
   static void set_task_memory_reserve_limit(const int task,
                 const unsigned reserve, const unsigned limit) {
@@ -762,6 +770,23 @@ private:
   static void continue_marking(void);
   static void check_marking_stack_overflow(void);
 
+#if ENABLE_INCREMENTAL_MARKING
+  // Incremental marking of the old generation
+  static void incremental_marking_start(void);
+  static void incremental_marking_step(const jlong deadline);
+  static void incremental_marking_after_young_collect(const jlong deadline);
+  static void incremental_marking_save_dirty_bits(void);
+  static void incremental_marking_install_marks(void);
+  static void incremental_marking_rescan_dirty_objects(void);
+  static void incremental_marking_reset(void);
+  static void incremental_mark_and_push(OopDesc** p);
+  static address incremental_bitmap_base(juint* bitmap) {
+    return DERIVED(address, bitmap,
+                   -(int)((size_t)_incremental_marking_start >>
+                          (LogBytesPerWord + LogBitsPerByte)));
+  }
+#endif
+
 #if ENABLE_ISOLATES && ENABLE_COMPILER
   static void cleanup_compiled_method_cache( void );
 #endif
@@ -842,6 +867,12 @@ private:
                                                           OopDesc** end);
   static void write_barrier_oops_update_moving_object_interior_pointers(
                                OopDesc** start, OopDesc** end);
+  static void update_moving_object_interior_pointers(OopDesc** start,
+                                                     OopDesc** end);
+#if ENABLE_PARALLEL_GC
+  static void parallel_update_moving_object_interior_pointers(int index,
+                                                              void* param);
+#endif
   static void write_barrier_oops_update_moving_object_near_pointer(
                                OopDesc** start, OopDesc** end);
   static void write_barrier_oops_unencode_moving_object_near_pointer(
@@ -909,6 +940,22 @@ private:
   // Static variables for mark-sweep-compact
   static bool      _is_gc_active;
 
+#if ENABLE_INCREMENTAL_MARKING
+  // Incremental marking state. The marks and the dirty bits cover
+  // [_incremental_marking_start, _incremental_marking_end), one bit per
+  // word like the bitvector.
+  static OopDesc** _incremental_marking_start;
+  static OopDesc** _incremental_marking_end;
+  static int       _incremental_bitmap_words;
+  static juint*    _incremental_marks;
+  static juint*    _incremental_dirty_bits;
+  static OopDesc** _incremental_marking_stack_start;
+  static OopDesc** _incremental_marking_stack_top;
+  static OopDesc** _incremental_marking_stack_end;
+  static bool      _incremental_marking_failed;
+  static bool      _incremental_marks_installed;
+#endif
+
 #ifdef AZZERT
   static bool      _is_finalizing;
 #endif
@@ -217,6 +217,9 @@ void MemoryProfiler::retrieve_all_data(PacketInputStream *in,
   }
 
   Scheduler::gc_epilogue();
+#if ENABLE_C_INTERPRETER
+  interpreter_flush_interface_call_cache();
+#endif
   if (_current_object == NULL) {
     out->write_int((juint)-1);    
   } else {
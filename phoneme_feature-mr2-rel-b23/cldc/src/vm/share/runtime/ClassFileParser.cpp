@@ -1878,6 +1878,17 @@ ReturnOop ClassFileParser::parse_class_internal(ClassParserState *stack JVM_TRAP
     Method::Raw m = methods().obj_at(i);
     m().set_holder_id(this_class_id);
   }
+#if ENABLE_VERIFICATION_CACHE
+  // A class file that passed verification in an earlier run is marked as
+  // verified here. Only the ClassInfo flag can be set at this point;
+  // SystemDictionary updates the mirror once it has been created.
+  if (get_UseVerifier() &&
+      Verifier::is_cached((jubyte*)_buffer->base_address(),
+                          _buffer->length(), this_class_id)) {
+    StackmapGenerator::compress_verifier_stackmaps(&this_class JVM_CHECK_0);
+    klass_info().set_is_verified();
+  } else
+#endif
   if (!get_UseVerifier()) {
     StackmapGenerator::compress_verifier_stackmaps(&this_class JVM_CHECK_0);
   }
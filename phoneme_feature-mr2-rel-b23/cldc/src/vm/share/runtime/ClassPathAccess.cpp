@@ -142,6 +142,9 @@ ReturnOop ClassPathAccess::open_jar_entry(JarFileParser *parser,
     if (!is_class_file && !(USE_SOURCE_IMAGE_GENERATOR && GenerateROMImage)) {
       flags |= INCREMENTAL_INFLATE;
     }
+    if (is_class_file) {
+      flags |= MAPPED_CLASS_FILE;
+    }
     return parser->open_entry(flags JVM_NO_CHECK_AT_BOTTOM);
   }
   return NULL;
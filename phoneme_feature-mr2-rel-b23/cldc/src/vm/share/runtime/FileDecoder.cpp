@@ -69,6 +69,14 @@ ReturnOop FileDecoder::read_completely0(JVM_SINGLE_ARG_TRAPS) {
              read_completely(JVM_SINGLE_ARG_NO_CHECK_AT_BOTTOM);
   } else {
     int size = file_size();
+#if USE_JAR_ENTRY_MAPPING
+    if ((flags() & MAPPED_CLASS_FILE) && jfp.not_null()) {
+      result = jfp().mapped_class_file(file_pos(), size);
+      if (result.not_null()) {
+        return result;
+      }
+    }
+#endif
     result = Universe::new_byte_array_raw(size JVM_CHECK_0);
     int actual_bytes = get_bytes_raw(result().base_address(), size);
     if (actual_bytes != size) {
@@ -28,7 +28,8 @@ enum {
   MUST_CLOSE_FILE     = 1,
   LAST_BLOCK          = 2,
   INCREMENTAL_INFLATE = 4,
-  SYSTEM_CLASSPATH    = 8
+  SYSTEM_CLASSPATH    = 8,
+  MAPPED_CLASS_FILE   = 16
 };
 
 class FileDecoder : public MixedOop {
@@ -100,6 +100,14 @@ void oop_write_barrier(OopDesc** addr, OopDesc* value) {
     ObjectHeap::set_bit_for(addr);
     GUARANTEE(ObjectHeap::test_bit_for(addr), "sanity check");
   }
+#if ENABLE_INCREMENTAL_MARKING
+  // During incremental marking, stores of pointers to lower addresses
+  // must be recorded as well (see "Incremental marking" in ObjectHeap.cpp).
+  else if (addr < ObjectHeap::incremental_marking_end() &&
+           heap_start <= addr && heap_start <= (OopDesc**)value) {
+    ObjectHeap::set_bit_for(addr);
+  }
+#endif
 }
 #endif
 
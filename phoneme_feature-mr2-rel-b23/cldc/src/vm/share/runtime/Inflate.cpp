@@ -106,7 +106,14 @@ int Inflater::get_bytes(ArrayPointer* dest, int count JVM_TRAPS) {
       set_out_dumped(upper_bound);
     }
 
+#if ENABLE_PERFORMANCE_COUNTERS
+    const jlong start_time = Os::elapsed_counter();
+#endif
     int status = do_inflate(JVM_SINGLE_ARG_CHECK_0);
+#if ENABLE_PERFORMANCE_COUNTERS
+    jvm_perf_count.total_inflate_hrticks +=
+        Os::elapsed_counter() - start_time;
+#endif
     if (status == INFLATE_ERROR) {
       return -1;
     } else if (status == INFLATE_COMPLETE) {
@@ -121,10 +128,16 @@ ReturnOop Inflater::read_completely(JVM_SINGLE_ARG_TRAPS) {
   JarFileParser::Fast jfp = get_jar_parser_if_needed(JVM_SINGLE_ARG_CHECK_0);
   (void)jfp;
 
+#if ENABLE_PERFORMANCE_COUNTERS
+  const jlong start_time = Os::elapsed_counter();
+#endif
   int status;
   do {
     status = do_inflate(JVM_SINGLE_ARG_CHECK_0);
   } while (status == INFLATE_MORE);
+#if ENABLE_PERFORMANCE_COUNTERS
+  jvm_perf_count.total_inflate_hrticks += Os::elapsed_counter() - start_time;
+#endif
 
   const int size = file_size();
   if (status == INFLATE_ERROR || (int) out_offset() != size) {
@@ -274,6 +287,7 @@ int Inflater::inflate_stored(JVM_SINGLE_ARG_TRAPS) {
   }
   jvm_memcpy(outFilePtr, inFilePtr + inOffset, length);
   inOffset += length;
+  PERFORMANCE_COUNTER_INCREMENT(total_inflated_bytes, outOffset - out_dumped());
 
   STORE_IN;
   STORE_OUT;
@@ -293,8 +307,21 @@ int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
     quickDistanceSize = dcodes->h.quickBits;
   }
 
+  if (!inflate_huffman_fast(fixedHuffman, lcodes, dcodes)) {
+    return INFLATE_ERROR;
+  }
+  if (block_type() == BTYPE_UNKNOWN) {
+    // The fast path has reached the end of block
+    return INFLATE_MORE;
+  }
+
+  // Decode the tail of the block, where the input or the output buffer
+  // is too close to its end for the fast path.
   LOAD_IN;
   LOAD_OUT;
+#if ENABLE_PERFORMANCE_COUNTERS
+  const juint startOffset = outOffset;
+#endif
 
   bool buffer_full = false;
   do {
@@ -402,12 +429,155 @@ int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
       outOffset += length;
     }
   } while (!buffer_full);
-  
+
+  PERFORMANCE_COUNTER_INCREMENT(total_inflated_bytes, outOffset - startOffset);
+
   STORE_IN;
   STORE_OUT;
   return INFLATE_MORE;
 }
 
+#define FAST_GET_LITXLEN(result)                                          \
+    if (fixedHuffman) {                                                   \
+      /* See inflate_huffman() for the layout of the fixed codes */       \
+      unsigned int code = reverse_9bits(FAST_NEXTBITS(9));                \
+      if (code <  0x060) {                                                \
+        FAST_DUMPBITS(7);                                                 \
+        result = 0x100 + (code >> 2);                                     \
+      } else if (code < 0x190) {                                          \
+        FAST_DUMPBITS(8);                                                 \
+        result = (code >> 1) + ((code < 0x180) ? (0x000 - 0x030)          \
+                                               : (0x118 - 0x0c0));        \
+      } else {                                                            \
+        FAST_DUMPBITS(9);                                                 \
+        result = 0x90 + code - 0x190;                                     \
+      }                                                                   \
+    } else {                                                              \
+      FAST_GET_HUFFMAN_ENTRY(lcodes, quickDataSize, result);              \
+    }
+
+// Decodes the current block for as long as both the input and the output
+// buffers have enough slack that no per-symbol bounds checks are needed:
+// a single 64-bit refill covers a whole length/distance pair, runs of
+// literals are decoded without refilling, and matches at distance >= 8
+// are copied a word at a time. Returns false if the stream is malformed.
+// Otherwise the unread input is handed back so that inflate_huffman() can
+// decode the tail of the block with the byte-at-a-time loop.
+bool Inflater::inflate_huffman_fast(bool fixedHuffman,
+                                    HuffmanCodeTable *lcodes,
+                                    HuffmanCodeTable *dcodes) {
+  unsigned int quickDataSize = 0, quickDistanceSize = 0;
+  if (!fixedHuffman) {
+    quickDataSize = lcodes->h.quickBits;
+    quickDistanceSize = dcodes->h.quickBits;
+  }
+
+  LOAD_IN;
+  LOAD_OUT;
+#if ENABLE_PERFORMANCE_COUNTERS
+  const juint startOffset = outOffset;
+#endif
+
+  julong bitBuf   = inData;
+  juint  bitCount = inDataSize;
+
+  while (inOffset + FAST_INPUT_BYTES <= inLength &&
+         outOffset + FAST_OUTPUT_BYTES <= outLength) {
+    unsigned int litxlen;
+    FAST_REFILL();
+    FAST_GET_LITXLEN(litxlen);
+
+    // Keep decoding literals from this refill for as long as the bit
+    // buffer still holds a complete length/distance pair.
+    while (litxlen <= 255) {
+      outFilePtr[outOffset++] = (unsigned char)litxlen;
+      if (bitCount < FAST_SYMBOL_BITS ||
+          outOffset + FAST_OUTPUT_BYTES > outLength) {
+        break;
+      }
+      FAST_GET_LITXLEN(litxlen);
+    }
+    if (litxlen <= 255) {
+      continue;
+    }
+
+    if (litxlen == 256) {                     // end of block
+      set_block_type(BTYPE_UNKNOWN);
+      break;
+    }
+    if (litxlen > 285) {
+      ziperr(KVM_MSG_JAR_INVALID_LITERAL_OR_LENGTH);
+      return false;
+    }
+
+    unsigned int n = litxlen - LITXLEN_BASE;
+    unsigned int length = ll_length_base[n];
+    unsigned int moreBits = ll_extra_bits[n];
+    unsigned int d0, distance;
+
+    length += FAST_NEXTBITS(moreBits);
+    FAST_DUMPBITS(moreBits);
+
+    if (fixedHuffman) {
+      d0 = reverse_5bits(FAST_NEXTBITS(5));
+      FAST_DUMPBITS(5);
+    } else {
+      FAST_GET_HUFFMAN_ENTRY(dcodes, quickDistanceSize, d0);
+    }
+    if (d0 > MAX_ZIP_DISTANCE_CODE) {
+      ziperr(KVM_MSG_JAR_BAD_DISTANCE_CODE);
+      return false;
+    }
+
+    distance = dist_base[d0];
+    moreBits = dist_extra_bits[d0];
+    distance += FAST_NEXTBITS(moreBits);
+    FAST_DUMPBITS(moreBits);
+
+    if (outOffset < distance) {
+      ziperr(KVM_MSG_JAR_COPY_UNDERFLOW);
+      return false;
+    }
+
+    unsigned char *dst = outFilePtr + outOffset;
+    unsigned char *src = dst - distance;
+    unsigned char *end = dst + length;
+    outOffset += length;
+    if (distance >= 8) {
+      // Each 8-byte chunk of the source lies entirely before the chunk
+      // being written. The last copy may spill up to 7 bytes past the
+      // match; FAST_OUTPUT_BYTES leaves room for that, and the spilled
+      // bytes are overwritten by the output that follows.
+      do {
+        jvm_memcpy(dst, src, 8);
+        dst += 8;
+        src += 8;
+      } while (dst < end);
+    } else {
+      // src and destination overlap, and we are to copy
+      // in left-to-right order.
+      do {
+        *dst++ = *src++;
+      } while (dst < end);
+    }
+  }
+
+  // Hand whole unread bytes back, so that no more than 32 bits remain
+  // buffered in inData, as NEEDBITS expects.
+  while (bitCount > 32) {
+    inOffset--;
+    bitCount -= 8;
+  }
+  inData = (juint)(bitBuf & ((((julong)1) << bitCount) - 1));
+  inDataSize = bitCount;
+
+  PERFORMANCE_COUNTER_INCREMENT(total_inflated_bytes, outOffset - startOffset);
+
+  STORE_IN;
+  STORE_OUT;
+  return true;
+}
+
 // Read in and decode the huffman tables in the compressed file
 
 int Inflater::decode_dynamic_huffman_tables(JVM_SINGLE_ARG_TRAPS) {
@@ -127,6 +127,37 @@ typedef struct HuffmanCodeTable {
     inData >>= (j);                                             \
     inDataSize -= (j);                                          \
 
+// The bit accessors used by Inflater::inflate_huffman_fast(). The bit
+// buffer is 64 bits wide, so a single refill provides enough bits to
+// decode a whole literal/length + distance pair, or several literals.
+
+#define FAST_REFILL()                                             \
+    while (bitCount <= 56) {                                      \
+      bitBuf |= ((julong)NEXTBYTE()) << bitCount;                 \
+      bitCount += 8;                                              \
+    }
+
+#define FAST_NEXTBITS(j)   ((juint)bitBuf & ((1 << (j)) - 1))
+
+#define FAST_DUMPBITS(j) \
+    GUARANTEE(((j) <= bitCount), "inflate: dumpbits: bitCount too small");\
+    bitBuf >>= (j);                                             \
+    bitCount -= (j);
+
+#define FAST_GET_HUFFMAN_ENTRY(table, quickBits, result)  {                 \
+    unsigned int huff = table->entries[FAST_NEXTBITS(quickBits)];           \
+    if (huff & HUFFINFO_LONG_MASK) {                                        \
+        jint delta = (huff & ~HUFFINFO_LONG_MASK);                          \
+        unsigned short *table2 = (unsigned short *)((char *)table + delta); \
+        huff = table2[FAST_NEXTBITS(table->h.maxCodeLen) >> quickBits];     \
+    }                                                                       \
+    if (huff == 0) {                                                        \
+      return false;                                                         \
+    }                                                                       \
+    FAST_DUMPBITS(huff & 0xF);                                              \
+    result = huff >> 4;                                                     \
+  }
+
 #define LOAD_IN \
     unsigned char* inFilePtr = ARRAY_BASE(in_buffer());             \
     const bool isIncremental = flags() & INCREMENTAL_INFLATE;       \
@@ -279,6 +310,9 @@ private:
   int do_inflate(JVM_SINGLE_ARG_TRAPS);
   int inflate_stored(JVM_SINGLE_ARG_TRAPS);
   int inflate_huffman(bool fixedHuffman JVM_TRAPS);
+  bool inflate_huffman_fast(bool fixedHuffman,
+                            HuffmanCodeTable *lcodes,
+                            HuffmanCodeTable *dcodes);
   int decode_dynamic_huffman_tables(JVM_SINGLE_ARG_TRAPS);
   ReturnOop make_code_table( unsigned char *codelen,
                              unsigned numElems,
@@ -297,7 +331,18 @@ private:
 
     MAX_QUICK_CXD   = 6,
     MAX_QUICK_LXL   = 9,
-    MAX_BITS        = 15   // Maximum number of code bits in Huffman Code Table
+    MAX_BITS        = 15,  // Maximum number of code bits in Huffman Code Table
+
+    // Worst-case number of bits consumed by one literal/length code
+    // followed by a distance code, including their extra bits.
+    FAST_SYMBOL_BITS = MAX_BITS + MAX_ZIP_EXTRA_LENGTH_BITS +
+                       MAX_BITS + MAX_ZIP_EXTRA_DISTANCE_BITS,
+    // inflate_huffman_fast() runs only while the input buffer holds at
+    // least this many unread bytes (one complete 64-bit refill) ...
+    FAST_INPUT_BYTES  = 8,
+    // ... and the output buffer has room for a maximum-length match plus
+    // the overrun of the final word-sized copy.
+    FAST_OUTPUT_BYTES = 258 + 8
   };
 
   enum { 
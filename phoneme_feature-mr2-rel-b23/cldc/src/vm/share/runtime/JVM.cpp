@@ -410,6 +410,12 @@ int JVM::start() {
   if (GenerateROMImage) {
     ok = start_standalone_rom_generator(JVM_SINGLE_ARG_NO_CHECK);
   } else {
+#if ENABLE_COMPILATION_PROFILE
+    CompiledMethodCache::load_profile();
+#endif
+#if ENABLE_VERIFICATION_CACHE
+    Verifier::load_cache();
+#endif
     ok = load_main_class(JVM_SINGLE_ARG_NO_CHECK);
   }
 
@@ -518,6 +524,18 @@ void JVM::cleanup() {
   }
 #endif
 
+#if ENABLE_COMPILATION_PROFILE
+  if (!GenerateROMImage) {
+    CompiledMethodCache::save_profile();
+  }
+#endif
+
+#if ENABLE_VERIFICATION_CACHE
+  if (!GenerateROMImage) {
+    Verifier::save_cache();
+  }
+#endif
+
 #if ENABLE_ISOLATES && ENABLE_PERFORMANCE_COUNTERS
   ObjectHeap::print_max_memory_usage();
 #endif
@@ -1081,6 +1099,13 @@ extern "C" jboolean JVM_Verify(const JvmPathChar *classpath) {
 }
 #endif
 
+#if ENABLE_VERIFICATION_CACHE
+extern "C" void JVM_RemoveVerificationCache(const JvmPathChar *dir,
+                                            const JvmPathChar *classpath) {
+  Verifier::remove_cache(dir, classpath);
+}
+#endif
+
 #if ENABLE_MONET
 extern "C" jint JVM_CreateAppImage(const JvmPathChar *jarFile, 
                                    const JvmPathChar *binFile,
@@ -1309,6 +1334,16 @@ void JVM::print_performance_counters() {
 
   P_HRT(A, "total_gc_hrticks",      pc->total_gc_hrticks);
   P_HRT(G, "max_gc_hrticks",        pc->max_gc_hrticks);
+  P_HRT(G, "total_gc_mark_hrticks", pc->total_gc_mark_hrticks);
+  P_HRT(G, "total_gc_update_hrticks", pc->total_gc_update_hrticks);
+  P_HRT(G, "total_gc_compact_hrticks", pc->total_gc_compact_hrticks);
+  P_INT(G, "gc_pauses < 1ms",       pc->num_of_gc_pauses[0]);
+  P_INT(G, "gc_pauses < 10ms",      pc->num_of_gc_pauses[1]);
+  P_INT(G, "gc_pauses < 100ms",     pc->num_of_gc_pauses[2]);
+  P_INT(G, "gc_pauses >= 100ms",    pc->num_of_gc_pauses[3]);
+  P_INT(G, "incremental_marking_steps", pc->num_of_incremental_marking_steps);
+  P_INT(G, "incremental_full_gc",   pc->num_of_incremental_full_gc);
+  P_INT(G, "task_allocation_buffers", pc->num_of_task_allocation_buffers);
   P_CR (G);
 
   // Other counters
@@ -1326,6 +1361,17 @@ void JVM::print_performance_counters() {
   P_HRT(L, "max_load_hrticks",     pc->max_load_hrticks);
   P_HRT(A, "total_verify_hrticks", pc->total_verify_hrticks);
   P_HRT(L, "max_verify_hrticks",   pc->max_verify_hrticks);
+  P_INT(L, "num_of_verify_cache_hits", pc->num_of_verify_cache_hits);
+  P_HRT(A, "total_inflate_hrticks",pc->total_inflate_hrticks);
+  P_LNG(L, "total_inflated_bytes", pc->total_inflated_bytes);
+  if (pc->total_inflate_hrticks > 0) {
+    jlong inflated_kb_per_sec =
+        jvm_d2l(jvm_ddiv(jvm_l2d(pc->total_inflated_bytes / 1024),
+                         jvm_ddiv(msec_scale(pc->total_inflate_hrticks),
+                                  1000.0)));
+    P_LNG(L, "inflated_kb_per_sec",  inflated_kb_per_sec);
+  }
+  P_INT(L, "num_of_mapped_class_files", pc->num_of_mapped_class_files);
 
   P_INT(L, "num_of_romizer_steps", pc->num_of_romizer_steps);
   P_HRT(L, "total_romizer_hrticks",pc->total_romizer_hrticks);
@@ -1335,6 +1381,7 @@ void JVM::print_performance_counters() {
   P_INT(C, "num_of_compilations",      pc->num_of_compilations);
   P_INT(C, "           finished",      pc->num_of_compilations_finished);
   P_INT(C, "       resume count",      pc->compilation_resume_count);
+  P_INT(C, "  idle resume count",      pc->compilation_idle_resume_count);
   P_INT(C, "             failed",      pc->num_of_compilations_failed);
   P_INT(C, "total_compiled_bytecodes", (int)pc->total_compiled_bytecodes);
   P_INT(C, "max_compiled_bytecodes",   (int)pc->max_compiled_bytecodes);
@@ -1356,8 +1403,48 @@ void JVM::print_performance_counters() {
 
   P_INT(C, "uncommon_traps_generated", pc->uncommon_traps_generated);
   P_INT(C, "uncommon_traps_taken",     pc->uncommon_traps_taken);
+  P_INT(C, "type_profile_guarded_calls", pc->type_profile_guarded_calls);
+  P_INT(C, "type_profile_recompiles",  pc->type_profile_recompilations);
+  P_INT(C, "cached_loop_locals",       pc->cached_loop_locals);
   P_CR (C);
 
+#if ENABLE_C_INTERPRETER && ENABLE_DETAILED_PERFORMANCE_COUNTERS
+  P_LNG(A, "interpreted_bytecodes",    pc->num_of_interpreted_bytecodes);
+  if (elapsed > 0) {
+    // Includes time spent in GC and natives, so this is a lower bound
+    // of the raw dispatch rate.
+    jlong bytecodes_per_sec =
+        jvm_d2l(jvm_ddiv(jvm_l2d(pc->num_of_interpreted_bytecodes),
+                         jvm_ddiv(msec_scale(elapsed), 1000.0)));
+    P_LNG(A, "bytecodes_per_sec",      bytecodes_per_sec);
+  }
+  P_CR (A);
+#endif
+
+#if ENABLE_C_INTERPRETER
+  {
+    const jint lookups = pc->num_of_interface_cache_hits +
+                         pc->num_of_interface_cache_misses;
+    if (lookups > 0) {
+      P_INT(A, "interface_cache_hits",     pc->num_of_interface_cache_hits);
+      P_INT(A, "  polymorphic",
+            pc->num_of_interface_cache_polymorphic_hits);
+      P_INT(A, "interface_cache_misses",   pc->num_of_interface_cache_misses);
+      P_INT(A, "interface_cache_hit_rate %",
+            (int)((jlong)pc->num_of_interface_cache_hits * 100 / lookups));
+      P_CR (A);
+    }
+  }
+  if (pc->num_of_lookupswitch > 0) {
+    P_INT(A, "lookupswitch",        pc->num_of_lookupswitch);
+    P_INT(A, "lookupswitch_probes", pc->num_of_lookupswitch_probes);
+    P_INT(A, "probes/lookupswitch x100",
+          (int)((jlong)pc->num_of_lookupswitch_probes * 100 /
+                pc->num_of_lookupswitch));
+    P_CR (A);
+  }
+#endif
+
   if (UseROM) {
     tty->cr();
     ROM::ROM_print_hrticks(print_hrticks);
@@ -162,7 +162,7 @@ public:
   /// the uncompressed len of the current Jar entry.
   int length;
 
-#if ENABLE_ROM_GENERATOR
+#if ENABLE_ROM_GENERATOR || ENABLE_JAR_ENTRY_CACHE
   /// the total number of entries in the central directory -- this value will
   /// never change as long as the JarFile is open.
   unsigned int totalEntryCount;
@@ -297,6 +297,143 @@ void JarFileParser::flush_caches() {
   }
 }
 
+#if USE_JAR_ENTRY_MAPPING
+
+//----------------------------------------------------------------------
+// Mapped class files
+//
+// A STORED class file can be parsed in place from a private, read/write
+// mapping of its JAR file. A byte array header is written over the LOC
+// header bytes just before the entry data, so that the class file looks
+// like a TypeArray that lives outside of the ObjectHeap (much like a
+// ROM object). ClassFileParser then reads it without a heap allocation
+// or a copy.
+//
+// The mappings are not owned by JarFileParser objects, since a parser
+// may be evicted from the cache (see [4] above) while one of its class
+// files is still being parsed. Instead they are kept in a small table
+// keyed by path name, and released by unmap_files(), which is called
+// only when no class is being loaded (task termination and VM shutdown).
+//----------------------------------------------------------------------
+
+JarFileParser::MappedFile JarFileParser::_mapped_files[MAX_MAPPED_FILES];
+
+address JarFileParser::mapped_address() {
+  TypeArray::Raw stored_name = pathname();
+  const JvmPathChar *name = (JvmPathChar*)stored_name().byte_base_address();
+  const int name_bytes = stored_name().length();
+  BufferedFile::Raw bf = buffered_file();
+  const int file_size = bf().file_size();
+
+  MappedFile *free_slot = NULL;
+  for (int i = 0; i < MAX_MAPPED_FILES; i++) {
+    MappedFile *mf = &_mapped_files[i];
+    if (mf->image == NULL) {
+      if (free_slot == NULL) {
+        free_slot = mf;
+      }
+    } else if (mf->name_bytes == name_bytes &&
+               jvm_memcmp(mf->name, name, name_bytes) == 0) {
+      // Don't use a stale mapping if the JAR file has been rewritten.
+      return (mf->file_size == file_size) ? mf->image->mapped_address : NULL;
+    }
+  }
+  if (free_slot == NULL) {
+    return NULL;
+  }
+
+  JvmPathChar *name_copy = (JvmPathChar*)OsMemory_allocate(name_bytes);
+  if (name_copy == NULL) {
+    return NULL;
+  }
+  OsFile_MappedImageHandle image =
+      OsFile_MapImage(name, NULL, file_size, 0, file_size);
+  if (image == NULL) {
+    OsMemory_free(name_copy);
+    return NULL;
+  }
+  jvm_memcpy(name_copy, name, name_bytes);
+  free_slot->image      = image;
+  free_slot->name       = name_copy;
+  free_slot->name_bytes = name_bytes;
+  free_slot->file_size  = file_size;
+  return image->mapped_address;
+}
+
+static inline bool has_class_file_magic(const_address p) {
+  return p[0] == 0xCA && p[1] == 0xFE && p[2] == 0xBA && p[3] == 0xBE;
+}
+
+ReturnOop JarFileParser::mapped_class_file(int pos, int size) {
+#if ENABLE_ROM_GENERATOR
+  if (GenerateROMImage) {
+    // The romizer may rewrite the JAR file (see remove_class_entries()).
+    return NULL;
+  }
+#endif
+
+  // The GC does not see the header written below, so the near object it
+  // points to must never move.
+  OopDesc* near_obj = Universe::byte_array_class()->prototypical_near();
+  if (!ROM::system_contains(near_obj)) {
+    return NULL;
+  }
+
+  const int header_size = Array::base_offset();
+  BufferedFile::Raw bf = buffered_file();
+  if (size < 4 || pos < LOCHDRSIZ || pos + size > bf().file_size()) {
+    return NULL;
+  }
+  address base = mapped_address();
+  if (base == NULL) {
+    return NULL;
+  }
+
+  // Byte arrays must be word aligned, so the class file is moved down by
+  // up to (BytesPerWord - 1) bytes if needed. This only overwrites the LOC
+  // header of this entry, which has already been read by open_entry()
+  // through the BufferedFile.
+  address data   = base + pos;
+  address header = base + align_size_down(pos - header_size, BytesPerWord);
+  address body   = header + header_size;
+
+  OopDesc** klass_addr = (OopDesc**)(header + Oop::klass_offset());
+  jint* length_addr = (jint*)(header + Array::length_offset());
+
+  // The same class file may be opened again (e.g., by another task), in
+  // which case it has already been prepared in place.
+  if (*klass_addr != near_obj || *length_addr != size ||
+      !has_class_file_magic(body)) {
+    if (!has_class_file_magic(data)) {
+      return NULL;
+    }
+    if (body != data) {
+      jvm_memmove(body, data, size);
+    }
+    jvm_memset(header, 0, header_size);
+    *klass_addr  = near_obj;
+    *length_addr = size;
+  }
+
+#if ENABLE_PERFORMANCE_COUNTERS
+  jvm_perf_count.num_of_mapped_class_files ++;
+#endif
+  return (OopDesc*)header;
+}
+
+void JarFileParser::unmap_files() {
+  for (int i = 0; i < MAX_MAPPED_FILES; i++) {
+    MappedFile *mf = &_mapped_files[i];
+    if (mf->image != NULL) {
+      OsFile_UnmapImage(mf->image);
+      OsMemory_free(mf->name);
+      jvm_memset(mf, 0, sizeof(MappedFile));
+    }
+  }
+}
+
+#endif // USE_JAR_ENTRY_MAPPING
+
 ReturnOop
 JarFileParser::get_parser_from_cache(const JvmPathChar* jar_file_name1,
                                      TypeArray *jar_file_name2) {
@@ -404,6 +541,69 @@ void JarFileParser::fix_bootstrap() {
 }
 #endif
 
+bool JarFileParser::central_directory_do(OsFile_Handle file,
+                                         directory_proc f, void* param) {
+  const long length = OsFile_length(file);
+  if (length < ENDHDRSIZ) {
+    return false;
+  }
+
+  // Most JAR files have no comment after the end header, so the last
+  // ENDHDRSIZ bytes are tried first; otherwise the header is searched for
+  // in the largest tail it can be in.
+  jubyte end_header[ENDHDRSIZ];
+  jubyte* tail = end_header;
+  long tail_length = ENDHDRSIZ;
+  long end_offset = -1;
+  for (;;) {
+    if (OsFile_seek(file, length - tail_length, SEEK_SET) < 0 ||
+        OsFile_read(file, tail, 1, tail_length) != size_t(tail_length)) {
+      break;
+    }
+    for (long i = tail_length - ENDHDRSIZ; i >= 0; i--) {
+      if (GETSIG(tail + i) == ENDSIG &&
+          i + ENDHDRSIZ + ENDCOM(tail + i) == tail_length) {
+        end_offset = i;
+        break;
+      }
+    }
+    if (end_offset >= 0 || tail != end_header) {
+      break;
+    }
+    tail_length = length < 0xFFFF + ENDHDRSIZ ? length : 0xFFFF + ENDHDRSIZ;
+    tail = (jubyte*)OsMemory_allocate(tail_length);
+    if (tail == NULL) {
+      return false;
+    }
+  }
+
+  bool ok = false;
+  if (end_offset >= 0) {
+    const long end_position = length - tail_length + end_offset;
+    const long directory_size = juint(ENDSIZ(tail + end_offset));
+    f(tail + end_offset, ENDHDRSIZ, param);
+    if (directory_size <= end_position &&
+        OsFile_seek(file, end_position - directory_size, SEEK_SET) >= 0) {
+      jubyte buffer[1024];
+      long left = directory_size;
+      while (left > 0) {
+        const size_t n = OsFile_read(file, buffer, 1,
+                            left < long(sizeof buffer) ? left : sizeof buffer);
+        if (n == 0) {
+          break;
+        }
+        f(buffer, (int)n, param);
+        left -= n;
+      }
+      ok = (left == 0);
+    }
+  }
+  if (tail != end_header) {
+    OsMemory_free(tail);
+  }
+  return ok;
+}
+
 bool JarFileParser::find_end_of_central_header() {
   DECLARE_STATIC_BUFFER(unsigned char, buffer, TMPBUFFERSIZE);
   BufferedFile::Raw bf = buffered_file();
@@ -474,7 +674,7 @@ bool JarFileParser::find_end_of_central_header() {
             raw_current_entry()->cenOffset = cenOffset;
             raw_current_entry()->nextCenOffset = cenOffset;
             raw_current_entry()->locOffset = locOffset;
-#if ENABLE_ROM_GENERATOR
+#if ENABLE_ROM_GENERATOR || ENABLE_JAR_ENTRY_CACHE
             raw_current_entry()->totalEntryCount = ENDTOT(bp);
 #endif
           }
@@ -1043,104 +1243,128 @@ bool JarFileParser::remove_class_entries(FilePath *path JVM_TRAPS) {
 
 #if ENABLE_JAR_ENTRY_CACHE
 
-bool JarFileParser::find_entry_from_cache(const char *match_name) {
-  ObjArray::Raw cache = entry_cache();
-  TypeArray::Raw cache_line;
-  jint size = entry_cache_count();
-  jint match_name_len = jvm_strlen(match_name);
-
-  for (int i=0; i<size; i++) {
-    cache_line = cache().obj_at(i);
-    jint name_len = cache_line().length() - CENHDRSIZ;
-
-    if (name_len == match_name_len) {
-      char *p = (char*)cache_line().base_address();
-      char *name = p + CENHDRSIZ;
-
-      if (jvm_memcmp(match_name, name, name_len) == 0) {
-        unsigned char *cenp = raw_current_entry()->centralHeader;
-        jvm_memcpy(cenp, p, CENHDRSIZ);
-        raw_current_entry()->length = CENLEN(cenp);
-
-        if (TraceJarCache) {
-          TTY_TRACE_CR(("JAR: entry cache hit: %s", match_name));
-        }
+//----------------------------------------------------------------------
+// JAR entry index
+//
+// The first time an entry is searched by name, the whole central
+// directory is read (sequentially, through the BufferedFile) into an
+// open-addressing hash table:
+//
+//     [hash of entry name][offset of the entry's central header] ...
+//
+// After that, find_entry() is O(1): a lookup reads only the central
+// header(s) whose name hash matches, and an entry that is not in the
+// JAR file (e.g., a class probed along the classpath) is rejected
+// without any file I/O.
+//----------------------------------------------------------------------
 
-        return true;
-      }
-    }
+inline juint JarFileParser::entry_name_hash(const char *name, int name_len) {
+  juint hash = 0;
+  for (int i=0; i<name_len; i++) {
+    hash = 31 * hash + (juint)(unsigned char)name[i];
   }
-
-  return false;
+  return hash;
 }
 
-// This function will never THROW
-bool JarFileParser::add_current_entry_to_cache(char * name, int name_len
-                                               JVM_TRAPS) {
-  if (name_len > 1 && name[name_len-1] == '/') {
-    // No need to cache any directory names
+bool JarFileParser::build_entry_cache(JVM_SINGLE_ARG_TRAPS) {
+  UsingFastOops fast_oops;
+  BufferedFile::Fast jar_buffer = buffered_file();
+  DECLARE_STATIC_BUFFER(unsigned char, name, MAX_ENTRY_NAME);
+  unsigned char cen[CENHDRSIZ];
+
+  const int count = (int)raw_current_entry()->totalEntryCount;
+  if (count > MaxJarCacheEntryCount) {
+    // Too large to be indexed. Fall back to scanning the central directory.
+    set_entry_cache_count(-1);
     return false;
   }
 
-  bool result = add_current_entry_to_cache0(name, name_len JVM_NO_CHECK);
-  if (!result) {
-    if (CURRENT_HAS_PENDING_EXCEPTION) {
-      Thread::clear_current_pending_exception();
-      if (TraceJarCache) {
-        TTY_TRACE_CR(("JAR: entry cache OutOfMemory"));
+  // Keep the load factor below 3/4 so that every probe sequence ends
+  // at an empty slot.
+  int slots = 4;
+  while (slots * 3 < count * 4) {
+    slots <<= 1;
+  }
+  TypeArray::Fast index = Universe::new_int_array(slots * 2 JVM_CHECK_0);
+  const juint mask = slots - 1;
+
+  int offset = (int)raw_current_entry()->cenOffset;
+  int indexed = 0;
+  for (int i=0; i<count; i++) {
+    if (jar_buffer().seek(offset, SEEK_SET) < 0 ||
+        jar_buffer().get_bytes(cen, CENHDRSIZ) != CENHDRSIZ ||
+        GETSIG(cen) != CENSIG) {
+      // Corrupted central directory. Let find_entry() deal with it.
+      set_entry_cache_count(-1);
+      return false;
+    }
+
+    int name_len = CENNAM(cen);
+    // Entries with longer names cannot be found by find_entry() anyway,
+    // and there's no need to index any directory names.
+    if (name_len <= MAX_ENTRY_NAME) {
+      if (jar_buffer().get_bytes(name, name_len) != name_len) {
+        set_entry_cache_count(-1);
+        return false;
+      }
+      if (!(name_len > 1 && name[name_len-1] == '/')) {
+        juint hash = entry_name_hash((char*)name, name_len);
+        juint slot = hash & mask;
+        while (index().int_at(slot * 2 + 1) != 0) {
+          slot = (slot + 1) & mask;
+        }
+        index().int_at_put(slot * 2,     (jint)hash);
+        index().int_at_put(slot * 2 + 1, offset);
+        indexed ++;
       }
     }
+    offset += CENHDRSIZ + name_len + CENEXT(cen) + CENCOM(cen);
   }
-  return result;
+
+  set_entry_cache(&index);
+  set_entry_cache_count(indexed);
+
+  if (TraceJarCache) {
+    TTY_TRACE_CR(("JAR: indexed %d entries in %d slots", indexed, slots));
+  }
+  return true;
 }
 
-bool JarFileParser::add_current_entry_to_cache0(char * name, int name_len
-                                                JVM_TRAPS) {
+bool JarFileParser::find_entry_from_cache(const char *match_name) {
   UsingFastOops fast_oops;
-  ObjArray::Fast cache = entry_cache();
-  ObjArray::Fast new_cache;
-  TypeArray::Fast cache_line;
-  jint old_size = entry_cache_count();
-  jint cache_line_size;
-
-  // (1) Expand header list if necessary
-  if (cache.is_null() || old_size == cache().length()) {
-    jint new_size = old_size * 5 / 4 + 20;
-    if (new_size > MaxJarCacheEntryCount) {
-        new_size = MaxJarCacheEntryCount;
-    }
-    if (new_size <= old_size) {
-      return false; // Do not exceed MaxJarCacheEntryCount
-    }
-    new_cache = Universe::new_obj_array(new_size JVM_CHECK_0);
-    if (cache.not_null()) {
-      ObjArray::array_copy(&cache, 0, &new_cache, 0, old_size JVM_CHECK_0);
-    }
-    set_entry_cache(&new_cache);
-    cache = new_cache.obj();
-  }
+  TypeArray::Fast index = entry_cache();
+  BufferedFile::Fast jar_buffer = buffered_file();
+  DECLARE_STATIC_BUFFER(unsigned char, found_name, MAX_ENTRY_NAME);
 
-  // (2) Allocate the cache line
-  cache_line_size = CENHDRSIZ + name_len;
-  cache_line = Universe::new_byte_array_raw(cache_line_size JVM_CHECK_0);
-  cache().obj_at_put(old_size, &cache_line);
-  set_entry_cache_count(old_size+1);
+  const int match_name_len = jvm_strlen(match_name);
+  const juint hash = entry_name_hash(match_name, match_name_len);
+  const juint mask = (index().length() / 2) - 1;
 
-  // (3) Copy information there
-  char *p = (char*)cache_line().base_address();
-  jvm_memcpy(p, raw_current_entry()->centralHeader, CENHDRSIZ);
+  for (juint slot = hash & mask; ; slot = (slot + 1) & mask) {
+    const int offset = index().int_at(slot * 2 + 1);
+    if (offset == 0) {
+      return false;
+    }
+    if ((juint)index().int_at(slot * 2) != hash) {
+      continue;
+    }
 
-  p += CENHDRSIZ;
-  jvm_memcpy(p, name, name_len);
+    unsigned char *cenp = raw_current_entry()->centralHeader;
+    if (jar_buffer().seek(offset, SEEK_SET) < 0 ||
+        jar_buffer().get_bytes(cenp, CENHDRSIZ) != CENHDRSIZ) {
+      return false;
+    }
+    if (CENNAM(cenp) == match_name_len &&
+        jar_buffer().get_bytes(found_name, match_name_len) == match_name_len &&
+        jvm_memcmp(found_name, match_name, match_name_len) == 0) {
+      raw_current_entry()->length = CENLEN(cenp);
 
-  if (TraceJarCache) {
-    DECLARE_STATIC_BUFFER(char, tmp, MAX_ENTRY_NAME+1);
-    jvm_memcpy(tmp, name, name_len);
-    tmp[name_len] = 0;
-    TTY_TRACE_CR(("JAR: cached entry [%d]: %s", old_size, tmp));
+      if (TraceJarCache) {
+        TTY_TRACE_CR(("JAR: entry cache hit: %s", match_name));
+      }
+      return true;
+    }
   }
-
-  return true;
 }
 
 #endif // ENABLE_JAR_ENTRY_CACHE
@@ -1166,9 +1390,19 @@ bool JarFileParser::find_entry(const char *match_name JVM_TRAPS)
   BufferedFile::Fast jar_buffer = buffered_file();
   const bool use_entry_cache = CacheJarEntries && enable_entry_cache();
 
-  if (use_entry_cache && match_name != NULL && 
-      find_entry_from_cache(match_name)) {
-    return true;
+  if (use_entry_cache && match_name != NULL) {
+    if (!has_entry_cache() && entry_cache_count() >= 0) {
+      if (!build_entry_cache(JVM_SINGLE_ARG_NO_CHECK)) {
+        if (CURRENT_HAS_PENDING_EXCEPTION) {
+          // Try again next time, the index is just an optimization.
+          Thread::clear_current_pending_exception();
+        }
+      }
+    }
+    if (has_entry_cache()) {
+      // The index covers the whole central directory.
+      return find_entry_from_cache(match_name);
+    }
   }
 
   DECLARE_STATIC_BUFFER(unsigned char, found_name, MAX_ENTRY_NAME);
@@ -1183,8 +1417,6 @@ bool JarFileParser::find_entry(const char *match_name JVM_TRAPS)
   }
 
   while (true) {
-    // raw_current_entry() may be moved by add_current_entry_to_cache(),
-    // Must reload it after every iteration.
     unsigned char *cenp = (unsigned char *)raw_current_entry()->centralHeader;
 
     /* Offset contains the offset of the next central header. Read the
@@ -1209,11 +1441,6 @@ bool JarFileParser::find_entry(const char *match_name JVM_TRAPS)
      *     match, we can reject the name without reading it.
      */
     bool read_name = false;
-    if (use_entry_cache) {
-      // We're using entry cache. Always read the name.
-      read_name = true;
-    }
-
     found_name_len = (juint) CENNAM(cenp);
     if (found_name_len == match_name_len) {
       // The length of the name seems promising; let's read the name.
@@ -1240,28 +1467,8 @@ bool JarFileParser::find_entry(const char *match_name JVM_TRAPS)
             != found_name_len) { // I/O error
           return false;
         }
-        if (use_entry_cache) {
-          bool ok = add_current_entry_to_cache((char*)found_name,
-                                               (int)found_name_len
-                                               JVM_MUST_SUCCEED);
-          if (ok) {
-            // We have successfully cached the current entry (and all entries
-            // before it). So when we run find_entry() again, we just need to
-            // search after <offset> in the JarFile.
-            nextCenOffset = offset + skip_bytes;
-          }
-        }
-
-        // raw_current_entry() may be moved by
-        // add_current_entry_to_cache(), Must reload it after every
-        // iteration.
-        cenp = (unsigned char *)raw_current_entry()->centralHeader;
-
-        // we do length check again to handle caching case 
-        if (found_name_len == match_name_len) {
-          if (jvm_memcmp(found_name, match_name, match_name_len) == 0) {
-            found = true;
-          }
+        if (jvm_memcmp(found_name, match_name, match_name_len) == 0) {
+          found = true;
         }
       }
     }
@@ -1428,7 +1635,7 @@ void JarFileParser::iterate(OopVisitor* visitor) {
     visitor->do_int(&id, FIELD_OFFSET(JarFileParserDesc,
                                       _current_entry.length), true);
   }
-#if ENABLE_ROM_GENERATOR
+#if ENABLE_ROM_GENERATOR || ENABLE_JAR_ENTRY_CACHE
   { 
     NamedField id("totalEntryCount", true);
     visitor->do_int(&id, FIELD_OFFSET(JarFileParserDesc,
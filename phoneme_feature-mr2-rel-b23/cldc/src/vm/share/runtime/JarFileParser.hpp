@@ -73,14 +73,15 @@ class JarFileParserDesc : public MixedOopDesc {
 
 #if ENABLE_JAR_ENTRY_CACHE
   /**
-   * Cache for the JAR file's header table. It's used to speed up
-   * entry searching in JarFileParser.cpp. This is an ObjArray. Each
-   * element is a byte TypeArray:
+   * Hash index of the JAR file's central directory. It's used to speed
+   * up entry searching in JarFileParser.cpp. This is an int TypeArray of
+   * (power of 2) slots, each slot being two ints:
    *
-   *        [centralHeader][name ...]
+   *        [hash of entry name][offset of central header]
    *
-   * This ObjArray is grown automatically, up to the size specified in
-   * the global MaxJarCacheEntryCount.
+   * An offset of 0 means the slot is empty. The index is built the
+   * first time an entry is searched by name, if the JAR file has no
+   * more entries than the global MaxJarCacheEntryCount.
    */
   OopDesc *         _entry_cache;
 
@@ -91,8 +92,8 @@ class JarFileParserDesc : public MixedOopDesc {
 
 
   /*
-   * There may be empty slots at the end of _entry_cache. Only the first
-   * _entry_cache_count slots are in use.
+   * Number of entries in _entry_cache, or -1 if the central directory
+   * cannot be indexed.
    */
   int               _entry_cache_count;
 #endif
@@ -205,7 +206,10 @@ public:
   ReturnOop entry_cache() {
     return obj_field(entry_cache_offset());
   }
-  void set_entry_cache(ObjArray *value) {
+  bool has_entry_cache() {
+    return obj_field(entry_cache_offset()) != NULL;
+  }
+  void set_entry_cache(TypeArray *value) {
     obj_field_put(entry_cache_offset(), value);
   }
 
@@ -264,6 +268,27 @@ public:
 
   static void flush_caches();
 
+  // Calls f(data, length, param) with the end header of the JAR file and
+  // then, in chunks, with its central directory, which holds the name,
+  // sizes and CRC-32 of every entry. Uses the file directly, not the
+  // object heap. Returns false if the file has no valid end header or
+  // cannot be read.
+  typedef void (*directory_proc)(const jubyte* data, int length,
+                                 void* param);
+  static bool central_directory_do(OsFile_Handle file, directory_proc f,
+                                   void* param);
+
+#if USE_JAR_ENTRY_MAPPING
+  // Returns a byte array that holds the <size> bytes of the STORED class
+  // file at offset <pos> of this JAR file, located inside a mapping of
+  // the file; or NULL if the class file cannot be used in place.
+  ReturnOop mapped_class_file(int pos, int size);
+
+  // Releases all JAR file mappings. Must not be called while a class is
+  // being loaded.
+  static void unmap_files();
+#endif
+
 #if USE_JAR_ENTRY_ENUMERATOR
   typedef void (*do_entry_proc)(char* name, int length, JarFileParser *jf
                                 JVM_TRAPS);
@@ -317,16 +342,22 @@ public:
 
 #if ENABLE_JAR_ENTRY_CACHE
   bool find_entry_from_cache(const char *entryname);
-  bool add_current_entry_to_cache(char * name, int name_len JVM_TRAPS);
-  bool add_current_entry_to_cache0(char * name, int name_len JVM_TRAPS);
+  bool build_entry_cache(JVM_SINGLE_ARG_TRAPS);
+  static juint entry_name_hash(const char *name, int name_len);
 #else
   inline bool find_entry_from_cache(const char* /*entryname*/) {
     return false;
   }
-  inline bool add_current_entry_to_cache(char* /*name*/, int /*name_len*/
-                                         JVM_TRAPS) {
+  inline bool build_entry_cache(JVM_SINGLE_ARG_TRAPS) {
+    JVM_IGNORE_TRAPS;
     return false;
   }
+  inline bool has_entry_cache() {
+    return false;
+  }
+  inline int entry_cache_count() const {
+    return -1;
+  }
 #endif
 
 #if ENABLE_ROM_GENERATOR
@@ -360,4 +391,23 @@ private:
   static int _timestamp;
 
   static void dispose( const int i );
+
+#if USE_JAR_ENTRY_MAPPING
+  enum {
+    // Max number of JAR files that can be mapped at the same time. Class
+    // files from other JAR files are read into the heap as usual.
+    MAX_MAPPED_FILES = MAX_CACHED_PARSERS
+  };
+
+  struct MappedFile {
+    OsFile_MappedImageHandle image;
+    JvmPathChar* name;
+    int name_bytes;
+    int file_size;
+  };
+
+  static MappedFile _mapped_files[MAX_MAPPED_FILES];
+
+  address mapped_address();
+#endif
 };
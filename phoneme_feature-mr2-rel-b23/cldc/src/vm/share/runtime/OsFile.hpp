@@ -53,7 +53,7 @@ int      OsFile_eof(OsFile_Handle handle);
 int      OsFile_remove(const JvmPathChar *filename);
 bool     OsFile_rename(const JvmPathChar *from, const JvmPathChar *to);
 
-#if USE_IMAGE_MAPPING
+#if USE_IMAGE_MAPPING || USE_JAR_ENTRY_MAPPING
 
 struct OsFile_MappedImage {
   address mapped_address;
@@ -73,6 +73,11 @@ address OsFile_ImagePreferredAddress(const JvmPathChar* jar_file_name);
 /*
  * Map the given file for use as a binary image by BinaryROM.cpp.
  *
+ * JarFileParser.cpp also uses this function to map JAR files
+ * (see USE_JAR_ENTRY_MAPPING). In this case <preferred_destination>
+ * is NULL and <rw_offset> is 0, i.e., the whole file must be mapped
+ * read-write at any address.
+ *
  * <preferred_destination>: The implementation should attempt to map 
  *           the file such that the first byte of the file appears at
  *           <preferred_destination> -- if this can be done, no further
@@ -104,7 +109,7 @@ OsFile_MappedImageHandle OsFile_MapImage(const JvmPathChar* name,
                                          int rw_length);
 bool OsFile_UnmapImage(OsFile_MappedImageHandle  mapped_image);
 
-#endif // USE_IMAGE_MAPPING
+#endif // USE_IMAGE_MAPPING || USE_JAR_ENTRY_MAPPING
 
 #ifdef __cplusplus
 }
@@ -48,6 +48,21 @@ void OsMisc_page_protect();
 void OsMisc_page_unprotect();
 #endif
 
+#if ENABLE_PARALLEL_GC
+// Start up to <count> - 1 native helper threads for OsMisc_parallel_do().
+// Called once when the object heap is created; OsMisc_parallel_dispose()
+// stops the threads when it is disposed.
+void OsMisc_parallel_initialize(int count);
+void OsMisc_parallel_dispose();
+
+// Call proc(i, param) for each 0 <= i < count, on the calling thread and
+// the helper threads, and return when all the calls have completed. The
+// calls must not touch any VM state other than what <param> gives them.
+// Used by the GC, see ObjectHeap.cpp.
+void OsMisc_parallel_do(void proc(int index, void* param), void* param,
+                        int count);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
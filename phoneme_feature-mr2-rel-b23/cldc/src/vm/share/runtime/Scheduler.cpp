@@ -1075,6 +1075,20 @@ void Scheduler::yield() {
         wait_thrd = wait_thrd().next_waiting();
       }
 
+#if ENABLE_COMPILER
+      // Finish a suspended compilation while nobody is waiting for the
+      // CPU. Only poll for events between the compilation slices, so a
+      // thread woken up by an event is delayed by at most one slice.
+      if (!is_slave_mode() && !JavaDebugger::is_debugger_option_on()) {
+        const bool compiled = Compiler::on_idle(JVM_SINGLE_ARG_CHECK);
+        if (compiled) {
+          master_mode_wait_for_event_or_timer(0);
+          wake_up_timed_out_sleepers(JVM_SINGLE_ARG_CHECK);
+          continue;
+        }
+      }
+#endif
+
       // Must check here before calling wait_for_event... since slave mode
       // will return 'true' and we'll never resume other threads
       if (JavaDebugger::is_debugger_option_on()) {
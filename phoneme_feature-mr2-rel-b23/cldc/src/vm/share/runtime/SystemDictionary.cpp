@@ -254,8 +254,21 @@ ReturnOop SystemDictionary::load_system_class(LoaderContext *loader_ctx JVM_TRAP
           (ic.obj_field(InstanceClass::java_mirror_offset()) == NULL)) {
         ic().setup_java_mirror(JVM_SINGLE_ARG_CHECK_0);
       }
+#if ENABLE_VERIFICATION_CACHE
+      {
+        // Sync the mirror with a verified flag set by the verification cache
+        ClassInfo::Raw info = ic().class_info();
+        JavaClassObj::Raw mirror = ic().java_mirror();
+        if (info().is_verified() && mirror.not_null()) {
+          mirror().set_verified();
+        }
+      }
+#endif
 #endif
       VMEvent::class_prepare_event(&ic);
+#if ENABLE_COMPILATION_PROFILE
+      CompiledMethodCache::apply_profile(&ic);
+#endif
     }
   }
 
@@ -305,6 +318,11 @@ void SystemDictionary::insert(LoaderContext *loader_ctx,
   instance_class->set_next(&next);
   set_bucket_for(&dictionary, hash_value, instance_class);
 
+#if ENABLE_C_INTERPRETER
+  // The new class may have replaced a fake class with the same class_id
+  interpreter_flush_interface_call_cache();
+#endif
+
 #ifdef AZZERT
   if (loader_ctx != NULL) {
     InstanceClass::Raw result = find(loader_ctx JVM_CHECK);
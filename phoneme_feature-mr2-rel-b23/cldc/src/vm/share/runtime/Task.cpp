@@ -414,6 +414,9 @@ void Task::cleanup_terminated_task(int id JVM_TRAPS) {
     }
 
     JarFileParser::flush_caches();
+#if USE_JAR_ENTRY_MAPPING
+    JarFileParser::unmap_files();
+#endif
     ObjectHeap::on_task_termination(task);
     tlist().obj_at_clear(id);
 
@@ -111,6 +111,17 @@ typedef char JvmPathChar;
  */
 jboolean JVM_Verify(const JvmPathChar *classpath);
 
+#if ENABLE_VERIFICATION_CACHE
+/*
+ * Deletes the verification cache that the VM keeps in the directory dir
+ * (given to the VM with -verifycachedir) for the given classpath. The
+ * application installer should call this whenever it installs, updates
+ * or removes the suite that is run with this classpath.
+ */
+void JVM_RemoveVerificationCache(const JvmPathChar *dir,
+                                 const JvmPathChar *classpath);
+#endif
+
 /* Call this before any other Jvm_ functions. */
 void JVM_Initialize(void);
 
@@ -492,6 +503,20 @@ typedef struct _JVM_PerformanceCounters {
 
   jlong total_gc_hrticks;      /* Total number of hrticks spent inside GC */
   jlong max_gc_hrticks;        /* Number of hrticks spent in the longest GC */
+  jlong total_gc_mark_hrticks;    /* Part of total_gc_hrticks spent marking
+                                   * live objects */
+  jlong total_gc_update_hrticks;  /* Part of total_gc_hrticks spent updating
+                                   * pointers to moving objects */
+  jlong total_gc_compact_hrticks; /* Part of total_gc_hrticks spent moving
+                                   * objects */
+  int num_of_gc_pauses[4];     /* Number of GCs that took < 1 ms, < 10 ms,
+                                * < 100 ms and >= 100 ms */
+  int num_of_incremental_marking_steps; /* Number of young GCs that marked
+                                        * part of the old generation */
+  int num_of_incremental_full_gc; /* Number of full GCs that used the marks
+                                   * of an incremental marking cycle */
+  int num_of_task_allocation_buffers; /* Number of allocation buffers
+                                       * opened on task switches */
 
   jlong total_event_checks;    /* Number times of JVMSPI_CheckEvents called */
   jlong total_event_hrticks;   /* Total hrticks spent for reading events */
@@ -506,6 +531,15 @@ typedef struct _JVM_PerformanceCounters {
   jlong total_verify_hrticks;  /* Total number of hrticks in verification */
   jlong max_verify_hrticks;    /* Number of hrticks spent in the longest
                                 * verification. */
+  int num_of_verify_cache_hits; /* Number of classes whose verification
+                                 * was skipped by the verification cache */
+
+  jlong total_inflate_hrticks; /* Total number of hrticks spent inflating
+                                * compressed JAR entries */
+  jlong total_inflated_bytes;  /* Total number of bytes produced by the
+                                * Inflater */
+  int num_of_mapped_class_files; /* Number of class files parsed in place
+                                  * from a mapped JAR file */
 
   /*----------------------------------------------------------------------
    * Romization
@@ -532,6 +566,9 @@ typedef struct _JVM_PerformanceCounters {
                                * lack of memory) */
   int compilation_resume_count;
                               /* How many times have we resumed compilation*/
+  int compilation_idle_resume_count;
+                              /* How many of these resumptions used the
+                               * idle time of the scheduler */
   jlong total_compile_hrticks; /* Total number of hrticks spent in compiler */
   jlong max_compile_hrticks;   /* Number of hrticks spent in longest compile */
   jlong total_compile_mem;     /* Total memory allocated during compilation */
@@ -547,6 +584,41 @@ typedef struct _JVM_PerformanceCounters {
                                 * compiler */
   int uncommon_traps_taken;    /* Number of uncommon traps taken during
                                 * execution of compiled code */
+  int type_profile_guarded_calls;
+                               /* Number of call sites compiled as a
+                                * guarded direct call */
+  int type_profile_recompilations;
+                               /* Number of compiled methods unlinked
+                                * because one of their call sites became
+                                * monomorphic */
+  int cached_loop_locals;      /* Number of locals loaded into registers
+                                * at loop headers by the compiler */
+
+  /*----------------------------------------------------------------------
+   * Interpretation
+   *----------------------------------------------------------------------*/
+
+  jlong num_of_interpreted_bytecodes;
+                               /* Number of bytecodes dispatched by the C
+                                * interpreter loop. Maintained only if
+                                * ENABLE_DETAILED_PERFORMANCE_COUNTERS */
+
+  jint num_of_interface_cache_hits;
+                               /* Number of fast_invokeinterface calls whose
+                                * target was found in the call site's
+                                * inline cache (C interpreter only) */
+  jint num_of_interface_cache_polymorphic_hits;
+                               /* The part of the above hits that matched
+                                * the second receiver class of the site */
+  jint num_of_interface_cache_misses;
+                               /* Number of fast_invokeinterface calls that
+                                * had to search the itable */
+  jint num_of_lookupswitch;
+                               /* Number of lookupswitch bytecodes executed
+                                * by the C interpreter */
+  jint num_of_lookupswitch_probes;
+                               /* Number of match keys compared by the
+                                * above lookupswitch bytecodes */
 
 
   /*----------------------------------------------------------------------
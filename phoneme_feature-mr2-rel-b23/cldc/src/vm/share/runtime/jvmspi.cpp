@@ -150,6 +150,21 @@ void JVMSPI_DisplayUsage(char* message) {
   P("                : Output filename for binary rom image");
 #endif
 
+#if USE_AOT_COMPILATION
+  P("    -precompileprofile <file>");
+  P("                : Precompile the hot methods of a flat profile");
+#endif
+
+#if ENABLE_VERIFICATION_CACHE
+  P("    -verifycachedir <directory>");
+  P("                : Trusted directory of the verification caches");
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+  P("    -compileprofiledir <directory>");
+  P("                : Directory of the compilation profiles");
+#endif
+
 #if USE_DEBUG_PRINTING
   P("    -definitions: List values of VM symbolic definitions");
   P("    -flags      : List all available Global Flags");
@@ -82,6 +82,18 @@ Arguments::ROMIncludePath* Arguments::_rom_include_paths;
 Arguments::Path            Arguments::_rom_input_file;
 #endif
 
+#if USE_AOT_COMPILATION
+Arguments::Path            Arguments::_precompile_profile_file;
+#endif
+
+#if ENABLE_VERIFICATION_CACHE
+Arguments::Path            Arguments::_verification_cache_dir;
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+Arguments::Path            Arguments::_compilation_profile_dir;
+#endif
+
 #ifndef PRODUCT
 Arguments::Path            Arguments::_compiler_test_config_file;
 #endif
@@ -125,6 +137,18 @@ int Arguments::parse_one_arg(int argc, char** argv) {
     set_pathname_from_const_ascii(&_classpath, argv[1]);
     count = 2;
   }
+#if ENABLE_VERIFICATION_CACHE
+  else if (jvm_strcmp(argv[0], "-verifycachedir") == 0 && argc >= 2) {
+    set_pathname_from_const_ascii(&_verification_cache_dir, argv[1]);
+    count = 2;
+  }
+#endif
+#if ENABLE_COMPILATION_PROFILE
+  else if (jvm_strcmp(argv[0], "-compileprofiledir") == 0 && argc >= 2) {
+    set_pathname_from_const_ascii(&_compilation_profile_dir, argv[1]);
+    count = 2;
+  }
+#endif
   else if (jvm_strcmp(argv[0], "-int") == 0) {
     UseCompiler = false;
   }
@@ -224,6 +248,13 @@ int Arguments::parse_one_arg(int argc, char** argv) {
     count = 2;
   }
 
+#if USE_AOT_COMPILATION
+  else if (jvm_strcmp(argv[0], "-precompileprofile") == 0) {
+    set_pathname_from_const_ascii(&_precompile_profile_file, argv[1]);
+    count = 2;
+  }
+#endif
+
 #endif // ENABLE_ROM_GENERATOR
 
 #if USE_DEBUG_PRINTING
@@ -569,6 +600,18 @@ void Arguments::finalize() {
   _rom_include_paths = NULL;
 #endif
 
+#if USE_AOT_COMPILATION
+  free_pathname(&_precompile_profile_file);
+#endif
+
+#if ENABLE_VERIFICATION_CACHE
+  free_pathname(&_verification_cache_dir);
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+  free_pathname(&_compilation_profile_dir);
+#endif
+
 #ifndef PRODUCT
   free_pathname(&_compiler_test_config_file);
 #endif
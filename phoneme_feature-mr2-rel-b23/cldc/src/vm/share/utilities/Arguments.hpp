@@ -76,10 +76,22 @@ private:
   static Path             _rom_input_file;
 #endif
 
+#if USE_AOT_COMPILATION
+  static Path             _precompile_profile_file;
+#endif
+
 #if ENABLE_INTERPRETER_GENERATOR || USE_SOURCE_IMAGE_GENERATOR
   static Path             _generator_output_dir;
 #endif
 
+#if ENABLE_VERIFICATION_CACHE
+  static Path             _verification_cache_dir;
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+  static Path             _compilation_profile_dir;
+#endif
+
 public:
 
 #if ENABLE_JAVA_DEBUGGER
@@ -103,10 +115,22 @@ public:
     _rom_include_paths = NULL;
 #endif
 
+#if USE_AOT_COMPILATION
+    _precompile_profile_file._path = NULL;
+#endif
+
 #if ENABLE_INTERPRETER_GENERATOR || USE_SOURCE_IMAGE_GENERATOR
     _generator_output_dir._path = NULL;
 #endif
 
+#if ENABLE_VERIFICATION_CACHE
+    _verification_cache_dir._path = NULL;
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+    _compilation_profile_dir._path = NULL;
+#endif
+
 #ifndef PRODUCT
     _compiler_test_config_file._path = NULL;
 #endif
@@ -203,6 +227,12 @@ public:
   }
 #endif
 
+#if USE_AOT_COMPILATION
+  static const JvmPathChar* precompile_profile_file() {
+    return _precompile_profile_file._path;
+  }
+#endif
+
 #if ENABLE_INTERPRETER_GENERATOR || USE_SOURCE_IMAGE_GENERATOR
   static const JvmPathChar* generator_output_dir() {
     return _generator_output_dir._path;
@@ -213,6 +243,18 @@ public:
     return _classpath._path;
   }
 
+#if ENABLE_VERIFICATION_CACHE
+  static const JvmPathChar* verification_cache_dir() {
+    return _verification_cache_dir._path;
+  }
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+  static const JvmPathChar* compilation_profile_dir() {
+    return _compilation_profile_dir._path;
+  }
+#endif
+
 #if USE_BINARY_IMAGE_GENERATOR
   static const JvmPathChar* rom_input_file() {
     return _rom_input_file._path;
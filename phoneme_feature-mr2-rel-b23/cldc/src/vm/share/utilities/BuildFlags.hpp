@@ -169,6 +169,12 @@
 //                                    code instead of the generated assembler
 //                                    interpreter.
 //
+// ENABLE_C_INTERPRETER_THREADED_DISPATCH 0,0 C interpreter only. Dispatch
+//                                    the most frequent bytecodes through a
+//                                    computed-goto loop that keeps jpc, sp
+//                                    and locals in registers. Requires GCC;
+//                                    the dispatch table is used otherwise.
+//
 // ENABLE_CLDC_11                1,1  Support CLDC 1.1 Specification instead
 //                                    of CLDC 1.0.
 //
@@ -213,6 +219,19 @@
 //                                    hot methods are compiled. Disable this
 //                                    option when running on slow devices.
 //
+// ENABLE_COMPILATION_PROFILE    0,0  Save the names of the compiled methods
+//                                    at VM exit, and compile the same
+//                                    methods on their first invocation
+//                                    the next time the same application
+//                                    is launched. The profiles are kept
+//                                    in the -compileprofiledir directory.
+//
+// ENABLE_TYPE_PROFILE           0,0  Sample the targets of virtual and
+//                                    interface calls on timer ticks, and
+//                                    compile call sites with a single
+//                                    observed target as a guarded direct
+//                                    call that can be inlined.
+//
 // ENABLE_FLOAT                  1,1  Support floating point byte codes.
 //
 //
@@ -252,13 +271,26 @@
 //                                    (e.g. check_timer_tick). Works only
 //                                    if the feature is supported by OS.
 //
+// ENABLE_PARALLEL_GC            0,0  Use several native threads to update
+//                                    the pointers of moving objects during
+//                                    GC compaction. The OS port must
+//                                    implement the OsMisc_parallel_*()
+//                                    functions (see OsMisc.hpp); currently
+//                                    only Linux does.
+//
+// ENABLE_INCREMENTAL_MARKING    0,0  Mark the old generation in small steps
+//                                    at the end of young collections, so
+//                                    that a full collection does not need
+//                                    to mark the whole heap.
+//
 // ENABLE_ZERO_YOUNG_GENERATION  1,1  Fills youngen with zero values after GC.
 //                                    When the option is off each newly created
 //                                    object is cleared right after allocation.
 //
 // ENABLE_MEMORY_MAPPED_FILES    1,1  Use memory-mapped files for
-//                                    loading binary images. This flag takes
-//                                    effect only if the target platform
+//                                    loading binary images and JAR files.
+//                                    This flag takes effect only if the
+//                                    target platform
 //                                    has SUPPORTS_MEMORY_MAPPED_FILES=1.
 //
 // ENABLE_MEMORY_PROFILER        0,0  Add Memory Profiler support.
@@ -280,6 +312,11 @@
 // ENABLE_JAR_ENTRY_CACHE        1,1  Cache the JAR entry table for fast
 //                                    lookup.
 //
+// ENABLE_JAR_ENTRY_MAPPING      1,1  Parse STORED class files in place
+//                                    from a memory-mapped JAR file, instead
+//                                    of reading them into the heap. Takes
+//                                    effect only if USE_JAR_ENTRY_MAPPING.
+//
 // ENABLE_JAR_READER_EXPORTS     1,1  Export routines for the JAR reader.
 //
 //
@@ -406,6 +443,13 @@
 //                                    for classpath verification
 //                                    without any byte code execution.
 //
+// ENABLE_VERIFICATION_CACHE     0,0  Remember the digests of the class
+//                                    files that passed verification, and
+//                                    skip the verification of unchanged
+//                                    class files the next time the same
+//                                    application is launched. Not
+//                                    available with ENABLE_ISOLATES.
+//
 // ENABLE_EMBEDDED_CALLINFO      0,0  Compiler-specific.
 //                                    Embed call info records in compiled code
 //                                    just after the call instruction. This is
@@ -611,6 +655,11 @@
 //                                    all entries in a JAR file (e.g., used by
 //                                    the romizer and +TestCompiler)
 //
+// USE_C_INTERPRETER_THREADED_DISPATCH
+//                                    Build the computed-goto dispatch loop
+//                                    in Interpreter_c.cpp (needs the GCC
+//                                    labels-as-values extension).
+//
 
 #define USE_SOURCE_IMAGE_GENERATOR    ((!ENABLE_MONET) && ENABLE_ROM_GENERATOR)
 
@@ -629,6 +678,13 @@
 #define USE_UNRESOLVED_NAMES_IN_BINARY_IMAGE 0
 #endif
 
+#if ENABLE_C_INTERPRETER && ENABLE_C_INTERPRETER_THREADED_DISPATCH && \
+    defined(__GNUC__) && !ENABLE_JAVA_DEBUGGER
+#define USE_C_INTERPRETER_THREADED_DISPATCH 1
+#else
+#define USE_C_INTERPRETER_THREADED_DISPATCH 0
+#endif
+
 #if !defined(PRODUCT) || ENABLE_VERIFY_ONLY || \
      ENABLE_ROM_GENERATOR || ENABLE_PERFORMANCE_COUNTERS || \
      USE_PRODUCT_BINARY_IMAGE_GENERATOR
@@ -725,6 +781,23 @@
 #define ENABLE_INTERPRETATION_LOG 0
 #endif
 
+#if ENABLE_COMPILATION_PROFILE && !ENABLE_COMPILER
+#undef  ENABLE_COMPILATION_PROFILE
+#define ENABLE_COMPILATION_PROFILE 0
+#endif
+
+#if ENABLE_TYPE_PROFILE && !ENABLE_COMPILER
+#undef  ENABLE_TYPE_PROFILE
+#define ENABLE_TYPE_PROFILE 0
+#endif
+
+// Under MVM the verification cache, which is kept per startup classpath,
+// cannot tell apart the classes of the different tasks.
+#if ENABLE_VERIFICATION_CACHE && (ENABLE_VERIFY_ONLY || ENABLE_ISOLATES)
+#undef  ENABLE_VERIFICATION_CACHE
+#define ENABLE_VERIFICATION_CACHE 0
+#endif
+
 #if !ENABLE_COMPILER && ENABLE_CODE_OPTIMIZER
 // ENABLE_CODE_OPTIMIZER makes no sense if compiler is not enabled
 #undef  ENABLE_CODE_OPTIMIZER
@@ -998,6 +1071,18 @@
 #  endif
 #endif
 
+// USE_JAR_ENTRY_MAPPING              Map JAR files with OsFile_MapImage()
+//                                    so that STORED class files can be
+//                                    parsed without being copied into the
+//                                    ObjectHeap (see JarFileParser.cpp).
+
+#if ENABLE_JAR_ENTRY_MAPPING && SUPPORTS_MEMORY_MAPPED_FILES && \
+    ENABLE_MEMORY_MAPPED_FILES
+#  define USE_JAR_ENTRY_MAPPING 1
+#else
+#  define USE_JAR_ENTRY_MAPPING 0
+#endif
+
 // USE_DEBUG_PRINTING                 Include code to print various internal
 //                                    data structures and symbolic definitions
 //                                    in the VM. This feature can be turned off
@@ -1972,6 +1972,9 @@ extern "C" {
   void shared_fast_getlong_static_accessor();
 
   void invoke_pending_entries(Thread* thread);
+#if ENABLE_C_INTERPRETER
+  void interpreter_flush_interface_call_cache();
+#endif
   void primordial_to_current_thread();
   void current_thread_to_primordial();
   void call_on_primordial_stack(void (*)(void));
@@ -322,8 +322,8 @@ private:
           "Enable caching JAR layout and entries,"                          \
           " when built with ENABLE_JAR_ENTRY_CACHE=true")                   \
                                                                             \
-  develop(int, MaxJarCacheEntryCount, 256,                                  \
-          "The maximum number of entries cached for a Jar file")            \
+  develop(int, MaxJarCacheEntryCount, 4096,                                 \
+          "The maximum number of entries indexed for a Jar file")           \
                                                                             \
   develop(bool, PrintAllObjects, false,                                     \
           "Print all object by iterating over the object heap")             \
@@ -370,6 +370,10 @@ private:
           "to compile (in milliseconds.) MaxCompilationTime can be "        \
           "by reimplementing Os::check_compiler_timer()")                   \
                                                                             \
+  product(bool, IdleTimeCompilation, true,                                  \
+          "Resume a suspended compilation when no Java thread is ready "    \
+          "to run, instead of waiting for the next timer tick")             \
+                                                                            \
   product(int, InterpretationLogSize, INTERP_LOG_SIZE,                      \
           "How many elements of _interpretation_log[] to examine during "   \
           "timer tick -- set to 0 to disable interpretation log")
@@ -459,6 +463,13 @@ private:
   op(int, LoopPeelingSizeLimit, 100,                                       \
           "Do not peel the loop if generated code for first run exceeds "  \
           "this limit (in bytes)")                                         \
+  op(bool, EliminateLoopArrayChecks, true,                                 \
+          "Omit the index and null checks of a[i] in loops of the form "   \
+          "for (i = k; i < a.length; i++) with a constant k >= 0")         \
+  op(bool, CacheLoopLocals, true,                                          \
+          "Load the int and object locals used most in a loop without "    \
+          "calls into registers at the loop header, so that they stay "    \
+          "in registers across the back edges")                            \
   op(int, CompiledCodeFactor, 15,                                          \
           "Compute the maximum compiled code size using method code size") \
   op(int, ArrayCopyLoopUnrollingLimit, 10,                                 \
@@ -766,6 +777,10 @@ private:
           "Generate symbol table for AOT-compiled methods (for certain "    \
           "debuggers/emulators that supports this table")                   \
                                                                             \
+  product(int, PrecompileProfileThreshold, 5,                               \
+          "Precompile the methods of the -precompileprofile flat profile "  \
+          "that take at least this many tenths of a percent of all ticks")  \
+                                                                            \
   product(int, MaxRomizationTime, 30,                                       \
           "Suspend romization if {Source,Binary}ROMWriter::execute() "      \
           "has spent more than this number of milliseconds in a single "    \
@@ -870,6 +885,10 @@ private:
                                                                             \
   product(int, TotalMemory, max_jint,                                       \
             "Total memory for the first isolate")                           \
+                                                                            \
+  product(bool, TaskAllocationBuffers, true,                                \
+            "Open the allocation buffer of a task when switching to it, "   \
+            "so that its first allocation does not leave the fast path")    \
 
 #endif
 
@@ -935,6 +954,91 @@ private:
 #define CPU_VARIANT_RUNTIME_FLAGS(develop, product)
 #endif
 
+#if ENABLE_C_INTERPRETER
+#define C_INTERPRETER_RUNTIME_FLAGS(develop, product)                       \
+  product(bool, UseThreadedDispatch, true,                                  \
+          "Use the computed-goto dispatch loop of the C interpreter "       \
+          "(only if built with ENABLE_C_INTERPRETER_THREADED_DISPATCH)")    \
+                                                                            \
+  product(bool, UseInterfaceCallCache, true,                                \
+          "Cache the targets of fast_invokeinterface per call site in "     \
+          "the C interpreter")
+#else
+#define C_INTERPRETER_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_PARALLEL_GC
+#define PARALLEL_GC_RUNTIME_FLAGS(develop, product)                         \
+  product(int, ParallelGCThreads, 2,                                        \
+          "Number of native threads (at most 16) used to update the "       \
+          "pointers of moving objects during GC compaction")                \
+                                                                            \
+  product(int, ParallelGCMinBytes, 256 * 1024,                              \
+          "Update pointers with a single thread if fewer bytes of "         \
+          "objects are moving")
+#else
+#define PARALLEL_GC_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_INCREMENTAL_MARKING
+#define INCREMENTAL_MARKING_RUNTIME_FLAGS(develop, product)                 \
+  product(bool, IncrementalMarking, true,                                   \
+          "Mark the old generation in steps at the end of young "           \
+          "collections to shorten the pauses of full collections")          \
+                                                                            \
+  product(int, IncrementalMarkingStartPercentage, 50,                       \
+          "Start marking the old generation incrementally when it "         \
+          "occupies this percentage of the heap")                           \
+                                                                            \
+  product(int, GCPauseTargetMillis, 10,                                     \
+          "Target pause time of a young collection, including its "         \
+          "incremental marking step")
+#else
+#define INCREMENTAL_MARKING_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_COMPILATION_PROFILE
+#define COMPILATION_PROFILE_RUNTIME_FLAGS(develop, product)                 \
+  product(bool, UseCompilationProfile, true,                                \
+          "Compile the methods recorded in the compilation profile of "     \
+          "the previous run on their first invocation, and record the "     \
+          "compiled methods of this run at exit")
+#else
+#define COMPILATION_PROFILE_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_TYPE_PROFILE
+#define TYPE_PROFILE_RUNTIME_FLAGS(develop, product)                        \
+  product(bool, UseTypeProfile, true,                                       \
+          "Sample the targets of virtual and interface calls on timer "     \
+          "ticks, and compile call sites with a single observed target "    \
+          "as a guarded direct call")                                       \
+                                                                            \
+  product(int, TypeProfileThreshold, 3,                                     \
+          "Number of samples with the same target after which a call "      \
+          "site is considered monomorphic and its compiled caller is "      \
+          "recompiled")                                                     \
+                                                                            \
+  develop(bool, TraceTypeProfile, false,                                    \
+          "Trace monomorphic call sites, guarded calls and guard failures")
+#else
+#define TYPE_PROFILE_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_VERIFICATION_CACHE
+#define VERIFICATION_CACHE_RUNTIME_FLAGS(develop, product)                  \
+  product(bool, UseVerificationCache, true,                                 \
+          "Skip the verification of class files whose digest was recorded " \
+          "in the verification cache by a previous run, and record the "    \
+          "digests of the classes verified by this run at exit. Only "      \
+          "used if a cache directory is given with -verifycachedir")        \
+                                                                            \
+  develop(bool, TraceVerificationCache, false,                              \
+          "Trace the hits and updates of the verification cache")
+#else
+#define VERIFICATION_CACHE_RUNTIME_FLAGS(develop, product)
+#endif
+
 #define RUNTIME_FLAGS(develop, product, always)            \
       GENERIC_RUNTIME_FLAGS(develop, product)              \
       USE_ROM_RUNTIME_FLAGS(develop, product, always)      \
@@ -950,6 +1054,12 @@ private:
       JVMPI_PROFILE_RUNTIME_FLAGS(develop, product)        \
       JVMPI_PROFILE_VERIFY_RUNTIME_FLAGS(develop, product) \
       CPU_VARIANT_RUNTIME_FLAGS(develop, product)          \
+      C_INTERPRETER_RUNTIME_FLAGS(develop, product)        \
+      PARALLEL_GC_RUNTIME_FLAGS(develop, product)          \
+      INCREMENTAL_MARKING_RUNTIME_FLAGS(develop, product)  \
+      COMPILATION_PROFILE_RUNTIME_FLAGS(develop, product)  \
+      TYPE_PROFILE_RUNTIME_FLAGS(develop, product)         \
+      VERIFICATION_CACHE_RUNTIME_FLAGS(develop, product)   \
       TTY_TRACE_RUNTIME_FLAGS(always, develop, product)
 
 /*
@@ -138,6 +138,12 @@ void Verifier::verify_class(InstanceClass* ic JVM_TRAPS) {
 
   verify_class_internal(ic JVM_NO_CHECK_AT_BOTTOM); 
 
+#if ENABLE_VERIFICATION_CACHE
+  if (!CURRENT_HAS_PENDING_EXCEPTION) {
+    record_verified(ic);
+  }
+#endif
+
 #if ENABLE_PERFORMANCE_COUNTERS
   // Don't count the class loading time during verification, since we want
   // to meausre the effect of only verification itself (so that we can
@@ -170,6 +176,514 @@ bool Verifier::flush_cache() {
   }
 }
 
+#if ENABLE_VERIFICATION_CACHE
+// Layout of the cache file, in native byte order (it is only read back
+// by the same VM build):
+//
+//   VerificationCacheHeader
+//   ClassDigest of a verified class file
+//   ...
+//
+// Whether a class passes verification depends on the classes it refers
+// to as well as on its own bytes, so a cached digest is only trusted
+// while none of them has changed. The header therefore holds a SHA-256
+// digest of the VM version, the number of system ROM classes and the
+// central directory of every classpath JAR, which holds the CRC-32,
+// sizes and name of each entry; any change to the application or the
+// VM discards all the entries. Reading the central directories costs a
+// few small reads per JAR instead of reading the JARs in full. Each
+// classpath (i.e., each application suite) gets its own file, named
+// after a hash of the classpath string, in the directory given with
+// -verifycachedir. The class digests are kept sorted in the file, so
+// that a class is looked up with a binary search.
+//
+// Anyone who can write the file can make the VM skip the verifier, so
+// that directory must only be writable by the VM and the application
+// installer, which should call JVM_RemoveVerificationCache() when it
+// installs, updates or removes a suite. Without -verifycachedir the
+// cache is not used.
+
+enum { VerificationCacheMagic = 0xCC0DEF13 };
+
+// SHA-256 digest of a class file or of the classpath contents
+struct ClassDigest {
+  juint word[8];
+
+  bool equals(const ClassDigest* other) const {
+    return compare(other) == 0;
+  }
+
+  int compare(const ClassDigest* other) const {
+    for (int i = 0; i < 8; i++) {
+      if (word[i] != other->word[i]) {
+        return word[i] < other->word[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+};
+
+static int __cdecl compare_class_digests(const void* a, const void* b) {
+  return ((const ClassDigest*)a)->compare((const ClassDigest*)b);
+}
+
+struct VerificationCacheHeader {
+  juint       magic;
+  juint       count;
+  ClassDigest classpath_digest;
+};
+
+// Digest of a class file that was parsed but is not verified yet
+struct PendingDigest {
+  int         class_id;
+  ClassDigest digest;
+};
+
+// Digests of the verified classes. The first _sorted_count entries were
+// loaded from the cache file and are sorted; the classes verified since
+// are appended after them and merged in by save_cache().
+static ClassDigest*   _verified_digests;
+static int            _sorted_count;
+static int            _verified_count;
+static int            _verified_capacity;
+static bool           _verified_digests_changed;
+static bool           _verification_cache_active;
+static ClassDigest    _classpath_digest;
+static PendingDigest* _pending_digests;
+static int            _pending_count;
+static int            _pending_capacity;
+
+static const juint sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline juint sha256_rotate(const juint x, const int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+static void sha256_block(juint h[8], const jubyte* p) {
+  juint w[64];
+  int i;
+  for (i = 0; i < 16; i++, p += 4) {
+    w[i] = (juint(p[0]) << 24) | (juint(p[1]) << 16) |
+           (juint(p[2]) <<  8) |  juint(p[3]);
+  }
+  for (; i < 64; i++) {
+    const juint s0 = sha256_rotate(w[i-15], 7) ^ sha256_rotate(w[i-15], 18) ^
+                     (w[i-15] >> 3);
+    const juint s1 = sha256_rotate(w[i-2], 17) ^ sha256_rotate(w[i-2], 19) ^
+                     (w[i-2] >> 10);
+    w[i] = w[i-16] + s0 + w[i-7] + s1;
+  }
+
+  juint a = h[0], b = h[1], c = h[2], d = h[3];
+  juint e = h[4], f = h[5], g = h[6], k = h[7];
+  for (i = 0; i < 64; i++) {
+    const juint t1 = k + (sha256_rotate(e, 6) ^ sha256_rotate(e, 11) ^
+                          sha256_rotate(e, 25)) +
+                     ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+    const juint t2 = (sha256_rotate(a, 2) ^ sha256_rotate(a, 13) ^
+                      sha256_rotate(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    k = g; g = f; f = e; e = d + t1;
+    d = c; c = b; b = a; a = t1 + t2;
+  }
+  h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+  h[4] += e; h[5] += f; h[6] += g; h[7] += k;
+}
+
+struct Sha256 {
+  ClassDigest digest;
+  jubyte      buffer[64];
+  int         buffered;
+  juint       length;
+
+  void initialize() {
+    juint* h = digest.word;
+    h[0] = 0x6a09e667; h[1] = 0xbb67ae85; h[2] = 0x3c6ef372; h[3] = 0xa54ff53a;
+    h[4] = 0x510e527f; h[5] = 0x9b05688c; h[6] = 0x1f83d9ab; h[7] = 0x5be0cd19;
+    buffered = 0;
+    length = 0;
+  }
+
+  void update(const jubyte* data, int count) {
+    length += count;
+    if (buffered > 0) {
+      const int n = count < 64 - buffered ? count : 64 - buffered;
+      jvm_memcpy(buffer + buffered, data, n);
+      buffered += n;
+      data += n;
+      count -= n;
+      if (buffered < 64) {
+        return;
+      }
+      sha256_block(digest.word, buffer);
+      buffered = 0;
+    }
+    for (; count >= 64; count -= 64, data += 64) {
+      sha256_block(digest.word, data);
+    }
+    jvm_memcpy(buffer, data, count);
+    buffered = count;
+  }
+
+  void update(const char* s) {
+    update((const jubyte*)s, jvm_strlen(s) + 1);
+  }
+
+  void update(const juint value) {
+    update((const jubyte*)&value, sizeof value);
+  }
+
+  // Pads the last block(s) with 0x80, zeros and the big-endian bit length
+  void finish(ClassDigest* result) {
+    jubyte tail[128];
+    jvm_memset(tail, 0, sizeof tail);
+    jvm_memcpy(tail, buffer, buffered);
+    tail[buffered] = 0x80;
+    const int tail_length = buffered < 56 ? 64 : 128;
+    const juint bits_lo = length << 3;
+    const juint bits_hi = length >> 29;
+    for (int i = 0; i < 4; i++) {
+      tail[tail_length - 1 - i] = jubyte(bits_lo >> (8 * i));
+      tail[tail_length - 5 - i] = jubyte(bits_hi >> (8 * i));
+    }
+    sha256_block(digest.word, tail);
+    if (tail_length > 64) {
+      sha256_block(digest.word, tail + 64);
+    }
+    *result = digest;
+  }
+};
+
+static void class_digest(const jubyte* data, const int length,
+                         ClassDigest* digest) {
+  Sha256 sha;
+  sha.initialize();
+  sha.update(data, length);
+  sha.finish(digest);
+}
+
+// Copies the next entry of classpath into entry, and returns the
+// position after it, or NULL if there are no more entries.
+static const JvmPathChar* next_classpath_entry(const JvmPathChar* classpath,
+                                               JvmPathChar* entry) {
+  if (*classpath == 0) {
+    return NULL;
+  }
+  while (*classpath != 0 && *classpath != OsFile_path_separator_char) {
+    *entry++ = *classpath++;
+  }
+  *entry = 0;
+  return *classpath == 0 ? classpath : classpath + 1;
+}
+
+static void sha256_update_proc(const jubyte* data, int length, void* param) {
+  ((Sha256*)param)->update(data, length);
+}
+
+// Computes the digest of everything the verification of the application
+// depends on. Returns false if some classpath entry is not a JAR file
+// (e.g., it is a directory), in which case the cache cannot be used.
+static bool classpath_digest(const JvmPathChar* classpath,
+                             ClassDigest* digest) {
+  Sha256 sha;
+  sha.initialize();
+  sha.update(juint(ROM::number_of_system_classes()));
+  sha.update(JVM_RELEASE_VERSION);
+  sha.update(JVM_BUILD_VERSION);
+
+  int length = 0;
+  while (classpath[length] != 0) {
+    length++;
+  }
+  JvmPathChar* entry =
+    (JvmPathChar*)OsMemory_allocate((length + 1) * sizeof(JvmPathChar));
+  if (entry == NULL) {
+    return false;
+  }
+  bool ok = true;
+  while (ok && (classpath = next_classpath_entry(classpath, entry)) != NULL) {
+    if (*entry == 0) {
+      continue;
+    }
+    OsFile_Handle file = OsFile_open(entry, "rb");
+    if (file == NULL) {
+      ok = false;
+      break;
+    }
+    ok = JarFileParser::central_directory_do(file, sha256_update_proc, &sha);
+    sha.update(juint(OsFile_length(file)));
+    OsFile_close(file);
+  }
+  OsMemory_free(entry);
+
+  sha.finish(digest);
+  return ok;
+}
+
+// Returns the name of the cache file of the given classpath, allocated
+// with OsMemory_allocate, or NULL if no cache directory is given.
+static JvmPathChar* verification_cache_file_name(const JvmPathChar* dir,
+                                                 const JvmPathChar* classpath) {
+  if (dir == NULL || classpath == NULL) {
+    return NULL;
+  }
+
+  juint hash = 0;
+  for (const JvmPathChar* p = classpath; *p; p++) {
+    hash = 31 * hash + juint(*p);
+  }
+  char base[] = "cldc_verify_00000000.prf";
+  static const char hex[] = "0123456789abcdef";
+  for (int i = 0; i < 8; i++) {
+    base[19 - i] = hex[(hash >> (4 * i)) & 0xf];
+  }
+
+  int dir_length = 0;
+  while (dir[dir_length] != 0) {
+    dir_length++;
+  }
+  const int base_length = sizeof base - 1;
+  JvmPathChar* name = (JvmPathChar*)
+    OsMemory_allocate((dir_length + base_length + 2) * sizeof(JvmPathChar));
+  if (name == NULL) {
+    return NULL;
+  }
+  JvmPathChar* p = name;
+  for (int i = 0; i < dir_length; i++) {
+    *p++ = dir[i];
+  }
+  if (dir_length > 0 && dir[dir_length - 1] != OsFile_separator_char) {
+    *p++ = OsFile_separator_char;
+  }
+  for (int i = 0; i < base_length; i++) {
+    *p++ = (JvmPathChar)base[i];
+  }
+  *p = 0;
+  return name;
+}
+
+// Makes room for one more element in a table allocated with
+// OsMemory_allocate. Returns the (possibly moved) table, or NULL if out
+// of memory, in which case the old table is left unchanged.
+static void* verification_cache_grow(void* table, const int count,
+                                     int* capacity, const size_t size) {
+  if (count < *capacity) {
+    return table;
+  }
+  const int new_capacity = *capacity == 0 ? 64 : *capacity * 2;
+  void* new_table = OsMemory_allocate(new_capacity * size);
+  if (new_table == NULL) {
+    return NULL;
+  }
+  if (table != NULL) {
+    jvm_memcpy(new_table, table, count * size);
+    OsMemory_free(table);
+  }
+  *capacity = new_capacity;
+  return new_table;
+}
+
+static void verification_cache_dispose() {
+  if (_verified_digests != NULL) {
+    OsMemory_free(_verified_digests);
+    _verified_digests = NULL;
+  }
+  if (_pending_digests != NULL) {
+    OsMemory_free(_pending_digests);
+    _pending_digests = NULL;
+  }
+  _sorted_count = _verified_count = _verified_capacity = 0;
+  _pending_count  = _pending_capacity  = 0;
+  _verified_digests_changed = false;
+  _verification_cache_active = false;
+}
+
+void Verifier::load_cache() {
+  verification_cache_dispose();
+  const JvmPathChar* classpath = Arguments::classpath();
+  if (!UseVerificationCache || Arguments::verification_cache_dir() == NULL ||
+      classpath == NULL || !classpath_digest(classpath, &_classpath_digest)) {
+    return;
+  }
+  _verification_cache_active = true;
+
+  JvmPathChar* name =
+    verification_cache_file_name(Arguments::verification_cache_dir(),
+                                 classpath);
+  if (name == NULL) {
+    _verification_cache_active = false;
+    return;
+  }
+  OsFile_Handle file = OsFile_open(name, "rb");
+  OsMemory_free(name);
+  if (file == NULL) {
+    return;
+  }
+  VerificationCacheHeader header;
+  if (OsFile_read(file, &header, sizeof header, 1) == 1 &&
+      header.magic == juint(VerificationCacheMagic) &&
+      header.classpath_digest.equals(&_classpath_digest) &&
+      header.count != 0 && header.count < 0x100000) {
+    const int count = header.count;
+    ClassDigest* digests =
+      (ClassDigest*)OsMemory_allocate(count * sizeof(ClassDigest));
+    if (digests != NULL) {
+      if (OsFile_read(file, digests, sizeof(ClassDigest), count) ==
+          size_t(count)) {
+        // The file is written sorted; sort it anyway if it is not, since
+        // a binary search over unsorted entries would miss some of them.
+        for (int i = 1; i < count; i++) {
+          if (digests[i - 1].compare(&digests[i]) > 0) {
+            jvm_qsort(digests, count, sizeof(ClassDigest),
+                      compare_class_digests);
+            break;
+          }
+        }
+        _verified_digests  = digests;
+        _sorted_count      = count;
+        _verified_count    = count;
+        _verified_capacity = count;
+      } else {
+        // Discard a truncated cache
+        OsMemory_free(digests);
+      }
+    }
+  }
+  OsFile_close(file);
+
+  if (TraceVerificationCache) {
+    TTY_TRACE_CR(("Verifier: loaded %d class digests from the cache",
+                  _verified_count));
+  }
+}
+
+bool Verifier::is_cached(const jubyte* class_file, const int length,
+                         const int class_id) {
+  if (!_verification_cache_active) {
+    return false;
+  }
+
+  ClassDigest digest;
+  class_digest(class_file, length, &digest);
+  int low = 0;
+  int high = _sorted_count - 1;
+  while (low <= high) {
+    const int middle = (low + high) >> 1;
+    const int result = _verified_digests[middle].compare(&digest);
+    if (result == 0) {
+#if ENABLE_PERFORMANCE_COUNTERS
+      jvm_perf_count.num_of_verify_cache_hits ++;
+#endif
+      return true;
+    }
+    if (result < 0) {
+      low = middle + 1;
+    } else {
+      high = middle - 1;
+    }
+  }
+
+  // Remember the digest until the class has passed verification. A class
+  // whose parsing failed may leave a stale entry behind with its class_id,
+  // which is reused by the next class.
+  int i;
+  for (i = 0; i < _pending_count; i++) {
+    if (_pending_digests[i].class_id == class_id) {
+      break;
+    }
+  }
+  if (i == _pending_count) {
+    PendingDigest* pending = (PendingDigest*)
+      verification_cache_grow(_pending_digests, _pending_count,
+                              &_pending_capacity, sizeof(PendingDigest));
+    if (pending == NULL) {
+      return false;
+    }
+    _pending_digests = pending;
+    _pending_count++;
+  }
+  _pending_digests[i].class_id = class_id;
+  _pending_digests[i].digest   = digest;
+  return false;
+}
+
+void Verifier::record_verified(const InstanceClass* klass) {
+  const int class_id = klass->class_id();
+  for (int i = 0; i < _pending_count; i++) {
+    if (_pending_digests[i].class_id != class_id) {
+      continue;
+    }
+    ClassDigest* verified = (ClassDigest*)
+      verification_cache_grow(_verified_digests, _verified_count,
+                              &_verified_capacity, sizeof(ClassDigest));
+    if (verified != NULL) {
+      _verified_digests = verified;
+      _verified_digests[_verified_count++] = _pending_digests[i].digest;
+      _verified_digests_changed = true;
+    }
+    _pending_digests[i] = _pending_digests[--_pending_count];
+    return;
+  }
+}
+
+void Verifier::save_cache() {
+  if (_verification_cache_active && _verified_digests_changed) {
+    JvmPathChar* name =
+      verification_cache_file_name(Arguments::verification_cache_dir(),
+                                   Arguments::classpath());
+    OsFile_Handle file = name == NULL ? NULL : OsFile_open(name, "wb");
+    if (file != NULL) {
+      jvm_qsort(_verified_digests, _verified_count, sizeof(ClassDigest),
+                compare_class_digests);
+      VerificationCacheHeader header;
+      header.magic            = VerificationCacheMagic;
+      header.count            = _verified_count;
+      header.classpath_digest = _classpath_digest;
+      OsFile_write(file, &header, sizeof header, 1);
+      OsFile_write(file, _verified_digests, sizeof(ClassDigest),
+                   _verified_count);
+      OsFile_close(file);
+
+      if (TraceVerificationCache) {
+        TTY_TRACE_CR(("Verifier: saved %d class digests to the cache",
+                      _verified_count));
+      }
+    }
+    if (name != NULL) {
+      OsMemory_free(name);
+    }
+  }
+  verification_cache_dispose();
+}
+
+void Verifier::remove_cache(const JvmPathChar* dir,
+                            const JvmPathChar* classpath) {
+  JvmPathChar* name = verification_cache_file_name(dir, classpath);
+  if (name != NULL) {
+    if (OsFile_exists(name)) {
+      OsFile_remove(name);
+    }
+    OsMemory_free(name);
+  }
+}
+#endif // ENABLE_VERIFICATION_CACHE
+
 #if ENABLE_VERIFY_ONLY
 
 bool Verifier::verify_classpath() {
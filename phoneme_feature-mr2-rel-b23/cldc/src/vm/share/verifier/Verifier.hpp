@@ -34,6 +34,9 @@ class Verifier {
   static bool _is_cache_active;
   static void verify_class_internal(InstanceClass* klass JVM_TRAPS);
   static int _stackmap_cache_max;
+#if ENABLE_VERIFICATION_CACHE
+  static void record_verified(const InstanceClass* klass);
+#endif
 public:
 
   static bool is_active() {
@@ -53,6 +56,20 @@ public:
   static bool verify_classpath();
 #endif
 
+#if ENABLE_VERIFICATION_CACHE
+  // The verification cache holds the SHA-256 digests of the class files
+  // that passed verification in earlier runs of the same application.
+  // ClassFileParser consults it so that an unchanged class file is marked
+  // as verified without running the verifier again. The cache is dropped
+  // when the classpath contents or the VM change.
+  static void load_cache();
+  static void save_cache();
+  static void remove_cache(const JvmPathChar* dir,
+                           const JvmPathChar* classpath);
+  static bool is_cached(const jubyte* class_file, const int length,
+                        const int class_id);
+#endif
+
   static int stackmap_cache_max() {
     return _stackmap_cache_max;
   }
@@ -259,6 +259,251 @@ ycc_bgrx_convert (j_decompress_ptr cinfo,
 }
 
 
+/**************** YCbCr -> RGB565 conversion **************/
+
+/*
+ * 16 bit RGB565, one native-endian UINT16 per pixel: the output rows hold
+ * two JSAMPLEs per pixel and must be UINT16-aligned.  The 8-bit R, G and B
+ * values are computed exactly as above and then truncated to 5, 6 and 5
+ * bits.
+ */
+
+#define PACK_RGB565(r,g,b)  \
+    ((UINT16) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+
+#if defined(JPEG_SIMD_SSE2) && BITS_IN_JSAMPLE == 8
+
+#include <emmintrin.h>
+
+/*
+ * Convert eight pixels.  The table entries above are recomputed with
+ * 16x16->32 bit multiply-adds: constants that do not fit in 16 bits are
+ * split as FIX(1.40200) = 1<<16 + rest, FIX(1.77200) = 2<<16 + rest, and
+ * Cr is doubled so that FIX(0.71414)/2 fits.  The results are identical.
+ */
+
+INLINE LOCAL(__m128i)
+ycc_rgb565_simd (__m128i y, __m128i cb, __m128i cr)
+{
+  const __m128i two = _mm_set1_epi16(2);
+  const __m128i crr_k = _mm_setr_epi16(
+    (short) (FIX(1.40200) - (1L<<SCALEBITS)), (short) (ONE_HALF/2),
+    (short) (FIX(1.40200) - (1L<<SCALEBITS)), (short) (ONE_HALF/2),
+    (short) (FIX(1.40200) - (1L<<SCALEBITS)), (short) (ONE_HALF/2),
+    (short) (FIX(1.40200) - (1L<<SCALEBITS)), (short) (ONE_HALF/2));
+  const __m128i cbb_k = _mm_setr_epi16(
+    (short) (FIX(1.77200) - (2L<<SCALEBITS)), (short) (ONE_HALF/2),
+    (short) (FIX(1.77200) - (2L<<SCALEBITS)), (short) (ONE_HALF/2),
+    (short) (FIX(1.77200) - (2L<<SCALEBITS)), (short) (ONE_HALF/2),
+    (short) (FIX(1.77200) - (2L<<SCALEBITS)), (short) (ONE_HALF/2));
+  const __m128i g_k = _mm_setr_epi16(
+    (short) (- FIX(0.34414)), (short) (- FIX(0.71414) / 2),
+    (short) (- FIX(0.34414)), (short) (- FIX(0.71414) / 2),
+    (short) (- FIX(0.34414)), (short) (- FIX(0.71414) / 2),
+    (short) (- FIX(0.34414)), (short) (- FIX(0.71414) / 2));
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  const __m128i maxval = _mm_set1_epi16(MAXJSAMPLE);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lo, hi, cr2, r, g, b;
+
+  /* R = Y + Cr + ((rest * Cr + ONE_HALF) >> 16) */
+  lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cr, two), crr_k),
+		      SCALEBITS);
+  hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cr, two), crr_k),
+		      SCALEBITS);
+  r = _mm_add_epi16(_mm_add_epi16(y, cr), _mm_packs_epi32(lo, hi));
+
+  /* B = Y + 2 * Cb + ((rest * Cb + ONE_HALF) >> 16) */
+  lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, two), cbb_k),
+		      SCALEBITS);
+  hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, two), cbb_k),
+		      SCALEBITS);
+  b = _mm_add_epi16(_mm_add_epi16(y, _mm_add_epi16(cb, cb)),
+		    _mm_packs_epi32(lo, hi));
+
+  /* G = Y + ((- FIX(0.34414) * Cb - FIX(0.71414) * Cr + ONE_HALF) >> 16) */
+  cr2 = _mm_add_epi16(cr, cr);
+  lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(
+			_mm_unpacklo_epi16(cb, cr2), g_k), half), SCALEBITS);
+  hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(
+			_mm_unpackhi_epi16(cb, cr2), g_k), half), SCALEBITS);
+  g = _mm_add_epi16(y, _mm_packs_epi32(lo, hi));
+
+  /* Range-limit to 0..MAXJSAMPLE, as range_limit[] does */
+  r = _mm_min_epi16(_mm_max_epi16(r, zero), maxval);
+  g = _mm_min_epi16(_mm_max_epi16(g, zero), maxval);
+  b = _mm_min_epi16(_mm_max_epi16(b, zero), maxval);
+
+  return _mm_or_si128(_mm_or_si128(
+	   _mm_slli_epi16(_mm_and_si128(r, _mm_set1_epi16(0xF8)), 8),
+	   _mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xFC)), 3)),
+	 _mm_srli_epi16(b, 3));
+}
+
+#define SIMD_PIXELS  8
+
+#define YCC_RGB565_SIMD(outptr,inptr0,inptr1,inptr2)  { \
+    const __m128i center = _mm_set1_epi16(CENTERJSAMPLE); \
+    __m128i y_ = _mm_unpacklo_epi8( \
+	_mm_loadl_epi64((const __m128i *) (inptr0)), _mm_setzero_si128()); \
+    __m128i cb_ = _mm_sub_epi16(_mm_unpacklo_epi8( \
+	_mm_loadl_epi64((const __m128i *) (inptr1)), _mm_setzero_si128()), \
+	center); \
+    __m128i cr_ = _mm_sub_epi16(_mm_unpacklo_epi8( \
+	_mm_loadl_epi64((const __m128i *) (inptr2)), _mm_setzero_si128()), \
+	center); \
+    _mm_storeu_si128((__m128i *) (outptr), ycc_rgb565_simd(y_, cb_, cr_)); }
+
+#elif defined(JPEG_SIMD_NEON) && BITS_IN_JSAMPLE == 8
+
+#include <arm_neon.h>
+
+/*
+ * Convert eight pixels.  NEON has a 32x32-bit multiply-accumulate, so the
+ * table arithmetic above is applied directly to the widened samples.
+ */
+
+INLINE LOCAL(uint16x8_t)
+ycc_rgb565_simd (uint8x8_t y8, uint8x8_t cb8, uint8x8_t cr8)
+{
+  const int16x8_t center = vdupq_n_s16(CENTERJSAMPLE);
+  int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(y8));
+  int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb8)), center);
+  int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr8)), center);
+  int32x4_t cbl = vmovl_s16(vget_low_s16(cb)), cbh = vmovl_s16(vget_high_s16(cb));
+  int32x4_t crl = vmovl_s16(vget_low_s16(cr)), crh = vmovl_s16(vget_high_s16(cr));
+  const int32x4_t half = vdupq_n_s32(ONE_HALF);
+  int16x8_t r, g, b;
+  uint8x8_t r8, g8, b8;
+
+  r = vaddq_s16(y, vcombine_s16(
+	vshrn_n_s32(vmlaq_n_s32(half, crl, FIX(1.40200)), SCALEBITS),
+	vshrn_n_s32(vmlaq_n_s32(half, crh, FIX(1.40200)), SCALEBITS)));
+  b = vaddq_s16(y, vcombine_s16(
+	vshrn_n_s32(vmlaq_n_s32(half, cbl, FIX(1.77200)), SCALEBITS),
+	vshrn_n_s32(vmlaq_n_s32(half, cbh, FIX(1.77200)), SCALEBITS)));
+  g = vaddq_s16(y, vcombine_s16(
+	vshrn_n_s32(vmlaq_n_s32(vmlaq_n_s32(half, cbl, - FIX(0.34414)),
+				crl, - FIX(0.71414)), SCALEBITS),
+	vshrn_n_s32(vmlaq_n_s32(vmlaq_n_s32(half, cbh, - FIX(0.34414)),
+				crh, - FIX(0.71414)), SCALEBITS)));
+
+  /* Range-limit to 0..MAXJSAMPLE, as range_limit[] does */
+  r8 = vqmovun_s16(r);
+  g8 = vqmovun_s16(g);
+  b8 = vqmovun_s16(b);
+
+  return vorrq_u16(vorrq_u16(
+	   vshll_n_u8(vand_u8(r8, vdup_n_u8(0xF8)), 8),
+	   vshll_n_u8(vand_u8(g8, vdup_n_u8(0xFC)), 3)),
+	 vmovl_u8(vshr_n_u8(b8, 3)));
+}
+
+#define SIMD_PIXELS  8
+
+#define YCC_RGB565_SIMD(outptr,inptr0,inptr1,inptr2)  \
+    vst1q_u16((uint16_t *) (outptr), \
+	      ycc_rgb565_simd(vld1_u8(inptr0), vld1_u8(inptr1), vld1_u8(inptr2)))
+
+#endif /* JPEG_SIMD_SSE2 / JPEG_SIMD_NEON */
+
+
+METHODDEF(void)
+ycc_rgb565_convert (j_decompress_ptr cinfo,
+		    JSAMPIMAGE input_buf, JDIMENSION input_row,
+		    JSAMPARRAY output_buf, int num_rows)
+{
+  my_cconvert_ptr cconvert = (my_cconvert_ptr) cinfo->cconvert;
+  register int y, cb, cr;
+  register UINT16 * outptr;
+  register JSAMPROW inptr0, inptr1, inptr2;
+  register JDIMENSION col;
+  JDIMENSION num_cols = cinfo->output_width;
+  /* copy these pointers into registers if possible */
+  register JSAMPLE * range_limit = cinfo->sample_range_limit;
+  register int * Crrtab = cconvert->Cr_r_tab;
+  register int * Cbbtab = cconvert->Cb_b_tab;
+  register INT32 * Crgtab = cconvert->Cr_g_tab;
+  register INT32 * Cbgtab = cconvert->Cb_g_tab;
+  SHIFT_TEMPS
+
+  while (--num_rows >= 0) {
+    inptr0 = input_buf[0][input_row];
+    inptr1 = input_buf[1][input_row];
+    inptr2 = input_buf[2][input_row];
+    input_row++;
+    outptr = (UINT16 *) *output_buf++;
+    col = 0;
+#ifdef SIMD_PIXELS
+    for (; col + SIMD_PIXELS <= num_cols; col += SIMD_PIXELS) {
+      YCC_RGB565_SIMD(outptr + col, inptr0 + col, inptr1 + col, inptr2 + col);
+    }
+#endif
+    for (; col < num_cols; col++) {
+      y  = GETJSAMPLE(inptr0[col]);
+      cb = GETJSAMPLE(inptr1[col]);
+      cr = GETJSAMPLE(inptr2[col]);
+      outptr[col] = PACK_RGB565(range_limit[y + Crrtab[cr]],
+				range_limit[y +
+					    ((int) RIGHT_SHIFT(Cbgtab[cb] +
+							       Crgtab[cr],
+							       SCALEBITS))],
+				range_limit[y + Cbbtab[cb]]);
+    }
+  }
+}
+
+
+/*
+ * Grayscale and RGB sources to RGB565.
+ */
+
+METHODDEF(void)
+gray_rgb565_convert (j_decompress_ptr cinfo,
+		     JSAMPIMAGE input_buf, JDIMENSION input_row,
+		     JSAMPARRAY output_buf, int num_rows)
+{
+  register JSAMPROW inptr;
+  register UINT16 * outptr;
+  register JDIMENSION col;
+  register int v;
+  JDIMENSION num_cols = cinfo->output_width;
+
+  while (--num_rows >= 0) {
+    inptr = input_buf[0][input_row++];
+    outptr = (UINT16 *) *output_buf++;
+    for (col = 0; col < num_cols; col++) {
+      v = GETJSAMPLE(inptr[col]);
+      outptr[col] = PACK_RGB565(v, v, v);
+    }
+  }
+}
+
+METHODDEF(void)
+rgb_rgb565_convert (j_decompress_ptr cinfo,
+		    JSAMPIMAGE input_buf, JDIMENSION input_row,
+		    JSAMPARRAY output_buf, int num_rows)
+{
+  register JSAMPROW inptr0, inptr1, inptr2;
+  register UINT16 * outptr;
+  register JDIMENSION col;
+  JDIMENSION num_cols = cinfo->output_width;
+
+  while (--num_rows >= 0) {
+    inptr0 = input_buf[0][input_row];
+    inptr1 = input_buf[1][input_row];
+    inptr2 = input_buf[2][input_row];
+    input_row++;
+    outptr = (UINT16 *) *output_buf++;
+    for (col = 0; col < num_cols; col++) {
+      outptr[col] = PACK_RGB565(GETJSAMPLE(inptr0[col]),
+				GETJSAMPLE(inptr1[col]),
+				GETJSAMPLE(inptr2[col]));
+    }
+  }
+}
+
+
 /**************** Cases other than YCbCr -> RGB **************/
 
 
@@ -536,6 +781,21 @@ jm_jinit_color_deconverter (j_decompress_ptr cinfo)
       ERREXIT(cinfo, JERR_CONVERSION_NOTIMPL);
     break;
 
+  case JCS_RGB565:
+    cinfo->out_color_components = 2;	/* one UINT16 per pixel */
+    if (cinfo->quantize_colors)
+      ERREXIT(cinfo, JERR_NOTIMPL);
+    if (cinfo->jpeg_color_space == JCS_YCbCr) {
+      cconvert->pub.color_convert = ycc_rgb565_convert;
+      build_ycc_rgb_table(cinfo);
+    } else if (cinfo->jpeg_color_space == JCS_GRAYSCALE) {
+      cconvert->pub.color_convert = gray_rgb565_convert;
+    } else if (cinfo->jpeg_color_space == JCS_RGB) {
+      cconvert->pub.color_convert = rgb_rgb565_convert;
+    } else
+      ERREXIT(cinfo, JERR_CONVERSION_NOTIMPL);
+    break;
+
   case JCS_CMYK:
     cinfo->out_color_components = 4;
     if (cinfo->jpeg_color_space == JCS_YCCK) {
@@ -208,6 +208,9 @@ jm_jpeg_calc_output_dimensions (j_decompress_ptr cinfo)
   case JCS_YCCK:
     cinfo->out_color_components = 4;
     break;
+  case JCS_RGB565:		/* one UINT16 per pixel, see jdcolor.c */
+    cinfo->out_color_components = 2;
+    break;
   default:			/* else must be same colorspace as in file */
     cinfo->out_color_components = cinfo->num_components;
     break;
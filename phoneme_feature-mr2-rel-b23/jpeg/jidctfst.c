@@ -182,6 +182,294 @@
 #endif
 
 
+#if BITS_IN_JSAMPLE == 8 && !defined(USE_ACCURATE_ROUNDING) && \
+    (defined(JPEG_SIMD_SSE2) || defined(JPEG_SIMD_NEON))
+#define IDCT_IFAST_SIMD
+#endif
+
+
+#ifdef IDCT_IFAST_SIMD
+
+/*
+ * Vector primitives.  An IVEC holds four DCTELEMs, so each 1-D pass below
+ * works on four columns (or four rows) at once; a CVEC holds one row of
+ * DCTSIZE coefficients.  The arithmetic is exactly that of the C version:
+ * 32-bit products descaled by a truncating shift.  IFAST_MULT_TYPE is
+ * assumed to be a 32-bit int (the MULTIPLIER default).
+ */
+
+#ifdef JPEG_SIMD_SSE2
+
+#include <emmintrin.h>
+
+typedef __m128i IVEC;
+typedef __m128i CVEC;
+
+/* Low 32 bits of a 32x32-bit product; SSE2 only has the 32x32->64 form */
+
+INLINE LOCAL(IVEC)
+vmul32 (IVEC a, IVEC b)
+{
+  IVEC even = _mm_mul_epu32(a, b);
+  IVEC odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)),
+			    _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+}
+
+/* Multiply by a positive constant below 2^15: with var = hi * 2^16 + lo,
+ * the low 32 bits of the product are lo * const + (hi * const) << 16.
+ */
+
+INLINE LOCAL(IVEC)
+vmultiply (IVEC var, int c)
+{
+  IVEC cc = _mm_set1_epi16((short) c);
+  IVEC lo = _mm_mullo_epi16(var, cc);
+  IVEC hi = _mm_mulhi_epu16(var, cc);
+
+  return _mm_srai_epi32(_mm_add_epi32(lo, _mm_slli_epi32(hi, 16)),
+			CONST_BITS);
+}
+
+#define VADD(a,b)	_mm_add_epi32(a, b)
+#define VSUB(a,b)	_mm_sub_epi32(a, b)
+#define VZERO()		_mm_setzero_si128()
+#define VMULTIPLY(var,const)  vmultiply(var, (int) (const))
+
+#define CLOAD(coefptr)	_mm_loadu_si128((const __m128i *) (coefptr))
+#define COR(a,b)	_mm_or_si128(a, b)
+#define CDROP_DC(c)	_mm_srli_si128(c, 2)
+#define CIS_ZERO(c)  \
+	(_mm_movemask_epi8(_mm_cmpeq_epi16(c, _mm_setzero_si128())) == 0xFFFF)
+#define CIS_ZERO_RIGHT(c)  \
+	((_mm_movemask_epi8(_mm_cmpeq_epi16(c, _mm_setzero_si128())) \
+	  & 0xFF00) == 0xFF00)
+
+/* Dequantize columns 0-3 (lo) and 4-7 (hi) of a row of coefficients */
+#define DEQUANTIZE_LO(c,quantptr)  \
+	vmul32(_mm_srai_epi32(_mm_unpacklo_epi16(c, c), 16), \
+	       _mm_loadu_si128((const __m128i *) (quantptr)))
+#define DEQUANTIZE_HI(c,quantptr)  \
+	vmul32(_mm_srai_epi32(_mm_unpackhi_epi16(c, c), 16), \
+	       _mm_loadu_si128((const __m128i *) ((quantptr) + 4)))
+
+#define VTRANSPOSE4(a,b,c,d)  { \
+	IVEC t0_ = _mm_unpacklo_epi32(a, b), t1_ = _mm_unpacklo_epi32(c, d); \
+	IVEC t2_ = _mm_unpackhi_epi32(a, b), t3_ = _mm_unpackhi_epi32(c, d); \
+	a = _mm_unpacklo_epi64(t0_, t1_); b = _mm_unpackhi_epi64(t0_, t1_); \
+	c = _mm_unpacklo_epi64(t2_, t3_); d = _mm_unpackhi_epi64(t2_, t3_); }
+
+/* range_limit[IDESCALE(x, PASS1_BITS+3) & RANGE_MASK], minus the final clamp:
+ * sign-extend the masked value from ten bits, then recenter.
+ */
+#define VDESCALE(x)  \
+	_mm_add_epi32(_mm_sub_epi32(_mm_xor_si128(_mm_and_si128( \
+		_mm_srai_epi32(x, PASS1_BITS+3), _mm_set1_epi32(RANGE_MASK)), \
+		_mm_set1_epi32(RANGE_MASK/2 + 1)), \
+		_mm_set1_epi32(RANGE_MASK/2 + 1)), \
+		_mm_set1_epi32(CENTERJSAMPLE))
+
+/* Clamp columns 0-3 and 4-7 of a row to 0..MAXJSAMPLE and store them */
+#define VSTORE_ROW(outptr,lo,hi)  \
+	_mm_storel_epi64((__m128i *) (outptr), \
+		_mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128()))
+
+#else /* JPEG_SIMD_NEON */
+
+#include <arm_neon.h>
+
+typedef int32x4_t IVEC;
+typedef int16x8_t CVEC;
+
+#define VADD(a,b)	vaddq_s32(a, b)
+#define VSUB(a,b)	vsubq_s32(a, b)
+#define VZERO()		vdupq_n_s32(0)
+#define VMULTIPLY(var,const)  \
+	vshrq_n_s32(vmulq_n_s32(var, (int32_t) (const)), CONST_BITS)
+
+#define CLOAD(coefptr)	vld1q_s16((const int16_t *) (coefptr))
+#define COR(a,b)	vorrq_s16(a, b)
+#define CDROP_DC(c)	vextq_s16(c, vdupq_n_s16(0), 1)
+#define CIS_ZERO(c)  \
+	(vget_lane_u64(vreinterpret_u64_s16( \
+		vorr_s16(vget_low_s16(c), vget_high_s16(c))), 0) == 0)
+#define CIS_ZERO_RIGHT(c)  \
+	(vget_lane_u64(vreinterpret_u64_s16(vget_high_s16(c)), 0) == 0)
+
+#define DEQUANTIZE_LO(c,quantptr)  \
+	vmulq_s32(vmovl_s16(vget_low_s16(c)), \
+		  vld1q_s32((const int32_t *) (quantptr)))
+#define DEQUANTIZE_HI(c,quantptr)  \
+	vmulq_s32(vmovl_s16(vget_high_s16(c)), \
+		  vld1q_s32((const int32_t *) (quantptr) + 4))
+
+#define VTRANSPOSE4(a,b,c,d)  { \
+	int32x4x2_t t0_ = vtrnq_s32(a, b), t1_ = vtrnq_s32(c, d); \
+	a = vcombine_s32(vget_low_s32(t0_.val[0]), vget_low_s32(t1_.val[0])); \
+	b = vcombine_s32(vget_low_s32(t0_.val[1]), vget_low_s32(t1_.val[1])); \
+	c = vcombine_s32(vget_high_s32(t0_.val[0]), vget_high_s32(t1_.val[0])); \
+	d = vcombine_s32(vget_high_s32(t0_.val[1]), vget_high_s32(t1_.val[1])); }
+
+#define VDESCALE(x)  \
+	vaddq_s32(vsubq_s32(veorq_s32(vandq_s32( \
+		vshrq_n_s32(x, PASS1_BITS+3), vdupq_n_s32(RANGE_MASK)), \
+		vdupq_n_s32(RANGE_MASK/2 + 1)), \
+		vdupq_n_s32(RANGE_MASK/2 + 1)), \
+		vdupq_n_s32(CENTERJSAMPLE))
+
+#define VSTORE_ROW(outptr,lo,hi)  \
+	vst1_u8((uint8_t *) (outptr), \
+		vqmovun_s16(vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))))
+
+#endif /* JPEG_SIMD_SSE2 */
+
+
+/*
+ * One 1-D IDCT on eight vectors, in place.  Identical to the column and
+ * row passes of the C version below.
+ */
+
+INLINE LOCAL(void)
+vidct_1d (IVEC * v)
+{
+  IVEC tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+  IVEC tmp10, tmp11, tmp12, tmp13;
+  IVEC z5, z10, z11, z12, z13;
+
+  /* Even part */
+
+  tmp10 = VADD(v[0], v[4]);	/* phase 3 */
+  tmp11 = VSUB(v[0], v[4]);
+
+  tmp13 = VADD(v[2], v[6]);	/* phases 5-3 */
+  tmp12 = VSUB(VMULTIPLY(VSUB(v[2], v[6]), FIX_1_414213562), tmp13);
+
+  tmp0 = VADD(tmp10, tmp13);	/* phase 2 */
+  tmp3 = VSUB(tmp10, tmp13);
+  tmp1 = VADD(tmp11, tmp12);
+  tmp2 = VSUB(tmp11, tmp12);
+
+  /* Odd part */
+
+  z13 = VADD(v[5], v[3]);	/* phase 6 */
+  z10 = VSUB(v[5], v[3]);
+  z11 = VADD(v[1], v[7]);
+  z12 = VSUB(v[1], v[7]);
+
+  tmp7 = VADD(z11, z13);	/* phase 5 */
+  tmp11 = VMULTIPLY(VSUB(z11, z13), FIX_1_414213562);
+
+  z5 = VMULTIPLY(VADD(z10, z12), FIX_1_847759065);
+  tmp10 = VSUB(VMULTIPLY(z12, FIX_1_082392200), z5);
+  /* z10 * -c == -z10 * c, even when -z10 wraps */
+  tmp12 = VADD(VMULTIPLY(VSUB(VZERO(), z10), FIX_2_613125930), z5);
+
+  tmp6 = VSUB(tmp12, tmp7);	/* phase 2 */
+  tmp5 = VSUB(tmp11, tmp6);
+  tmp4 = VADD(tmp10, tmp5);
+
+  v[0] = VADD(tmp0, tmp7);
+  v[7] = VSUB(tmp0, tmp7);
+  v[1] = VADD(tmp1, tmp6);
+  v[6] = VSUB(tmp1, tmp6);
+  v[2] = VADD(tmp2, tmp5);
+  v[5] = VSUB(tmp2, tmp5);
+  v[4] = VADD(tmp3, tmp4);
+  v[3] = VSUB(tmp3, tmp4);
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients.
+ */
+
+GLOBAL(void)
+jm_jpeg_idct_ifast (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+		 JCOEFPTR coef_block,
+		 JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  IFAST_MULT_TYPE * quantptr = (IFAST_MULT_TYPE *) compptr->dct_table;
+  CVEC coef[DCTSIZE];
+  CVEC acbits;
+  IVEC left[DCTSIZE];		/* columns 0-3 of each row */
+  IVEC right[DCTSIZE];		/* columns 4-7 of each row */
+  IVEC ws[DCTSIZE];
+  JSAMPROW outptr;
+  int ctr, row;
+  ISHIFT_TEMPS			/* for IDESCALE */
+
+  coef[0] = CLOAD(coef_block);
+  acbits = CDROP_DC(coef[0]);
+  for (ctr = 1; ctr < DCTSIZE; ctr++) {
+    coef[ctr] = CLOAD(coef_block + ctr * DCTSIZE);
+    acbits = COR(acbits, coef[ctr]);
+  }
+
+  /* A block with no AC terms is flat; this is what the C version's
+   * zero column and zero row tests reduce it to.
+   */
+  if (CIS_ZERO(acbits)) {
+    JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+    JSAMPLE dcval = range_limit[IDESCALE((int) DEQUANTIZE(coef_block[0],
+					     quantptr[0]), PASS1_BITS+3)
+				& RANGE_MASK];
+
+    for (ctr = 0; ctr < DCTSIZE; ctr++) {
+      outptr = output_buf[ctr] + output_col;
+      outptr[0] = dcval;
+      outptr[1] = dcval;
+      outptr[2] = dcval;
+      outptr[3] = dcval;
+      outptr[4] = dcval;
+      outptr[5] = dcval;
+      outptr[6] = dcval;
+      outptr[7] = dcval;
+    }
+    return;
+  }
+
+  /* Pass 1: process columns from input, four at a time. */
+  /* Columns 4-7 are commonly all zero, and then so is their output. */
+
+  for (ctr = 0; ctr < DCTSIZE; ctr++)
+    left[ctr] = DEQUANTIZE_LO(coef[ctr], quantptr + ctr * DCTSIZE);
+  vidct_1d(left);
+
+  if (CIS_ZERO_RIGHT(COR(acbits, coef[0]))) {
+    for (ctr = 0; ctr < DCTSIZE; ctr++)
+      right[ctr] = VZERO();
+  } else {
+    for (ctr = 0; ctr < DCTSIZE; ctr++)
+      right[ctr] = DEQUANTIZE_HI(coef[ctr], quantptr + ctr * DCTSIZE);
+    vidct_1d(right);
+  }
+
+  /* Pass 2: process rows from the work vectors, four at a time. */
+  /* Transpose so each vector holds one column of four rows, and back. */
+
+  for (row = 0; row < DCTSIZE; row += 4) {
+    for (ctr = 0; ctr < 4; ctr++) {
+      ws[ctr] = left[row + ctr];
+      ws[ctr + 4] = right[row + ctr];
+    }
+    VTRANSPOSE4(ws[0], ws[1], ws[2], ws[3]);
+    VTRANSPOSE4(ws[4], ws[5], ws[6], ws[7]);
+
+    vidct_1d(ws);
+
+    for (ctr = 0; ctr < DCTSIZE; ctr++)
+      ws[ctr] = VDESCALE(ws[ctr]);
+    VTRANSPOSE4(ws[0], ws[1], ws[2], ws[3]);
+    VTRANSPOSE4(ws[4], ws[5], ws[6], ws[7]);
+
+    for (ctr = 0; ctr < 4; ctr++)
+      VSTORE_ROW(output_buf[row + ctr] + output_col, ws[ctr], ws[ctr + 4]);
+  }
+}
+
+#else /* !IDCT_IFAST_SIMD */
+
 /*
  * Perform dequantization and inverse DCT on one block of coefficients.
  */
@@ -387,4 +675,6 @@ jm_jpeg_idct_ifast (j_decompress_ptr cinfo, jpeg_component_info * compptr,
   }
 }
 
+#endif /* IDCT_IFAST_SIMD */
+
 #endif /* DCT_IFAST_SUPPORTED */
@@ -366,6 +366,21 @@ typedef int boolean;
 #endif
 
 
+/* When the compiler targets SSE2 or NEON, the fast integer IDCT (jidctfst.c)
+ * and the YCbCr->RGB565 conversion (jdcolor.c) use vector intrinsics that
+ * produce bit-identical results to the C code.  Define NO_JPEG_SIMD to
+ * build the plain C versions only.
+ */
+
+#ifndef NO_JPEG_SIMD
+#if defined(__SSE2__)
+#define JPEG_SIMD_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define JPEG_SIMD_NEON
+#endif
+#endif
+
+
 /* FAST_FLOAT should be either float or double, whichever is done faster
  * by your compiler.  (Note that this type is only used in the floating point
  * DCT routines, so it only matters if you've defined DCT_FLOAT_SUPPORTED.)
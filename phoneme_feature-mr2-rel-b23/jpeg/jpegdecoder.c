@@ -421,6 +421,42 @@ JPEG_To_RGB_decodeHeader(void *info,
     return 1;
 }
 
+int
+JPEG_To_RGB_decodeHeaderScaled(void *info,
+    char *inData, int inDataLen, int scaleDenom,
+    int* width, int* height)
+{
+    struct jpeg_decompress_struct *cinfo =
+	(struct jpeg_decompress_struct*) info;
+    struct jmf_error_mgr2 *jerr = (struct jmf_error_mgr2 *) cinfo->err;
+
+    if (scaleDenom != 1 && scaleDenom != 2 &&
+        scaleDenom != 4 && scaleDenom != 8) {
+        return 0;
+    }
+
+    if (JPEG_To_RGB_decodeHeader(info, inData, inDataLen,
+                                 width, height) == 0) {
+        return 0;
+    }
+
+    /* Establish the setjmp return context for jmf_error_exit to use. */
+    if (setjmp(jerr->setjmp_buffer)) {
+        /* If we get here, the JPEG code has signaled an error. */
+        return 0;
+    }
+
+    /* jidctred.c produces 4x4, 2x2 or 1x1 pixels from each 8x8 block */
+    cinfo->scale_num = 1;
+    cinfo->scale_denom = scaleDenom;
+    jm_jpeg_calc_output_dimensions(cinfo);
+
+    *width = cinfo->output_width;
+    *height = cinfo->output_height;
+
+    return 1;
+}
+
 int
 JPEG_To_RGB_decodeData(void *info, char *outData)
 {
@@ -492,9 +528,14 @@ int JPEG_To_RGB_decodeData2(void *info, char *outData, int outPixelSize,
     	return 0;
     }
 
-    /* currently we support only one output format = 24-bit RGB */
-    pixelSize = 3;
-    cinfo->out_color_space = JCS_RGB;
+    /* 16-bit pixels are produced directly, others from 24-bit RGB */
+    if (2 == outPixelSize) {
+        pixelSize = 2;
+        cinfo->out_color_space = JCS_RGB565;
+    } else {
+        pixelSize = 3;
+        cinfo->out_color_space = JCS_RGB;
+    }
     
     jm_jpeg_start_decompress(cinfo);
 
@@ -528,16 +569,21 @@ int JPEG_To_RGB_decodeData2(void *info, char *outData, int outPixelSize,
 
         if ((cinfo->output_scanline > (unsigned)top) && 
             (cinfo->output_scanline <= (unsigned)bottom)) {
-            /* convert pixels of the line to RGB565 format */
-            for (i = 0; i < cinfo->output_width; i++) {
-                if ((i >= (unsigned)left) && (i < (unsigned)right)) {
-                    unsigned int r = row_pointer[0][i * 3 + 0] & 0xFF;
-                    unsigned int g = row_pointer[0][i * 3 + 1] & 0xFF;
-                    unsigned int b = row_pointer[0][i * 3 + 2] & 0xFF;
-                    if (2 == outPixelSize) {
-                        ((unsigned short*)outDataPtr)[i-(unsigned)left] =
-                            ((b & 0xF8) >> 3) + ((g & 0xFC) << 3) + ((r & 0xF8) << 8);
-                    } else /* if (4 == outPixelSize) */ {
+            if (2 == outPixelSize) {
+                /* the line is already in RGB565 format */
+                if ((unsigned)left < cinfo->output_width) {
+                    i = cinfo->output_width < (unsigned)right ?
+                        cinfo->output_width : (unsigned)right;
+                    memcpy(outDataPtr, row_pointer[0] + left * 2,
+                           (i - (unsigned)left) * 2);
+                }
+            } else /* if (4 == outPixelSize) */ {
+                /* convert pixels of the line to 32 bit RGB format */
+                for (i = 0; i < cinfo->output_width; i++) {
+                    if ((i >= (unsigned)left) && (i < (unsigned)right)) {
+                        unsigned int r = row_pointer[0][i * 3 + 0] & 0xFF;
+                        unsigned int g = row_pointer[0][i * 3 + 1] & 0xFF;
+                        unsigned int b = row_pointer[0][i * 3 + 2] & 0xFF;
                         ((unsigned long*)outDataPtr)[i-(unsigned)left] =
                             (b & 0xFF) + ((g & 0xFF) << 8) + ((r & 0xFF) << 16);
                     }
@@ -557,6 +603,80 @@ int JPEG_To_RGB_decodeData2(void *info, char *outData, int outPixelSize,
     return cinfo->output_width * cinfo->output_height * outPixelSize;
 }
 
+int JPEG_To_RGB565_decodeData(void *info, unsigned short *outData,
+    int outWidth, int outHeight)
+{
+    struct jpeg_decompress_struct *cinfo =
+	(struct jpeg_decompress_struct*) info;
+    struct jmf_error_mgr2 *jerr = (struct jmf_error_mgr2 *) cinfo->err;
+    JSAMPROW row_pointer[1];	/* pointer to JSAMPLE row[s] */
+    JSAMPROW volatile scratch = NULL; /* lines that do not fit outData */
+    unsigned int width;
+
+    if (outWidth <= 0 || outHeight <= 0) {
+        return 0;
+    }
+
+    /* Establish the setjmp return context for jmf_error_exit to use. */
+    if (setjmp(jerr->setjmp_buffer)) {
+        /* If we get here, the JPEG code has signaled an error. */
+        return 0;
+    }
+
+    cinfo->out_color_space = JCS_RGB565;
+
+    jm_jpeg_start_decompress(cinfo);
+
+    width = cinfo->output_width < (unsigned)outWidth ?
+        cinfo->output_width : (unsigned)outWidth;
+    if (cinfo->output_width > (unsigned)outWidth ||
+        cinfo->output_height > (unsigned)outHeight) {
+        scratch = (JSAMPROW)pcsl_mem_malloc(cinfo->output_width * 2);
+        if (scratch == NULL) {
+            jm_jpeg_abort_decompress(cinfo);
+            return 0;
+        }
+    }
+
+    /* Establish the setjmp return context for jmf_error_exit to use. */
+    if (setjmp(jerr->setjmp_buffer)) {
+        /* If we get here, the JPEG code has signaled an error. */
+        if (scratch != NULL) {
+            pcsl_mem_free(scratch);
+        }
+        return 0;
+    }
+
+    while (cinfo->output_scanline < cinfo->output_height) {
+        unsigned short *outRow = NULL;
+
+        if (cinfo->output_scanline < (unsigned)outHeight) {
+            outRow = outData + cinfo->output_scanline * outWidth;
+        }
+
+        /* lines that fit are decoded in place */
+        if (outRow != NULL && cinfo->output_width <= (unsigned)outWidth) {
+            row_pointer[0] = (JSAMPROW)outRow;
+            (void) jm_jpeg_read_scanlines(cinfo, row_pointer, 1);
+        } else {
+            row_pointer[0] = scratch;
+            (void) jm_jpeg_read_scanlines(cinfo, row_pointer, 1);
+            if (outRow != NULL) {
+                memcpy(outRow, scratch, width * 2);
+            }
+        }
+    }
+
+    jm_jpeg_finish_decompress(cinfo);
+
+    if (scratch != NULL) {
+        pcsl_mem_free(scratch);
+    }
+
+    return width * (cinfo->output_height < (unsigned)outHeight ?
+        cinfo->output_height : (unsigned)outHeight) * 2;
+}
+
 char*
 JPEG_To_RGB_decode(void *info, char *inData, int inDataLen, 
     int *width, int* height)
@@ -46,6 +46,24 @@ void * JPEG_To_RGB_init();
 int JPEG_To_RGB_decodeHeader(void *info, char *inData, int inDataLen, 
     int* width, int* height);
 
+/**
+ * Decodes a jpeg header and selects a reduced output size.
+ * The image will be decoded with the reduced-size inverse DCT,
+ * so the full size image is never produced.
+ *
+ * @param info handle returned from JPEG_To_RGB_init
+ * @param inData JPEG data
+ * @param inDataLen length of inData
+ * @param scaleDenom 1, 2, 4 or 8: the image is decoded at 1/scaleDenom
+ *        of its size, rounded up
+ * @param width pointer where to store decoded (scaled) image width
+ * @param height pointer where to store decoded (scaled) image height
+ *
+ * @return non-zero on success, zero on failure
+ */
+int JPEG_To_RGB_decodeHeaderScaled(void *info, char *inData, int inDataLen,
+    int scaleDenom, int* width, int* height);
+
 /**
  * Decodes a jpeg data to the provided buffer.
  * Assumes that JPEG_To_RGB_decodeHeader() has been called before,
@@ -77,6 +95,23 @@ int JPEG_To_RGB_decodeData2(void *info, char *outData, int outPixelSize,
     int left, int top, int right, int bottom);
 
 
+/**
+ * Decodes a jpeg data directly to 16 bit (5,6,5) pixels.
+ * Assumes that JPEG_To_RGB_decodeHeader() or
+ * JPEG_To_RGB_decodeHeaderScaled() has been called before.
+ * Decoded pixels outside of outWidth x outHeight are dropped,
+ * and parts of outData not covered by the image are left unchanged.
+ *
+ * @param info handle returned from JPEG_To_RGB_init
+ * @param outData RGB565 image of outWidth x outHeight pixels
+ * @param outWidth width of outData in pixels
+ * @param outHeight height of outData in pixels
+ *
+ * @return size of filled outData bytes, 0 when failed
+ */
+int JPEG_To_RGB565_decodeData(void *info, unsigned short *outData,
+    int outWidth, int outHeight);
+
 /**
  * Decodes a jpeg into the provided buffer.
  * Call JPEG_ToRGB_decodedSize to get the correct size for the image.
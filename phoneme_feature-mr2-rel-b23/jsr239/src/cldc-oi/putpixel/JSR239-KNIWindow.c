@@ -26,6 +26,7 @@
 
 #include <string.h>
 #include <gxj_putpixel.h>
+#include <gxj_screen_buffer.h>
 #include <midp_constants_data.h>
 #include <lcdlf_export.h>
 
@@ -165,6 +166,13 @@ JSR239_putWindowContents(jobject graphicsHandle,
             /* Source data must be in 16bit 565 format. */
             JSR239_memcpy(d, s,
                 dest_width * min_height * sizeof(gxj_pixel_type));
+#if ENABLE_DIRTY_REGIONS
+            /* The copy bypasses the gxj primitives that mark the
+             * changed area of the screen buffer for refresh. */
+            if (d == gxj_system_screen_buffer.pixelData) {
+                gxj_mark_dirty_region(NULL, 0, 0, dest_width, min_height);
+            }
+#endif
         }
     }
 
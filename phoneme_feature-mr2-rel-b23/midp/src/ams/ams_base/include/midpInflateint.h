@@ -133,6 +133,12 @@ typedef struct _InflaterState {
     int outBufferIsAHandle; /* non-zero if decompBuffer is mem handle that
                        must be given to heapObj.addrFromHandle before using */
 
+    /* Sliding window output, see inflateDataToSink */
+    OutputSinkObj* sink;        /* consumer of the output, or NULL */
+    unsigned long outBase;      /* stream offset of outBuffer[0] */
+    unsigned long outFlushed;   /* outBuffer bytes already given to sink */
+    unsigned long outTotal;     /* expected length of the whole output */
+
     int inflateBufferIndex;
     int inflateBufferCount;
     unsigned char inflateBuffer[INFLATEBUFFERSIZE];
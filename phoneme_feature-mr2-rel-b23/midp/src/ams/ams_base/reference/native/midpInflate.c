@@ -42,6 +42,8 @@ static int makeCodeTable(InflaterState *state,
 
 static int inflateHuffman(InflaterState *state, int fixedHuffman);
 static int inflateStored(InflaterState *state);
+static int inflateBlocks(InflaterState *state);
+static int flushOutput(InflaterState *state);
 
 #define INFLATER_EXTRA_BYTES 4
 
@@ -76,13 +78,76 @@ int inflateData(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
     /* The macros LOAD_IN, LOAD_OUT,etc. use a variable called "state" */
     InflaterState stateStruct;
     InflaterState* state = &stateStruct;
-    int result = 0;
 
     state->outBuffer = decompBuffer;
     state->outOffset = 0;
     state->outLength = decompLen;
     state->outBufferIsAHandle = bufferIsAHandle;
 
+    state->sink = NULL;
+    state->outBase = 0;
+    state->outFlushed = 0;
+    state->outTotal = decompLen;
+
+    state->fileState = fileObj->state;
+    state->getBytes = fileObj->read;
+
+    state->heapState = heapManObj->state;
+    state->mallocBytes = heapManObj->alloc;
+    state->freeBytes = heapManObj->free;
+    state->addrFromHandle = heapManObj->addrFromHandle;
+
+    state->inData = 0;
+    state->inDataSize = 0;
+    state->inRemaining = compLen + INFLATER_EXTRA_BYTES;
+
+    state->inflateBufferIndex = 0;
+    state->inflateBufferCount = 0;
+
+    return inflateBlocks(state);
+}
+
+/**
+ * Inflates the data in a file through a sliding window, passing the
+ * uncompressed data to a sink as it is produced instead of keeping
+ * all of it in memory.
+ *
+ * @param fileObj File object for reading the compressed data with the
+ *                current file position set to the beginning of the data
+ * @param heapManObj Heap manager object for temp data
+ * @param compLen Length of the compressed data
+ * @param windowBuffer work buffer for the uncompressed data
+ * @param windowLen size of windowBuffer, must be either at least
+ *        <decompLen> or greater than
+ *        INFLATE_WINDOW_SIZE + INFLATE_MAX_MATCH
+ * @param decompLen Expected length of the uncompressed data
+ * @param sink consumer of the uncompressed data
+ *
+ * @return 0 if the data was decoded and its size is exactly the same
+ *         as <decompLen>, else an error status
+ */
+int inflateDataToSink(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
+                      unsigned char* windowBuffer, int windowLen,
+                      int decompLen, OutputSinkObj* sink) {
+    InflaterState stateStruct;
+    InflaterState* state = &stateStruct;
+    int result;
+
+    if (windowLen < decompLen &&
+            windowLen <= INFLATE_WINDOW_SIZE + INFLATE_MAX_MATCH) {
+        return INFLATE_OUTPUT_OVERFLOW;
+    }
+
+    state->outBuffer = windowBuffer;
+    state->outOffset = 0;
+    state->outLength = (windowLen < decompLen) ? windowLen : decompLen;
+    state->outBufferIsAHandle = 0;
+
+    state->sink = sink;
+    state->outBase = 0;
+    state->outFlushed = 0;
+    state->outTotal = decompLen;
+
     state->fileState = fileObj->state;
     state->getBytes = fileObj->read;
 
@@ -98,6 +163,54 @@ int inflateData(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
     state->inflateBufferIndex = 0;
     state->inflateBufferCount = 0;
 
+    result = inflateBlocks(state);
+    if (result == 0) {
+        /* hand the tail of the data to the sink */
+        result = flushOutput(state);
+    }
+
+    return result;
+}
+
+/**
+ * Gives the output not yet seen by the sink to it and slides the window,
+ * keeping the last INFLATE_WINDOW_SIZE bytes for back references.
+ * Only called when a sink is set.
+ *
+ * @return 0 for success, else INFLATE_SINK_ERROR
+ */
+static int flushOutput(InflaterState *state) {
+    unsigned long offset = state->outOffset;
+    unsigned long keep = (offset < INFLATE_WINDOW_SIZE) ?
+        offset : INFLATE_WINDOW_SIZE;
+    unsigned long remaining;
+
+    if (offset > state->outFlushed) {
+        if (state->sink->write(state->sink->state,
+                               state->outBuffer + state->outFlushed,
+                               (int)(offset - state->outFlushed)) != 0) {
+            return INFLATE_SINK_ERROR;
+        }
+    }
+
+    memmove(state->outBuffer, state->outBuffer + offset - keep, keep);
+    state->outBase += offset - keep;
+    state->outOffset = keep;
+    state->outFlushed = keep;
+
+    /* never let the window run past the expected end of the output */
+    remaining = state->outTotal - state->outBase;
+    if (state->outLength > remaining) {
+        state->outLength = remaining;
+    }
+
+    return 0;
+}
+
+/** Inflates the blocks of the stream described by <state> */
+static int inflateBlocks(InflaterState *state) {
+    int result = 0;
+
     for (; ; ) {
         int type;
         DECLARE_IN_VARIABLES
@@ -138,7 +251,7 @@ int inflateData(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
                 break;
             }
 
-            if (state->outOffset != state->outLength) {
+            if (state->outBase + state->outOffset != state->outTotal) {
                 result = INFLATE_OUTPUT_BIT_ERROR;
                 break;
             }
@@ -171,7 +284,7 @@ static int inflateStored(InflaterState *state) {
         return INFLATE_BAD_LENGTH_FIELD;
     } else if (inRemaining < len) {
         return INFLATE_INPUT_OVERFLOW;
-    } else if (outOffset + len > outLength) {
+    } else if (state->outBase + outOffset + len > state->outTotal) {
         return INFLATE_OUTPUT_OVERFLOW;
     } else {
         int count;
@@ -183,12 +296,29 @@ static int inflateStored(InflaterState *state) {
         }
 
         while (len > 0) {
+            if (outOffset == outLength) {
+                /* only with a sink: the window is full, slide it */
+                int error;
+
+                STORE_OUT;
+                error = flushOutput(state);
+                if (error != 0) {
+                    return error;
+                }
+                LOAD_OUT;
+                outLength = state->outLength;
+            }
+
             if (state->inflateBufferCount > 0) {
                 /* we have data buffered, copy it first */
+                count = (state->inflateBufferCount <= len ?
+                         state->inflateBufferCount : len);
+                if ((unsigned long)count > outLength - outOffset) {
+                    count = outLength - outOffset;
+                }
                 memcpy(&outBuffer[outOffset],
                        &(state->inflateBuffer[state->inflateBufferIndex]),
-                       (count = (state->inflateBufferCount <= len ?
-                                 state->inflateBufferCount : len)));
+                       count);
                 len -= count;
                 (state->inflateBufferCount) -= count;
                 (state->inflateBufferIndex) += count;
@@ -196,7 +326,7 @@ static int inflateStored(InflaterState *state) {
                 inRemaining -= count;
             }
 
-            if (len > 0) {
+            if (len > 0 && outOffset < outLength) {
                 /* need more, refill the buffer */
                 outBuffer[outOffset++] = NEXTBYTE;
                 len--;
@@ -287,6 +417,18 @@ static int inflateHuffman(InflaterState *state, int fixedHuffman) {
         }
 
         if (litxlen <= 255) {
+            if (outOffset == outLength && state->sink != NULL &&
+                    state->outBase + outOffset < state->outTotal) {
+                /* the window is full, slide it */
+                STORE_OUT;
+                error = flushOutput(state);
+                if (error != 0) {
+                    break;
+                }
+                LOAD_OUT;
+                outLength = state->outLength;
+            }
+
             if (outOffset < outLength) {
                 outBuffer[outOffset] = litxlen;
                 outOffset++;
@@ -329,6 +471,18 @@ static int inflateHuffman(InflaterState *state, int fixedHuffman) {
             distance += NEXTBITS(moreBits);
             DUMPBITS(moreBits);
 
+            if (outOffset + length > outLength && state->sink != NULL &&
+                    state->outBase + outOffset + length <= state->outTotal) {
+                /* the window is full, slide it */
+                STORE_OUT;
+                error = flushOutput(state);
+                if (error != 0) {
+                    break;
+                }
+                LOAD_OUT;
+                outLength = state->outLength;
+            }
+
             if (outOffset < distance) {
                 error = INFLATE_COPY_UNDERFLOW;
                 break;
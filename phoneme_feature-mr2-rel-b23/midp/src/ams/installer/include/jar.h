@@ -309,6 +309,62 @@ int inflateData(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
                 unsigned char* decompBuffer, int decompLen,
                 int bufferIsAHandle);
 
+/**
+ * @name OutputSinkObj: consumer of inflated data
+ * @{
+ */
+/**
+ * The write function for OutputSinkObj.
+ * Receives the next piece of the uncompressed data. The data is
+ * only valid during the call and must not be modified.
+ *
+ * @param state the <var>state</var> field of OutputSinkObj
+ * @param data  uncompressed bytes
+ * @param n     number of bytes
+ * @return 0 to continue inflating, non-zero to stop with an error
+ * @see _OutputSinkObj
+ */
+typedef int (*SinkWriteFunction)(void* state, unsigned char* data, int n);
+
+/** The structure that represents a consumer of inflated data. */
+typedef struct _OutputSinkObj {
+    void* state;             /**< consumer state, it gets passed to
+                              * <var>write</var> */
+    SinkWriteFunction write; /**< consume data. @see SinkWriteFunction */
+} OutputSinkObj;
+/** @} */
+
+/** Maximal distance of a back reference in deflated data */
+#define INFLATE_WINDOW_SIZE 32768
+
+/** Maximal length of a back reference in deflated data */
+#define INFLATE_MAX_MATCH 258
+
+/**
+ * Inflates the data in a file through a sliding window, passing the
+ * uncompressed data to a sink as it is produced instead of keeping
+ * all of it in memory.
+ * <p>
+ * The same note about INFLATER_EXTRA_BYTES as for inflateData applies.
+ *
+ * @param fileObj File object for reading the compressed data with the
+ *                current file position set to the beginning of the data
+ * @param heapManObj Heap object for temp data
+ * @param compLen Length of the compressed data
+ * @param windowBuffer work buffer for the uncompressed data
+ * @param windowLen size of windowBuffer, must be either at least
+ *        <decompLen> or greater than
+ *        INFLATE_WINDOW_SIZE + INFLATE_MAX_MATCH
+ * @param decompLen Expected length of the uncompressed data
+ * @param sink consumer of the uncompressed data
+ *
+ * @return 0 if the data was decoded and its size is exactly the same
+ *         as <decompLen>, else an error status
+ */
+int inflateDataToSink(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
+                      unsigned char* windowBuffer, int windowLen,
+                      int decompLen, OutputSinkObj* sink);
+
 /**
  * @name Inflate errors.
  * @{
@@ -331,6 +387,7 @@ int inflateData(FileObj* fileObj, HeapManObj* heapManObj, int compLen,
 #define INFLATE_BAD_REPEAT_CODE            (INFLATE_LEVEL_ERROR - 15)
 #define INFLATE_BAD_CODELENGTH_CODE        (INFLATE_LEVEL_ERROR - 16)
 #define INFLATE_CODE_TABLE_EMPTY           (INFLATE_LEVEL_ERROR - 17)
+#define INFLATE_SINK_ERROR                 (INFLATE_LEVEL_ERROR - 18)
 /** @} */
 
 /**
@@ -37,6 +37,8 @@
 #include <midp_constants_data.h>
 #include <midp_foreground_id.h>
 #include <midp_input_port.h>
+#include <gxj_putpixel.h>
+#include <gxj_screen_buffer.h>
 
 #include <fbapp_export.h>
 #include <fbport_export.h>
@@ -135,6 +137,10 @@ void fbapp_set_fullscreen_mode(int mode) {
             get_screen_width(),
             get_screen_height());
         clearScreen();
+#if ENABLE_DIRTY_REGIONS
+        // The device was cleared, refresh it in full next time
+        gxj_mark_screen_dirty();
+#endif
     }
 }
 
@@ -198,12 +204,31 @@ static void clipRect(int *x1, int *y1, int *x2, int *y2) {
  * @param y2 bottom-right y coordinate of the area to refresh
  */
 void fbapp_refresh(int x1, int y1, int x2, int y2) {
+#if ENABLE_DIRTY_REGIONS
+    gxj_dirty_region regions[GXJ_MAX_DIRTY_REGIONS];
+    int i, n;
+#endif
+
     clipRect(&x1, &y1, &x2, &y2);
+
+#if ENABLE_DIRTY_REGIONS
+    // Copy to the device only what was drawn since the last refresh
+    n = gxj_get_dirty_regions(x1, y1, x2, y2, regions);
+    if (!reverse_orientation) {
+        refreshScreenRegions(regions, n);
+    } else {
+        for (i = 0; i < n; i++) {
+            refreshScreenRotated(regions[i].x1, regions[i].y1,
+                                 regions[i].x2, regions[i].y2);
+        }
+    }
+#else
     if (!reverse_orientation) {
         refreshScreenNormal(x1, y1, x2, y2);
     } else {
         refreshScreenRotated(x1, y1, x2, y2);
     }
+#endif
 }
 
 /**
@@ -293,6 +318,15 @@ void fbapp_map_keycode_to_event(
  * Finalize the fb application native resources.
  */
 void fbapp_finalize() {
+#if ENABLE_DIRTY_REGIONS
+    jlong pixelsDrawn, pixelsFlushed;
+
+    gxj_get_dirty_region_counters(&pixelsDrawn, &pixelsFlushed);
+    REPORT_INFO2(LC_HIGHUI, "Dirty regions: %.0f pixels drawn, "
+                 "%.0f pixels flushed", (double)pixelsDrawn,
+                 (double)pixelsFlushed);
+#endif
+
     clearScreen();
     finalizeFrameBuffer();
 }
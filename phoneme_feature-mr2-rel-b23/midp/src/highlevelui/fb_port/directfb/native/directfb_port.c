@@ -32,6 +32,7 @@
 #include <kni.h>
 #include <midpMalloc.h>
 #include <gxj_putpixel.h>
+#include <gxj_screen_buffer.h>
 #include <directfbapp_export.h>
 
 /** System offscreen buffer */
@@ -105,6 +106,33 @@ void refreshScreenNormal(int x1, int y1, int x2, int y2) {
         (gxj_pixel_type *)directfbapp_refresh(x1, y1, x2, y2);
 }
 
+#if ENABLE_DIRTY_REGIONS
+/**
+ * Refresh screen with the dirty regions of the offscreen buffer. The
+ * back buffer is unlocked, flipped and locked again once for all of
+ * them, as each of these calls may wait for the graphics hardware.
+ */
+void refreshScreenRegions(const gxj_dirty_region *regions, int n) {
+    int i;
+    int x1, y1, x2, y2;
+
+    if (n <= 0) {
+        return;
+    }
+    x1 = regions[0].x1;
+    y1 = regions[0].y1;
+    x2 = regions[0].x2;
+    y2 = regions[0].y2;
+    for (i = 1; i < n; i++) {
+        if (regions[i].x1 < x1) { x1 = regions[i].x1; }
+        if (regions[i].y1 < y1) { y1 = regions[i].y1; }
+        if (regions[i].x2 > x2) { x2 = regions[i].x2; }
+        if (regions[i].y2 > y2) { y2 = regions[i].y2; }
+    }
+    refreshScreenNormal(x1, y1, x2, y2);
+}
+#endif
+
 /** Refresh screen with offscreen buffer content */
 void refreshScreenRotated(int x1, int y1, int x2, int y2) {
     // TODO: Stubbed implementation
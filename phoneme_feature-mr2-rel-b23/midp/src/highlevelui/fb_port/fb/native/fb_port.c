@@ -375,6 +375,17 @@ void refreshScreenNormal(int x1, int y1, int x2, int y2) {
     }
 }
 
+#if ENABLE_DIRTY_REGIONS
+/** Refresh screen with the dirty regions of the offscreen buffer */
+void refreshScreenRegions(const gxj_dirty_region *regions, int n) {
+    int i;
+    for (i = 0; i < n; i++) {
+        refreshScreenNormal(regions[i].x1, regions[i].y1,
+                            regions[i].x2, regions[i].y2);
+    }
+}
+#endif
+
 #if ENABLE_FAST_COPY_ROTATED
 /**
  * Fast rotated copying of screen buffer area to the screen memory.
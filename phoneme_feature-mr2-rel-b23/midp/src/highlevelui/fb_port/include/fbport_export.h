@@ -27,6 +27,8 @@
 #ifndef _FB_PORT_EXPORT_H_
 #define _FB_PORT_EXPORT_H_
 
+#include <gxj_screen_buffer.h>
+
 /**
  * @file
  *
@@ -65,6 +67,14 @@ extern void refreshScreenNormal(int x1, int y1, int x2, int y2);
 /** Refresh rotated screen with offscreen bufer content */
 extern void refreshScreenRotated(int x1, int y1, int x2, int y2);
 
+#if ENABLE_DIRTY_REGIONS
+/**
+ * Refresh screen with the content of the given dirty regions of the
+ * offscreen buffer, all at once
+ */
+extern void refreshScreenRegions(const gxj_dirty_region *regions, int n);
+#endif
+
 /** Return file descriptor of keyboard device, or -1 in none */
 extern int getKeyboardFd();
 
@@ -94,6 +94,78 @@ void gxj_rotate_screen_buffer(jboolean keepContent);
 /** Free memory allocated for screen buffer */
 void gxj_free_screen_buffer();
 
+/**
+ * Track the areas of the system screen buffer changed by the gxj
+ * primitives, so that refresh can copy only those to the device
+ * instead of the whole requested area. Only useful to the ports that
+ * read the dirty regions (the frame buffer application enables it).
+ */
+#ifndef ENABLE_DIRTY_REGIONS
+#define ENABLE_DIRTY_REGIONS 0
+#endif
+
+#if ENABLE_DIRTY_REGIONS
+
+/**
+ * Maximal number of separate dirty rectangles kept for the screen
+ * buffer. Further rectangles are merged into the existing ones.
+ */
+#define GXJ_MAX_DIRTY_REGIONS 8
+
+/** Dirty rectangle of the system screen buffer, x2 and y2 exclusive */
+typedef struct _gxj_dirty_region {
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+} gxj_dirty_region;
+
+/**
+ * Add a rectangle to the dirty area of the system screen buffer.
+ * The gxj primitives call it for what they draw; code that writes
+ * gxj_system_screen_buffer.pixelData directly must call it too.
+ *
+ * @param clip optional clip [x1, y1, x2, y2] to intersect the
+ *   rectangle with, or NULL
+ * @param x1 top-left x coordinate of the changed area
+ * @param y1 top-left y coordinate of the changed area
+ * @param x2 bottom-right x coordinate of the changed area (exclusive)
+ * @param y2 bottom-right y coordinate of the changed area (exclusive)
+ */
+void gxj_mark_dirty_region(const jshort *clip,
+                           int x1, int y1, int x2, int y2);
+
+/** Mark the whole system screen buffer dirty */
+void gxj_mark_screen_dirty();
+
+/**
+ * Get the dirty rectangles of the system screen buffer that intersect
+ * the area requested for refresh, clipped to that area. Rectangles
+ * entirely inside the area are removed from the dirty list; the others
+ * are kept until they get refreshed in full.
+ *
+ * @param x1 top-left x coordinate of the area to refresh
+ * @param y1 top-left y coordinate of the area to refresh
+ * @param x2 bottom-right x coordinate of the area to refresh
+ * @param y2 bottom-right y coordinate of the area to refresh
+ * @param regions array of at least GXJ_MAX_DIRTY_REGIONS elements
+ *   to store the rectangles to refresh
+ * @return number of rectangles stored to regions
+ */
+int gxj_get_dirty_regions(int x1, int y1, int x2, int y2,
+                          gxj_dirty_region *regions);
+
+/**
+ * Get the number of pixels marked dirty and the number of pixels
+ * handed out for refresh since the screen buffer was created.
+ *
+ * @param pixelsDrawn pointer to store the number of pixels drawn
+ * @param pixelsFlushed pointer to store the number of pixels flushed
+ */
+void gxj_get_dirty_region_counters(jlong *pixelsDrawn, jlong *pixelsFlushed);
+
+#endif /* ENABLE_DIRTY_REGIONS */
+
 #ifdef __cplusplus
 }
 #endif
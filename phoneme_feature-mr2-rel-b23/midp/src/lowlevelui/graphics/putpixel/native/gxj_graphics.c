@@ -48,6 +48,7 @@ void
 gx_fill_triangle(int color, const jshort *clip, 
 		  const java_imagedata *dst, int dotted, 
                   int x1, int y1, int x2, int y2, int x3, int y3) {
+  int minX, minY, maxX, maxY;
   gxj_screen_buffer screen_buffer;
   gxj_screen_buffer *sbuf = gxj_get_image_screen_buffer_impl(dst, &screen_buffer, NULL);
   sbuf = (gxj_screen_buffer *)getScreenBuffer(sbuf);
@@ -57,6 +58,12 @@ gx_fill_triangle(int color, const jshort *clip,
   /* Surpress unused parameter warnings */
   (void)dotted;
 
+  minX = (x1 < x2) ? x1 : x2; if (x3 < minX) minX = x3;
+  minY = (y1 < y2) ? y1 : y2; if (y3 < minY) minY = y3;
+  maxX = (x1 > x2) ? x1 : x2; if (x3 > maxX) maxX = x3;
+  maxY = (y1 > y2) ? y1 : y2; if (y3 > maxY) maxY = y3;
+  GXJ_MARK_DIRTY(sbuf, clip, minX, minY, maxX - minX + 1, maxY - minY + 1);
+
   fill_triangle(sbuf, GXJ_RGB24TORGB16(color), 
 		clip, x1, y1, x2, y2, x3, y3);
 }
@@ -72,6 +79,7 @@ gx_copy_area(const jshort *clip,
   gxj_screen_buffer *sbuf = gxj_get_image_screen_buffer_impl(dst, &screen_buffer, NULL);
   sbuf = (gxj_screen_buffer *)getScreenBuffer(sbuf);
 
+  GXJ_MARK_DIRTY(sbuf, clip, x_dest, y_dest, width, height);
   copy_imageregion(sbuf, sbuf, clip, x_dest, y_dest, width, height,
 		   x_src, y_src, 0);
 }
@@ -82,11 +90,10 @@ gx_draw_rgb(const jshort *clip,
 	     const java_imagedata *dst, jint *rgbData,
              jint offset, jint scanlen, jint x, jint y,
              jint width, jint height, jboolean processAlpha) {
-    int a, b;
+    int x1, y1, x2, y2;
     int sbufWidth;
-
-    int dataRowIndex = 0;
-    int sbufRowIndex = 0;
+    const jint *srcRow;
+    gxj_pixel_type *dstRow;
 
     gxj_screen_buffer screen_buffer;
     const jshort clipX1 = clip[0];
@@ -101,39 +108,24 @@ gx_draw_rgb(const jshort *clip,
     REPORT_CALL_TRACE(LC_LOWUI, "gx_draw_rgb()\n");
 
     CHECK_SBUF_CLIP_BOUNDS(sbuf, clip);
-    sbufRowIndex = y * sbufWidth;
-
-    for (b = y; b < y + height;
-        b++, dataRowIndex += scanlen,
-        sbufRowIndex += sbufWidth) {
-
-        if (b >= clipY2) return;
-        if (b <  clipY1) continue;
-
-        for (a = x; a < x + width; a++) {
-
-            int value = rgbData[offset + (a - x) + dataRowIndex];
-            int idx = sbufRowIndex + a;
-
-            if (a >= clipX2) break;
-            if (a < clipX1) {
-                // JAVA_TRACE("drawRGB:A OutOfBounds %d   %d %d %d %d\n", idx,
-                //     a, b, sbuf->width, sbuf->height);
-            } else {
-                CHECK_PTR_CLIP(sbuf, &(sbuf->pixelData[idx]));
-                if (!processAlpha || ((value & 0xff000000) == 0xff000000)) {
-                    sbuf->pixelData[idx] = GXJ_RGB24TORGB16(value);
-                } else {
-                    unsigned int xA =
-                        GXJ_XAAA8888_FROM_ARGB8888((unsigned int)value);
-                    unsigned int XAInv =
-                        (unsigned int)(((unsigned int)(0xFFFFFFFF)) - xA);
-                    sbuf->pixelData[idx] =
-                        GXJ_RGB24TORGB16((xA & value) |
-                            (XAInv & GXJ_RGB16TORGB24(sbuf->pixelData[idx])));
-                }
-            }
-        } /* loop by rgb data columns */
+
+    /* Clip once, then convert whole spans */
+    x1 = (x < clipX1) ? clipX1 : x;
+    y1 = (y < clipY1) ? clipY1 : y;
+    x2 = (x + width  > clipX2) ? clipX2 : x + width;
+    y2 = (y + height > clipY2) ? clipY2 : y + height;
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    GXJ_MARK_DIRTY(sbuf, NULL, x1, y1, x2 - x1, y2 - y1);
+
+    srcRow = rgbData + offset + (y1 - y) * scanlen + (x1 - x);
+    dstRow = sbuf->pixelData + y1 * sbufWidth + x1;
+    for (; y1 < y2; y1++, srcRow += scanlen, dstRow += sbufWidth) {
+        CHECK_PTR_CLIP(sbuf, dstRow);
+        CHECK_PTR_CLIP(sbuf, dstRow + (x2 - x1) - 1);
+        draw_rgb_span(dstRow, srcRow, x2 - x1, processAlpha);
     } /* loop by rgb data rows */
 }
 
@@ -172,7 +164,10 @@ gx_draw_line(int color, const jshort *clip,
   sbuf = (gxj_screen_buffer *)getScreenBuffer(sbuf);
   
   REPORT_CALL_TRACE(LC_LOWUI, "gx_draw_line()\n");
-  
+
+  GXJ_MARK_DIRTY(sbuf, clip, (x1 < x2) ? x1 : x2, (y1 < y2) ? y1 : y2,
+                 ((x1 < x2) ? x2 - x1 : x1 - x2) + 1,
+                 ((y1 < y2) ? y2 - y1 : y1 - y2) + 1);
   draw_clipped_line(sbuf, pixelColor, lineStyle, clip, x1, y1, x2, y2);
 }
 
@@ -197,6 +192,8 @@ gx_draw_rect(int color, const jshort *clip,
 
   REPORT_CALL_TRACE(LC_LOWUI, "gx_draw_rect()\n");
 
+  GXJ_MARK_DIRTY(sbuf, clip, x, y, width + 1, height + 1);
+
   draw_roundrect(pixelColor, clip, sbuf, lineStyle, x,  y, 
 		 width, height, 0, 0, 0);
 }
@@ -216,18 +213,16 @@ void fast_pixel_set(unsigned * mem, unsigned value, int number_of_pixels)
 }
 #endif
 
-void fastFill_rect(unsigned short color, gxj_screen_buffer *sbuf, int x, int y, int width, int height, int cliptop, int clipbottom) {
+void fastFill_rect(unsigned short color, gxj_screen_buffer *sbuf, int x, int y, int width, int height, const jshort *clip) {
 	int screen_horiz=sbuf->width;
 	unsigned short* raster;
 
-    if (width<=0) {return;}
-	if (x > screen_horiz) { return; }
-	if (y > sbuf->height) { return; }
-	if (x < 0) { width+=x; x=0; }
-	if (y < cliptop) { height+=y-cliptop; y=cliptop; }
-	if (x+width  > screen_horiz) { width=screen_horiz - x; }
-	if (y+height > clipbottom) { height= clipbottom - y; }
-
+	/* clip once, then fill whole spans */
+	if (x < clip[CLIP_X1]) { width+=x-clip[CLIP_X1]; x=clip[CLIP_X1]; }
+	if (y < clip[CLIP_Y1]) { height+=y-clip[CLIP_Y1]; y=clip[CLIP_Y1]; }
+	if (x+width  > clip[CLIP_X2]) { width=clip[CLIP_X2] - x; }
+	if (y+height > clip[CLIP_Y2]) { height=clip[CLIP_Y2] - y; }
+	if (width<=0 || height<=0) {return;}
 
 	raster=sbuf->pixelData + y*screen_horiz+x;
 	for(;height>0;height--) {
@@ -246,16 +241,15 @@ gx_fill_rect(int color, const jshort *clip,
 
   gxj_pixel_type pixelColor = GXJ_RGB24TORGB16(color);
   gxj_screen_buffer screen_buffer;
-  const jshort clipX1 = clip[0];
-  const jshort clipY1 = clip[1];
-  const jshort clipX2 = clip[2];
-  const jshort clipY2 = clip[3];
   gxj_screen_buffer *sbuf = gxj_get_image_screen_buffer_impl(dst, &screen_buffer, NULL);
   sbuf = (gxj_screen_buffer *)getScreenBuffer(sbuf);
 
 
-  if ((clipX1==0)&&(clipX2==sbuf->width)&&(dotted!=DOTTED)) {
-    fastFill_rect(pixelColor, sbuf, x, y, width, height, clipY1, clipY2 );
+  GXJ_MARK_DIRTY(sbuf, clip, x, y, width, height);
+
+  if (dotted!=DOTTED) {
+    CHECK_SBUF_CLIP_BOUNDS(sbuf, clip);
+    fastFill_rect(pixelColor, sbuf, x, y, width, height, clip);
     return;
   }
 
@@ -284,6 +278,8 @@ gx_draw_roundrect(int color, const jshort *clip,
 
   REPORT_CALL_TRACE(LC_LOWUI, "gx_draw_roundrect()\n");
 
+  GXJ_MARK_DIRTY(sbuf, clip, x, y, width + 1, height + 1);
+
   //API of the draw_roundrect requests radius of the arc at the four
   draw_roundrect(pixelColor, clip, sbuf, lineStyle, 
 		 x, y, width, height,
@@ -308,6 +304,8 @@ gx_fill_roundrect(int color, const jshort *clip,
 
   REPORT_CALL_TRACE(LC_LOWUI, "gx_fillround_rect()\n");
 
+  GXJ_MARK_DIRTY(sbuf, clip, x, y, width + 1, height + 1);
+
   draw_roundrect(pixelColor, clip, sbuf, lineStyle, 
 		 x,  y,  width,  height,
 		 1, arcWidth >> 1, arcHeight >> 1);
@@ -334,6 +332,7 @@ gx_draw_arc(int color, const jshort *clip,
   gxj_screen_buffer *sbuf = gxj_get_image_screen_buffer_impl(dst, &screen_buffer, NULL);
   sbuf = (gxj_screen_buffer *)getScreenBuffer(sbuf);
 
+  GXJ_MARK_DIRTY(sbuf, clip, x, y, width + 1, height + 1);
   draw_arc(pixelColor, clip, sbuf, lineStyle, x, y, 
 	   width, height, 0, startAngle, arcAngle);
 }
@@ -359,6 +358,8 @@ gx_fill_arc(int color, const jshort *clip,
 
   REPORT_CALL_TRACE(LC_LOWUI, "gx_fill_arc()\n");
 
+  GXJ_MARK_DIRTY(sbuf, clip, x, y, width + 1, height + 1);
+
   draw_arc(pixelColor, clip, sbuf, lineStyle, 
 	   x, y, width, height, 1, startAngle, arcAngle);
 }
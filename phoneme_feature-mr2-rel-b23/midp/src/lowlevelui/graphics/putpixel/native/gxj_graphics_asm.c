@@ -27,6 +27,14 @@
 #include <gxj_putpixel.h>
 
 #include "gxj_intern_image.h"
+#include "gxj_intern_graphics.h"
+
+#if GXJ_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if GXJ_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 /*
 #pragma O0
@@ -139,6 +147,178 @@ asm volatile(
 }
 #endif
 
+/**
+ * draw_rgb_span - convert a clipped span of ARGB8888 pixels to RGB565
+ * dst:          destination pixels
+ * src:          source ARGB8888 pixels
+ * count:        number of pixels
+ * processAlpha: blend with the destination
+ *
+ * The blend is (A & src) | (~A & dst) per color component, where A is
+ * the source alpha replicated to the component width. An opaque pixel
+ * therefore yields src and a transparent one dst, so the SIMD variants
+ * apply the same formula to all 8 pixels of a group and only branch to
+ * skip groups that are entirely opaque or entirely transparent.
+ */
+#if GXJ_SIMD_SSE2
+static __inline __m128i
+rgb565_from_argb8888_sse2(__m128i lo, __m128i hi) {
+    const __m128i r = _mm_set1_epi32(0x00F80000);
+    const __m128i g = _mm_set1_epi32(0x0000FC00);
+    const __m128i b = _mm_set1_epi32(0x000000F8);
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+
+    lo = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(_mm_and_si128(lo, r), 8),
+                                   _mm_srli_epi32(_mm_and_si128(lo, g), 5)),
+                      _mm_srli_epi32(_mm_and_si128(lo, b), 3));
+    hi = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(_mm_and_si128(hi, r), 8),
+                                   _mm_srli_epi32(_mm_and_si128(hi, g), 5)),
+                      _mm_srli_epi32(_mm_and_si128(hi, b), 3));
+    /* _mm_packs_epi32 saturates signed values: bias into range and back */
+    return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(lo, bias32),
+                                         _mm_sub_epi32(hi, bias32)),
+                         bias16);
+}
+
+static __inline __m128i
+blend_argb8888_sse2(__m128i src, __m128i dst565) {
+    /* GXJ_RGB16TORGB24 */
+    const __m128i dst =
+        _mm_or_si128(
+          _mm_or_si128(
+            _mm_or_si128(
+              _mm_slli_epi32(_mm_and_si128(dst565, _mm_set1_epi32(0x001F)), 3),
+              _mm_srli_epi32(_mm_and_si128(dst565, _mm_set1_epi32(0x001C)), 2)),
+            _mm_or_si128(
+              _mm_slli_epi32(_mm_and_si128(dst565, _mm_set1_epi32(0x07E0)), 5),
+              _mm_srli_epi32(_mm_and_si128(dst565, _mm_set1_epi32(0x0600)), 1))),
+          _mm_or_si128(
+            _mm_slli_epi32(_mm_and_si128(dst565, _mm_set1_epi32(0xF800)), 8),
+            _mm_slli_epi32(_mm_and_si128(dst565, _mm_set1_epi32(0xE000)), 3)));
+    /* GXJ_XAAA8888_FROM_ARGB8888 */
+    const __m128i xA =
+        _mm_or_si128(
+          _mm_or_si128(_mm_srli_epi32(src, 24),
+                       _mm_and_si128(_mm_srli_epi32(src, 16),
+                                     _mm_set1_epi32(0x0000FF00))),
+          _mm_and_si128(_mm_srli_epi32(src, 8), _mm_set1_epi32(0x00FF0000)));
+
+    return _mm_or_si128(_mm_and_si128(xA, src), _mm_andnot_si128(xA, dst));
+}
+#endif
+
+#if GXJ_SIMD_NEON
+static __inline uint32x4_t
+rgb565_bits_neon(uint32x4_t v) {
+    return vorrq_u32(
+             vorrq_u32(
+               vshrq_n_u32(vandq_u32(v, vdupq_n_u32(0x00F80000)), 8),
+               vshrq_n_u32(vandq_u32(v, vdupq_n_u32(0x0000FC00)), 5)),
+             vshrq_n_u32(vandq_u32(v, vdupq_n_u32(0x000000F8)), 3));
+}
+
+static __inline uint32x4_t
+blend_argb8888_neon(uint32x4_t src, uint32x4_t dst565) {
+    /* GXJ_RGB16TORGB24 */
+    const uint32x4_t dst =
+        vorrq_u32(
+          vorrq_u32(
+            vorrq_u32(
+              vshlq_n_u32(vandq_u32(dst565, vdupq_n_u32(0x001F)), 3),
+              vshrq_n_u32(vandq_u32(dst565, vdupq_n_u32(0x001C)), 2)),
+            vorrq_u32(
+              vshlq_n_u32(vandq_u32(dst565, vdupq_n_u32(0x07E0)), 5),
+              vshrq_n_u32(vandq_u32(dst565, vdupq_n_u32(0x0600)), 1))),
+          vorrq_u32(
+            vshlq_n_u32(vandq_u32(dst565, vdupq_n_u32(0xF800)), 8),
+            vshlq_n_u32(vandq_u32(dst565, vdupq_n_u32(0xE000)), 3)));
+    /* GXJ_XAAA8888_FROM_ARGB8888 */
+    const uint32x4_t xA =
+        vorrq_u32(
+          vorrq_u32(vshrq_n_u32(src, 24),
+                    vandq_u32(vshrq_n_u32(src, 16), vdupq_n_u32(0x0000FF00))),
+          vandq_u32(vshrq_n_u32(src, 8), vdupq_n_u32(0x00FF0000)));
+
+    return vbslq_u32(xA, src, dst);
+}
+#endif
+
+void draw_rgb_span(gxj_pixel_type *dst, const jint *src, int count,
+                   jboolean processAlpha) {
+    int i = 0;
+
+#if GXJ_SIMD_SSE2
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 4));
+
+        if (processAlpha) {
+            const __m128i alo = _mm_and_si128(lo, alpha);
+            const __m128i ahi = _mm_and_si128(hi, alpha);
+            if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi32(alo, alpha),
+                                                _mm_cmpeq_epi32(ahi, alpha)))
+                != 0xFFFF) {
+                __m128i d;
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_or_si128(alo, ahi),
+                                                      zero)) == 0xFFFF) {
+                    continue; /* fully transparent */
+                }
+                d = _mm_loadu_si128((const __m128i*)(dst + i));
+                lo = blend_argb8888_sse2(lo, _mm_unpacklo_epi16(d, zero));
+                hi = blend_argb8888_sse2(hi, _mm_unpackhi_epi16(d, zero));
+            }
+        }
+        _mm_storeu_si128((__m128i*)(dst + i),
+                         rgb565_from_argb8888_sse2(lo, hi));
+    }
+#elif GXJ_SIMD_NEON
+    for (; i + 8 <= count; i += 8) {
+        uint32x4_t lo = vld1q_u32((const uint32_t*)(src + i));
+        uint32x4_t hi = vld1q_u32((const uint32_t*)(src + i + 4));
+
+        if (processAlpha) {
+            const uint32x4_t amin = vandq_u32(vshrq_n_u32(lo, 24),
+                                              vshrq_n_u32(hi, 24));
+            const uint32x2_t amin2 = vand_u32(vget_low_u32(amin),
+                                              vget_high_u32(amin));
+            if ((vget_lane_u32(amin2, 0) & vget_lane_u32(amin2, 1)) != 0xFF) {
+                const uint32x4_t amax = vorrq_u32(vshrq_n_u32(lo, 24),
+                                                  vshrq_n_u32(hi, 24));
+                const uint32x2_t amax2 = vorr_u32(vget_low_u32(amax),
+                                                  vget_high_u32(amax));
+                uint16x8_t d;
+                if ((vget_lane_u32(amax2, 0) | vget_lane_u32(amax2, 1)) == 0) {
+                    continue; /* fully transparent */
+                }
+                d = vld1q_u16(dst + i);
+                lo = blend_argb8888_neon(lo, vmovl_u16(vget_low_u16(d)));
+                hi = blend_argb8888_neon(hi, vmovl_u16(vget_high_u16(d)));
+            }
+        }
+        vst1q_u16(dst + i, vcombine_u16(vmovn_u32(rgb565_bits_neon(lo)),
+                                        vmovn_u32(rgb565_bits_neon(hi))));
+    }
+#endif
+
+    for (; i < count; i++) {
+        const int value = src[i];
+        if (!processAlpha || ((value & 0xff000000) == 0xff000000)) {
+            dst[i] = GXJ_RGB24TORGB16(value);
+        } else {
+            unsigned int xA =
+                GXJ_XAAA8888_FROM_ARGB8888((unsigned int)value);
+            unsigned int XAInv =
+                (unsigned int)(((unsigned int)(0xFFFFFFFF)) - xA);
+            dst[i] = GXJ_RGB24TORGB16((xA & value) |
+                                      (XAInv & GXJ_RGB16TORGB24(dst[i])));
+        }
+    }
+}
+
 /**
  * unclippedBlit - low level simple blit of 16bit pixels from src to dst
  * srcRaster - short* aligned pointer into source of pixels
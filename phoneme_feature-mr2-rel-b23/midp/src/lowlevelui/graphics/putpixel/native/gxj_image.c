@@ -98,6 +98,9 @@ draw_image(gxj_screen_buffer *imageSBuf,
 
   CHECK_SBUF_CLIP_BOUNDS(destSBuf, clip);
 
+  GXJ_MARK_DIRTY(destSBuf, clip, x_dest, y_dest,
+                 imageSBuf->width, imageSBuf->height);
+
   if (imageSBuf->alphaData == NULL) {
     if (x_dest >= clipX1 && y_dest >= clipY1 &&
        (x_dest + imageSBuf->width) <= clipX2 &&
@@ -146,6 +149,12 @@ draw_imageregion(gxj_screen_buffer *imageSBuf,
 
   CHECK_SBUF_CLIP_BOUNDS(dstSBuf, clip);
 
+  if (transform & TRANSFORM_INVERTED_AXES) {
+    GXJ_MARK_DIRTY(dstSBuf, clip, x_dest, y_dest, height, width);
+  } else {
+    GXJ_MARK_DIRTY(dstSBuf, clip, x_dest, y_dest, width, height);
+  }
+
   copy_imageregion(imageSBuf, dstSBuf,
                   clip, x_dest, y_dest, width, height, x_src, y_src, transform);
 }
@@ -203,16 +212,16 @@ decode_png
  * b). move to a special file, like decode_png_image() in gxj_png_decode.c
  */
 //static bool decode_jpeg_image(imageSrcPtr src, imageDstPtr dst)
-static int decode_jpeg_image(char* inData, int inDataLen,
-    char* outData, int outDataWidth, int outDataHeight)
+static int decode_jpeg_image(char* inData, int inDataLen, int scaleDenom,
+    gxj_pixel_type* outData, int outDataWidth, int outDataHeight)
 {
     int result = FALSE;
 
     void *info = JPEG_To_RGB_init();
     if (info) {
         int width, height;
-        if (JPEG_To_RGB_decodeHeader(info, inData, inDataLen,
-            &width, &height) != 0) {
+        if (JPEG_To_RGB_decodeHeaderScaled(info, inData, inDataLen,
+            scaleDenom, &width, &height) != 0) {
             if ((width < outDataWidth) || (height < outDataHeight)) {
                 /*
                  * TBD:
@@ -225,8 +234,9 @@ static int decode_jpeg_image(char* inData, int inDataLen,
                  */
             }
 
-            if (JPEG_To_RGB_decodeData2(info, outData,
-                RGB565_PIXEL_SIZE, 0, 0, outDataWidth, outDataHeight) != 0) {
+            /* RGB565 pixels are written straight into the image */
+            if (JPEG_To_RGB565_decodeData(info, outData,
+                outDataWidth, outDataHeight) != 0) {
                 result = TRUE;
             }
         }
@@ -249,6 +259,27 @@ static int decode_jpeg_image(char* inData, int inDataLen,
 void
 decode_jpeg
 (unsigned char* srcBuffer, int length, gxj_screen_buffer *image,
+ gxutl_native_image_error_codes* creationErrorPtr) {
+    decode_jpeg_scaled(srcBuffer, length, 1, image, creationErrorPtr);
+}
+
+/**
+ * Decodes the given input data into a storage format used by
+ * images, at a reduced size.  The input data should be a JPEG image.
+ *
+ *  @param srcBuffer input data to be decoded.
+ *  @param length length of the input data.
+ *  @param scaleDenom 1, 2, 4 or 8: the image is decoded at 1/scaleDenom
+ *         of its size
+ *  @param image the image to decode to; its width and height must be
+ *         the JPEG image size divided by scaleDenom, rounded up
+ *  @param creationErrorPtr pointer to the status of the decoding
+ *         process. This function sets creationErrorPtr's value.
+ */
+void
+decode_jpeg_scaled
+(unsigned char* srcBuffer, int length, int scaleDenom,
+ gxj_screen_buffer *image,
  gxutl_native_image_error_codes* creationErrorPtr) {
 
 #if ENABLE_JPEG
@@ -277,8 +308,8 @@ decode_jpeg
     if ((src = create_imagesrc_from_data((char **)(void *)&srcBuffer,
         length)) == NULL) {
         *creationErrorPtr = GXUTL_NATIVE_IMAGE_OUT_OF_MEMORY_ERROR;
-    } else if (decode_jpeg_image((char*)srcBuffer, length,
-        (char*)(image->pixelData),
+    } else if (decode_jpeg_image((char*)srcBuffer, length, scaleDenom,
+        image->pixelData,
         image->width, image->height) != FALSE) {
         *creationErrorPtr = GXUTL_NATIVE_IMAGE_NO_ERROR;
     } else {
@@ -292,6 +323,7 @@ decode_jpeg
 #else
     (void)srcBuffer;
     (void)length;
+    (void)scaleDenom;
     (void)image;
     *creationErrorPtr = GXUTL_NATIVE_IMAGE_UNSUPPORTED_FORMAT_ERROR;
 #endif
@@ -30,6 +30,7 @@
 
 #include <gx_font.h>
 #include <gxj_putpixel.h>
+#include <gxj_screen_buffer.h>
 
 #include "gxj_intern_image.h"
 
@@ -59,12 +60,47 @@ extern "C" {
 #define BITMAP_DATA 3
 
 
+/**
+ * SIMD variants of the span kernels in gxj_graphics_asm.c are selected
+ * at compile time from the instruction set the compiler targets. lib.gmk
+ * passes GXJ_SIMD_CFLAGS (-msse2 on i386 by default) to the files that
+ * use them; gxj_span_bench measures them against the scalar loops.
+ */
+#if defined(__SSE2__)
+#define GXJ_SIMD_SSE2 1
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define GXJ_SIMD_NEON 1
+#endif
+
+/**
+ * Convert a span of ARGB8888 pixels to RGB565 and store them, blending
+ * them with the destination pixels if processAlpha is true.
+ */
+extern void draw_rgb_span(gxj_pixel_type *dst, const jint *src, int count,
+                          jboolean processAlpha);
+
 /**
  * Convenient macro for getting both on and off screen buffer.
  */
 #define getScreenBuffer(sbuf) \
     ((sbuf == NULL) ? (&gxj_system_screen_buffer) : sbuf)
 
+/**
+ * Record the area a primitive may have changed, clipped by clip,
+ * if it draws into the system screen buffer.
+ */
+#if ENABLE_DIRTY_REGIONS
+#define GXJ_MARK_DIRTY(sbuf, clip, x, y, width, height) \
+    do { \
+        if ((sbuf) == &gxj_system_screen_buffer) { \
+            gxj_mark_dirty_region((clip), (x), (y), \
+                                  (x) + (width), (y) + (height)); \
+        } \
+    } while (0)
+#else
+#define GXJ_MARK_DIRTY(sbuf, clip, x, y, width, height)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
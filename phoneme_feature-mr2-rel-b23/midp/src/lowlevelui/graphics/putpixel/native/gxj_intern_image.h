@@ -81,6 +81,25 @@ decode_jpeg(unsigned char* srcBuffer, int length,
 	   gxj_screen_buffer *image,
 	   gxutl_native_image_error_codes* creationErrorPtr);
 
+/**
+ * Decodes the given input data into a storage format used by 
+ * images, at 1/2, 1/4 or 1/8 of its size.  The input data should be
+ * a JPEG image.  The reduced-size inverse DCT is used, so the full
+ * size image is never produced.
+ * 
+ *  @param srcBuffer input data to be decoded.
+ *  @param length length of the input data.
+ *  @param scaleDenom 1, 2, 4 or 8
+ *  @param image the image to decode to; its width and height must be
+ *         the JPEG image size divided by scaleDenom, rounded up
+ *  @param creationErrorPtr pointer to the status of the decoding
+ *         process. This function sets creationErrorPtr's value.
+ */
+void
+decode_jpeg_scaled(unsigned char* srcBuffer, int length, int scaleDenom,
+	   gxj_screen_buffer *image,
+	   gxutl_native_image_error_codes* creationErrorPtr);
+
 /**
  * Renders the contents of the specified mutable image
  * onto the destination specified.
@@ -78,6 +78,8 @@ static unsigned long readPalette(imageSrcPtr, long, pngData *,
 static unsigned long readTransPal(imageSrcPtr, long, pngData *,
                                   unsigned char *, unsigned long);
 static bool handleImageData(unsigned char *, int, imageDstPtr, pngData *);
+static void applyFilter(int, unsigned char *, int, unsigned char *, int);
+static void unpack1(unsigned char *, unsigned char *, pngData *);
 static unsigned long getInt(imageSrcPtr);
 static unsigned long skip(imageSrcPtr, int, unsigned long);
 static bool getChunk(imageSrcPtr, unsigned long *, long *);
@@ -177,6 +179,140 @@ static void* addrFromHandleFunction(void* state, void* handle) {
     return handle;
 }
 
+/*
+ * Size of the window non-interlaced images are inflated through: the
+ * history needed for back references plus as much again for new data,
+ * so that each byte is moved at most once when the window slides.
+ */
+#define PNG_INFLATE_WINDOW (2 * INFLATE_WINDOW_SIZE)
+
+/*
+ * State of decoding a non-interlaced image row by row as it is inflated.
+ * Each row is unfiltered against the previous one and sent to the
+ * destination as soon as it is complete.
+ */
+typedef struct _prs {
+    imageDstPtr    dst;
+    pngData       *data;
+    unsigned char *row;        /* row being assembled, filter byte first */
+    unsigned char *prevRow;    /* previous unfiltered row                */
+    unsigned char *scanline;   /* unpacked pixels, NULL to send directly */
+    int            fill;       /* bytes of row received so far           */
+    int            y;          /* number of the row being assembled      */
+} pngRowSink;
+
+static int
+PNGdecodeImage_putBytes(void *p, unsigned char *bytes, int n)
+{
+    pngRowSink *s = (pngRowSink *)p;
+    pngData *data = s->data;
+    int lineBytes = data->lineBytes[6];
+
+    while (n > 0) {
+        int count = lineBytes - s->fill;
+        if (count > n) {
+            count = n;
+        }
+
+        memcpy(s->row + s->fill, bytes, count);
+        s->fill += count;
+        bytes += count;
+        n -= count;
+
+        if (s->fill == lineBytes) {
+            unsigned char *tmp;
+
+            applyFilter(s->row[0], s->row + 1, lineBytes - 1,
+                        (s->y == 0) ? NULL : s->prevRow + 1,
+                        data->bytesPerPixel);
+
+            if (s->scanline == NULL) {
+                s->dst->sendPixels(s->dst, s->y, s->row + 1,
+                                   data->colorType);
+            } else {
+                unpack1(s->scanline, s->row + 1, data);
+                s->dst->sendPixels(s->dst, s->y, s->scanline,
+                                   data->colorType);
+            }
+
+            tmp = s->prevRow;
+            s->prevRow = s->row;
+            s->row = tmp;
+            s->fill = 0;
+            s->y++;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Inflate the image data of a non-interlaced image and hand it to the
+ * destination row by row. Only the inflate window and two rows are kept
+ * in memory instead of the whole decompressed image.
+ */
+static bool
+streamImageData(FileObj *fileObj, HeapManObj *heapManObj, int compLen,
+                int decompLen, imageDstPtr dst, pngData *data)
+{
+    int pixelSize = ((data->colorType & (CT_PALETTE | CT_COLOR)) ? 3 : 1) +
+                    (((data->colorType & CT_ALPHA) || (data->trans != NULL))
+                     ? 1 : 0 );
+    int windowLen = (decompLen < PNG_INFLATE_WINDOW) ?
+                    decompLen : PNG_INFLATE_WINDOW;
+    int lineBytes = data->lineBytes[6];
+    unsigned char *window;
+    unsigned char *rows;
+    OutputSinkObj sink;
+    pngRowSink rowSink;
+    int status;
+
+    window = (unsigned char *)pcsl_mem_malloc(windowLen);
+    if (window == NULL) {
+        return FALSE;
+    }
+
+    rows = (unsigned char *)pcsl_mem_malloc(2 * lineBytes);
+    if (rows == NULL) {
+        freeBytes(window);
+        return FALSE;
+    }
+
+    rowSink.dst = dst;
+    rowSink.data = data;
+    rowSink.row = rows;
+    rowSink.prevRow = rows + lineBytes;
+    rowSink.scanline = NULL;
+    rowSink.fill = 0;
+    rowSink.y = 0;
+
+    if ( (data->depth != 8) ||
+         ( !(data->colorType & CT_PALETTE) && (data->trans != NULL) ) ) {
+        /* not in the desired format, see handleImageData */
+        rowSink.scanline =
+            (unsigned char *)pcsl_mem_malloc(data->width * pixelSize);
+        if (rowSink.scanline == NULL) {
+            freeBytes(rows);
+            freeBytes(window);
+            return FALSE;
+        }
+    }
+
+    sink.state = &rowSink;
+    sink.write = PNGdecodeImage_putBytes;
+
+    status = inflateDataToSink(fileObj, heapManObj, compLen,
+                               window, windowLen, decompLen, &sink);
+
+    if (rowSink.scanline != NULL) {
+        freeBytes(rowSink.scanline);
+    }
+    freeBytes(rows);
+    freeBytes(window);
+
+    return (status == 0) ? TRUE : FALSE;
+}
+
 bool get_decoded_png_imagesize(imageSrcPtr src, int* width, int* height) {
     unsigned long chunkType;
     long chunkLength;
@@ -405,12 +541,6 @@ PNGdecodeImage_real(imageSrcPtr src, imageDstPtr dst,
 
             src->seek(src, startPos);    /* reset to the first IDAT_CHUNK */
 
-            decompBuf = (unsigned char*)pcsl_mem_malloc(decompLen);
-            if (decompBuf == NULL) {
-                OK = FALSE;
-		goto done;
-            }
-
             /*
              * inflate ignores the method and flags
              */
@@ -429,16 +559,35 @@ PNGdecodeImage_real(imageSrcPtr src, imageDstPtr dst,
             heapManObj.free = freeFunction;
             heapManObj.addrFromHandle = addrFromHandleFunction;
 
-            /* subtract 4 bytes from compLen -- it's the ZLIB trailer */
-            if (inflateData(&fileObj, &heapManObj, compLen - 4,
-                             decompBuf, decompLen, 0) != 0) {
-                freeBytes(decompBuf);
-		goto formaterror;
-	    }
+            if (!data.interlace) {
+                /* subtract 4 bytes from compLen -- it's the ZLIB trailer */
+                if (!streamImageData(&fileObj, &heapManObj, compLen - 4,
+                                     decompLen, dst, &data)) {
+                    goto formaterror;
+                }
+            } else {
+                /*
+                 * The passes of an interlaced image are interleaved in
+                 * the output rows, so all of them are needed before the
+                 * first row can be sent.
+                 */
+                decompBuf = (unsigned char*)pcsl_mem_malloc(decompLen);
+                if (decompBuf == NULL) {
+                    OK = FALSE;
+                    goto done;
+                }
+
+                /* subtract 4 bytes from compLen -- it's the ZLIB trailer */
+                if (inflateData(&fileObj, &heapManObj, compLen - 4,
+                                decompBuf, decompLen, 0) != 0) {
+                    freeBytes(decompBuf);
+                    goto formaterror;
+                }
 
-            OK = handleImageData(decompBuf, decompLen, dst, &data);
+                OK = handleImageData(decompBuf, decompLen, dst, &data);
 
-            freeBytes(decompBuf);
+                freeBytes(decompBuf);
+            }
             src->seek(src, lastGoodPos);
         } else if (chunkType == IEND_CHUNK) {
             /* shouldn't happen because getChunk checks for this! */
@@ -651,11 +800,31 @@ readTransPal(imageSrcPtr src, long length, pngData *data,
     return CRC;
 }
 
+/*
+ * The filters are applied four bytes at a time where the bytes they
+ * depend on are at least four bytes back, i.e. always for Up and for
+ * pixels of four or more bytes for Sub and Avg. Words are accessed
+ * with memcpy since rows are not aligned.
+ */
+typedef unsigned int pngWord;
+
+/* Byte-wise a + b, without carries between the bytes */
+#define WORD_ADD(a, b) \
+    ((((a) & 0x7f7f7f7fU) + ((b) & 0x7f7f7f7fU)) ^ (((a) ^ (b)) & 0x80808080U))
+
+/* Byte-wise (a + b) >> 1, computed without overflow */
+#define WORD_AVG(a, b) \
+    (((a) & (b)) + ((((a) ^ (b)) & 0xfefefefeU) >> 1))
+
+#define LOAD_WORD(w, p)  memcpy(&(w), (p), sizeof(pngWord))
+#define STORE_WORD(p, w) memcpy((p), &(w), sizeof(pngWord))
+
 static void
 applyFilter(int filterType, unsigned char *buf, int n,
             unsigned char *prev, int bpp)
 {
     int x;
+    pngWord w, v;
 
     if (filterType == 0) {
         return;
@@ -678,13 +847,28 @@ applyFilter(int filterType, unsigned char *buf, int n,
          * We start at x == bpp because for x < bpp, buf[x - bpp] is
          * to be treated as zero.
          */
-        for (x = bpp; x < n; ++x) {
+        x = bpp;
+        if (bpp >= (int)sizeof(pngWord)) {
+            for (; x + (int)sizeof(pngWord) <= n; x += sizeof(pngWord)) {
+                LOAD_WORD(w, buf + x);
+                LOAD_WORD(v, buf + x - bpp);
+                w = WORD_ADD(w, v);
+                STORE_WORD(buf + x, w);
+            }
+        }
+        for (; x < n; ++x) {
             buf[x] += buf[x - bpp];
         }
         break;
 
     case 2:
-        for (x = 0; x < n; ++x) {
+        for (x = 0; x + (int)sizeof(pngWord) <= n; x += sizeof(pngWord)) {
+            LOAD_WORD(w, buf + x);
+            LOAD_WORD(v, prev + x);
+            w = WORD_ADD(w, v);
+            STORE_WORD(buf + x, w);
+        }
+        for (; x < n; ++x) {
             buf[x] += prev[x];
         }
         break;
@@ -702,7 +886,18 @@ applyFilter(int filterType, unsigned char *buf, int n,
         /*
          * But for x >= bpp we can do the full computation.
          */
-        for (x = bpp; x < n; ++x) {
+        if (bpp >= (int)sizeof(pngWord)) {
+            for (; x + (int)sizeof(pngWord) <= n; x += sizeof(pngWord)) {
+                pngWord a, b;
+                LOAD_WORD(a, buf + x - bpp);
+                LOAD_WORD(b, prev + x);
+                LOAD_WORD(w, buf + x);
+                v = WORD_AVG(a, b);
+                w = WORD_ADD(w, v);
+                STORE_WORD(buf + x, w);
+            }
+        }
+        for (; x < n; ++x) {
             buf[x] += (prev[x] + (buf[x - bpp])) >> 1;
         }
         break;
@@ -722,14 +917,17 @@ applyFilter(int filterType, unsigned char *buf, int n,
          * Now we can do the full computation.
          */
         for (x = bpp; x < n; ++x) {
-            int a, b, c, p, pa, pb, pc;
+            int a, b, c, pa, pb, pc;
             a = buf[x - bpp];
             b = prev[x];
             c = prev[x - bpp];
-            p = a + b - c;
-            pa = p > a ? p - a : a - p;
-            pb = p > b ? p - b : b - p;
-            pc = p > c ? p - c : c - p;
+            /* |p - a|, |p - b| and |p - c| for p = a + b - c */
+            pa = b - c;
+            pb = a - c;
+            pc = pa + pb;
+            pa = pa < 0 ? -pa : pa;
+            pb = pb < 0 ? -pb : pb;
+            pc = pc < 0 ? -pc : pc;
             buf[x] += ((pa <= pb) && (pa <= pc)) ? a : ((pb <= pc) ? b : c);
         }
         break;
@@ -808,7 +1006,7 @@ filterAllRows(unsigned char *pixels, pngData *data) {
                  (s[1] == tmap[1]) )    \
                 ? 0x00: 0xFF;           \
      } else {                           \
-        *(d)++ = ((s[1] == tmap[1]))    \
+        *(d)++ = ((s[0] == tmap[1]))    \
                  ? 0x00: 0xFF;          \
      }                                  \
     (s) += (a)
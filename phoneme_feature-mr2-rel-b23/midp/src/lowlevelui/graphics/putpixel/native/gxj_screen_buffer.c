@@ -31,6 +31,174 @@
 
 #include "gxj_screen_buffer.h"
 
+#if ENABLE_DIRTY_REGIONS
+
+/** Dirty rectangles of the system screen buffer */
+static gxj_dirty_region dirtyRegions[GXJ_MAX_DIRTY_REGIONS];
+
+/** Number of used elements in dirtyRegions */
+static int dirtyRegionsCount = 0;
+
+/** Number of pixels marked dirty since the screen buffer was created */
+static jlong dirtyPixelsDrawn = 0;
+
+/** Number of pixels handed out for refresh */
+static jlong dirtyPixelsFlushed = 0;
+
+/** Area of a rectangle in pixels */
+#define REGION_AREA(r) (((r)->x2 - (r)->x1) * ((r)->y2 - (r)->y1))
+
+/** Extend rectangle <dst> to cover rectangle <src> too */
+static void union_region(gxj_dirty_region *dst, const gxj_dirty_region *src) {
+    if (src->x1 < dst->x1) { dst->x1 = src->x1; }
+    if (src->y1 < dst->y1) { dst->y1 = src->y1; }
+    if (src->x2 > dst->x2) { dst->x2 = src->x2; }
+    if (src->y2 > dst->y2) { dst->y2 = src->y2; }
+}
+
+/** Area of the bounding rectangle of two rectangles */
+static int union_area(const gxj_dirty_region *a, const gxj_dirty_region *b) {
+    gxj_dirty_region u = *a;
+    union_region(&u, b);
+    return REGION_AREA(&u);
+}
+
+/**
+ * Add a rectangle to the dirty area of the system screen buffer.
+ *
+ * @param clip optional clip [x1, y1, x2, y2] to intersect the
+ *   rectangle with, or NULL
+ * @param x1 top-left x coordinate of the changed area
+ * @param y1 top-left y coordinate of the changed area
+ * @param x2 bottom-right x coordinate of the changed area (exclusive)
+ * @param y2 bottom-right y coordinate of the changed area (exclusive)
+ */
+void gxj_mark_dirty_region(const jshort *clip,
+                           int x1, int y1, int x2, int y2) {
+    gxj_dirty_region r;
+    int i;
+
+    if (clip != NULL) {
+        if (x1 < clip[0]) { x1 = clip[0]; }
+        if (y1 < clip[1]) { y1 = clip[1]; }
+        if (x2 > clip[2]) { x2 = clip[2]; }
+        if (y2 > clip[3]) { y2 = clip[3]; }
+    }
+    if (x1 < 0) { x1 = 0; }
+    if (y1 < 0) { y1 = 0; }
+    if (x2 > gxj_system_screen_buffer.width) {
+        x2 = gxj_system_screen_buffer.width;
+    }
+    if (y2 > gxj_system_screen_buffer.height) {
+        y2 = gxj_system_screen_buffer.height;
+    }
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    r.x1 = x1;
+    r.y1 = y1;
+    r.x2 = x2;
+    r.y2 = y2;
+    dirtyPixelsDrawn += REGION_AREA(&r);
+
+    // Absorb the rectangles that can be merged without
+    // flushing more pixels than when kept separately
+    i = 0;
+    while (i < dirtyRegionsCount) {
+        gxj_dirty_region *d = &dirtyRegions[i];
+        if (union_area(d, &r) <= REGION_AREA(d) + REGION_AREA(&r)) {
+            union_region(&r, d);
+            dirtyRegions[i] = dirtyRegions[--dirtyRegionsCount];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (dirtyRegionsCount == GXJ_MAX_DIRTY_REGIONS) {
+        // No room left: grow the rectangle that grows least
+        int best = 0;
+        int bestGrowth = union_area(&dirtyRegions[0], &r) -
+            REGION_AREA(&dirtyRegions[0]);
+        for (i = 1; i < dirtyRegionsCount; i++) {
+            int growth = union_area(&dirtyRegions[i], &r) -
+                REGION_AREA(&dirtyRegions[i]);
+            if (growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        union_region(&dirtyRegions[best], &r);
+    } else {
+        dirtyRegions[dirtyRegionsCount++] = r;
+    }
+}
+
+/** Mark the whole system screen buffer dirty */
+void gxj_mark_screen_dirty() {
+    dirtyRegions[0].x1 = 0;
+    dirtyRegions[0].y1 = 0;
+    dirtyRegions[0].x2 = gxj_system_screen_buffer.width;
+    dirtyRegions[0].y2 = gxj_system_screen_buffer.height;
+    dirtyRegionsCount = 1;
+}
+
+/**
+ * Get the dirty rectangles of the system screen buffer that intersect
+ * the area requested for refresh, clipped to that area. Rectangles
+ * entirely inside the area are removed from the dirty list; the others
+ * are kept until they get refreshed in full.
+ *
+ * @param x1 top-left x coordinate of the area to refresh
+ * @param y1 top-left y coordinate of the area to refresh
+ * @param x2 bottom-right x coordinate of the area to refresh
+ * @param y2 bottom-right y coordinate of the area to refresh
+ * @param regions array of at least GXJ_MAX_DIRTY_REGIONS elements
+ *   to store the rectangles to refresh
+ * @return number of rectangles stored to regions
+ */
+int gxj_get_dirty_regions(int x1, int y1, int x2, int y2,
+                          gxj_dirty_region *regions) {
+    int i = 0;
+    int n = 0;
+
+    while (i < dirtyRegionsCount) {
+        gxj_dirty_region *d = &dirtyRegions[i];
+        gxj_dirty_region *r = &regions[n];
+
+        r->x1 = (d->x1 > x1) ? d->x1 : x1;
+        r->y1 = (d->y1 > y1) ? d->y1 : y1;
+        r->x2 = (d->x2 < x2) ? d->x2 : x2;
+        r->y2 = (d->y2 < y2) ? d->y2 : y2;
+        if (r->x1 < r->x2 && r->y1 < r->y2) {
+            dirtyPixelsFlushed += REGION_AREA(r);
+            n++;
+        }
+
+        if (d->x1 >= x1 && d->y1 >= y1 && d->x2 <= x2 && d->y2 <= y2) {
+            dirtyRegions[i] = dirtyRegions[--dirtyRegionsCount];
+        } else {
+            i++;
+        }
+    }
+    return n;
+}
+
+/**
+ * Get the number of pixels marked dirty and the number of pixels
+ * handed out for refresh since the screen buffer was created.
+ *
+ * @param pixelsDrawn pointer to store the number of pixels drawn
+ * @param pixelsFlushed pointer to store the number of pixels flushed
+ */
+void gxj_get_dirty_region_counters(jlong *pixelsDrawn, jlong *pixelsFlushed) {
+    *pixelsDrawn = dirtyPixelsDrawn;
+    *pixelsFlushed = dirtyPixelsFlushed;
+}
+
+#endif /* ENABLE_DIRTY_REGIONS */
+
 /**
  * Initialize screen buffer for a screen with specified demension,
  * allocate memory for pixel data.
@@ -55,6 +223,10 @@ MIDPError gxj_init_screen_buffer(int width, int height) {
         stat = OUT_OF_MEMORY;
     }
 
+#if ENABLE_DIRTY_REGIONS
+    gxj_mark_screen_dirty();
+#endif
+
     return stat;
 }
 
@@ -99,6 +271,9 @@ void gxj_reset_screen_buffer() {
 
         memset(gxj_system_screen_buffer.pixelData, 0, size);
     }
+#if ENABLE_DIRTY_REGIONS
+    gxj_mark_screen_dirty();
+#endif
 }
 
 /**
@@ -192,6 +367,10 @@ void gxj_rotate_screen_buffer(jboolean keepContent) {
     height = gxj_system_screen_buffer.height;
     gxj_system_screen_buffer.height = gxj_system_screen_buffer.width;
     gxj_system_screen_buffer.width = height;
+
+#if ENABLE_DIRTY_REGIONS
+    gxj_mark_screen_dirty();
+#endif
 }
 
 /** Free memory allocated for screen buffer */
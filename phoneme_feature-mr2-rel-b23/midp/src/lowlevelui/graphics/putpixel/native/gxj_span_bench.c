@@ -0,0 +1,304 @@
+/*
+ *
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+/**
+ * @file
+ *
+ * Host benchmark of the span kernels in gxj_graphics_asm.c against the
+ * scalar loops they replace: draw_rgb_span() for drawRGB and the row
+ * fill of fastFill_rect(). Every case is run over a QVGA screen buffer;
+ * the best of several runs is reported in megapixels per second. The
+ * output of draw_rgb_span() is first compared with the scalar loop, and
+ * the tool fails if they differ.
+ *
+ * <p>Build with <code>make gxj_span_bench</code>; the binary is placed
+ * in $(BINDIR). It is compiled with the same GXJ_SIMD_CFLAGS as the
+ * kernels, see lib.gmk.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <gxj_putpixel.h>
+
+#include "gxj_intern_graphics.h"
+
+/* fastFill_rect() uses this row fill when gxj_graphics.c does not */
+#if defined(__GNUC__) && defined(ARM)
+#define HAVE_FAST_PIXEL_SET 1
+extern void fast_pixel_set(unsigned * mem, unsigned value,
+                           int number_of_pixels);
+#else
+#define HAVE_FAST_PIXEL_SET 0
+#endif
+
+/* Size of the screen buffer */
+#define SCREEN_WIDTH  240
+#define SCREEN_HEIGHT 320
+#define SCREEN_PIXELS (SCREEN_WIDTH * SCREEN_HEIGHT)
+
+/* Number of runs of a case; the fastest one is reported */
+#define RUNS 5
+
+/* Number of passes over the screen in a run */
+#define PASSES 200
+
+/* Sources of the drawRGB cases */
+enum {
+    SRC_OPAQUE,      /* every pixel has alpha 0xFF */
+    SRC_TRANSLUCENT, /* random alpha */
+    SRC_SPRITE       /* runs of opaque and fully transparent pixels */
+};
+
+static jint src[SCREEN_PIXELS];
+static gxj_pixel_type dst[SCREEN_PIXELS];
+static gxj_pixel_type ref[SCREEN_PIXELS];
+
+/* Scalar loop of draw_rgb_span(), as it was before the kernels */
+static void
+scalar_rgb_span(gxj_pixel_type *d, const jint *s, int count,
+                jboolean processAlpha) {
+    int i;
+
+    for (i = 0; i < count; i++) {
+        const int value = s[i];
+        if (!processAlpha || ((value & 0xff000000) == 0xff000000)) {
+            d[i] = GXJ_RGB24TORGB16(value);
+        } else {
+            unsigned int xA =
+                GXJ_XAAA8888_FROM_ARGB8888((unsigned int)value);
+            unsigned int XAInv =
+                (unsigned int)(((unsigned int)(0xFFFFFFFF)) - xA);
+            d[i] = GXJ_RGB24TORGB16((xA & value) |
+                                    (XAInv & GXJ_RGB16TORGB24(d[i])));
+        }
+    }
+}
+
+/* Scalar row fill of fastFill_rect(), as in gxj_graphics.c */
+static void
+scalar_pixel_set(unsigned * mem, unsigned value, int number_of_pixels) {
+    int i;
+    gxj_pixel_type* pBuf = (gxj_pixel_type*)mem;
+
+    for (i = 0; i < number_of_pixels; ++i) {
+        *(pBuf + i) = (gxj_pixel_type)value;
+    }
+}
+
+typedef void (*rgb_span_func)(gxj_pixel_type*, const jint*, int, jboolean);
+typedef void (*pixel_set_func)(unsigned*, unsigned, int);
+
+/*
+ * The functions under test, scalar loop first. Read through volatile
+ * pointers, so that the compiler cannot inline either of them into the
+ * timing loops.
+ */
+static rgb_span_func volatile rgb_span_funcs[2];
+static pixel_set_func volatile pixel_set_funcs[2];
+
+static unsigned int
+next_random(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed;
+}
+
+static void
+fill_source(int kind) {
+    unsigned int seed = 1;
+    int i;
+
+    for (i = 0; i < SCREEN_PIXELS; i++) {
+        unsigned int rgb = next_random(&seed) >> 8;
+        switch (kind) {
+        case SRC_OPAQUE:
+            src[i] = (jint)(0xFF000000 | rgb);
+            break;
+        case SRC_TRANSLUCENT:
+            src[i] = (jint)((next_random(&seed) & 0xFF000000) | rgb);
+            break;
+        default:
+            /* 16 pixel wide stripes, so groups are mostly uniform */
+            src[i] = (jint)((((i / 16) & 1) ? 0xFF000000 : 0) | rgb);
+            break;
+        }
+    }
+}
+
+static void
+fill_destination(gxj_pixel_type *d) {
+    unsigned int seed = 2;
+    int i;
+
+    for (i = 0; i < SCREEN_PIXELS; i++) {
+        d[i] = (gxj_pixel_type)(next_random(&seed) >> 16);
+    }
+}
+
+/* Megapixels per second of the fastest of RUNS runs */
+static double
+time_rgb(int kernel, jboolean processAlpha) {
+    rgb_span_func span = rgb_span_funcs[kernel];
+    clock_t best = 0;
+    int run, pass, y;
+
+    for (run = 0; run < RUNS; run++) {
+        clock_t start;
+        fill_destination(dst);
+        start = clock();
+        for (pass = 0; pass < PASSES; pass++) {
+            for (y = 0; y < SCREEN_HEIGHT; y++) {
+                span(dst + y * SCREEN_WIDTH, src + y * SCREEN_WIDTH,
+                     SCREEN_WIDTH, processAlpha);
+            }
+        }
+        start = clock() - start;
+        if (run == 0 || start < best) {
+            best = start;
+        }
+    }
+    if (best == 0) {
+        best = 1;
+    }
+    return (double)SCREEN_PIXELS * PASSES * CLOCKS_PER_SEC / best / 1e6;
+}
+
+/* Same as time_rgb() for a fill of width x height rectangles */
+static double
+time_fill(int kernel, int width, int height) {
+    pixel_set_func set = pixel_set_funcs[kernel];
+    clock_t best = 0;
+    int run, pass, x, y, h;
+    long pixels = 0;
+
+    for (run = 0; run < RUNS; run++) {
+        clock_t start = clock();
+        pixels = 0;
+        for (pass = 0; pass < PASSES; pass++) {
+            for (y = 0; y + height <= SCREEN_HEIGHT; y += height) {
+                for (x = 0; x + width <= SCREEN_WIDTH; x += width) {
+                    gxj_pixel_type *raster = dst + y * SCREEN_WIDTH + x;
+                    for (h = height; h > 0; h--) {
+                        set((unsigned *)raster, (unsigned)(pass + x), width);
+                        raster += SCREEN_WIDTH;
+                    }
+                    pixels += width * height;
+                }
+            }
+        }
+        start = clock() - start;
+        if (run == 0 || start < best) {
+            best = start;
+        }
+    }
+    if (best == 0) {
+        best = 1;
+    }
+    return (double)pixels * CLOCKS_PER_SEC / best / 1e6;
+}
+
+static int
+check_rgb(jboolean processAlpha) {
+    int i, n;
+
+    fill_destination(dst);
+    fill_destination(ref);
+    /* every span length and alignment up to two groups */
+    for (i = 0, n = 0; i + n <= SCREEN_PIXELS; i += n, n = (n + 1) % 19) {
+        draw_rgb_span(dst + i, src + i, n, processAlpha);
+        scalar_rgb_span(ref + i, src + i, n, processAlpha);
+    }
+    for (i = 0; i < SCREEN_PIXELS; i++) {
+        if (dst[i] != ref[i]) {
+            fprintf(stderr, "draw_rgb_span differs at pixel %d\n", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void
+report(const char *name, double scalar, double kernel) {
+    printf("%-28s %10.1f %10.1f %8.2fx\n", name, scalar, kernel,
+           kernel / scalar);
+}
+
+int
+main(void) {
+    static const struct {
+        const char *name;
+        int kind;
+        jboolean processAlpha;
+    } rgb_cases[] = {
+        { "drawRGB opaque",            SRC_OPAQUE,      KNI_FALSE },
+        { "drawRGB opaque, alpha",     SRC_OPAQUE,      KNI_TRUE  },
+        { "drawRGB translucent, alpha", SRC_TRANSLUCENT, KNI_TRUE  },
+        { "drawRGB sprite, alpha",     SRC_SPRITE,      KNI_TRUE  }
+    };
+    static const int fill_sizes[][2] = {
+        { SCREEN_WIDTH, SCREEN_HEIGHT }, { 60, 20 }, { 16, 16 }, { 4, 4 }
+    };
+    unsigned int i;
+
+    rgb_span_funcs[0] = scalar_rgb_span;
+    rgb_span_funcs[1] = draw_rgb_span;
+    pixel_set_funcs[0] = scalar_pixel_set;
+#if HAVE_FAST_PIXEL_SET
+    pixel_set_funcs[1] = fast_pixel_set;
+#else
+    pixel_set_funcs[1] = scalar_pixel_set;
+#endif
+
+#if GXJ_SIMD_SSE2
+    printf("kernels: SSE2\n");
+#elif GXJ_SIMD_NEON
+    printf("kernels: NEON\n");
+#else
+    printf("kernels: none, both columns run the scalar loops\n");
+#endif
+    printf("%-28s %10s %10s %9s\n", "case (Mpixels/s)", "scalar", "kernel",
+           "speedup");
+
+    for (i = 0; i < sizeof(rgb_cases) / sizeof(rgb_cases[0]); i++) {
+        fill_source(rgb_cases[i].kind);
+        if (!check_rgb(rgb_cases[i].processAlpha)) {
+            return 1;
+        }
+        report(rgb_cases[i].name,
+               time_rgb(0, rgb_cases[i].processAlpha),
+               time_rgb(1, rgb_cases[i].processAlpha));
+    }
+
+    for (i = 0; i < sizeof(fill_sizes) / sizeof(fill_sizes[0]); i++) {
+        char name[32];
+        sprintf(name, "fillRect %dx%d", fill_sizes[i][0], fill_sizes[i][1]);
+        report(name, time_fill(0, fill_sizes[i][0], fill_sizes[i][1]),
+               time_fill(1, fill_sizes[i][0], fill_sizes[i][1]));
+    }
+
+    return 0;
+}
@@ -218,6 +218,8 @@ gx_draw_chars(jint pixel, const jshort *clip,
     width = fontWidth * n;
     yLimit = fontHeight;
 
+    GXJ_MARK_DIRTY(dest, clip, xDest, yDest, width, fontHeight);
+
     xStart = 0;
     yCharSource = 0;
 
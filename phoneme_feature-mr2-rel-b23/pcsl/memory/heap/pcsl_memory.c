@@ -42,10 +42,12 @@
  * <tr><th scope=col>Contents of the Memory Block</th></tr>
  * <tr><td>magic (value of 0xCAFE)</td></tr>
  * <tr><td>free (value of 0 or 1)</td></tr>
- * <tr><td>reserved/<sup>[*]</sup>guardSize</td></tr>
+ * <tr><td>prevFree (value of 0 or 1)</td></tr>
  * <tr><td>size</td></tr>
  * <tr><td><sup>[*]</sup>filename</td></tr>
  * <tr><td><sup>[*]</sup>lineno</td></tr>
+ * <tr><td><sup>[*]</sup>guardSize</td></tr>
+ * <tr><td><sup>[*]</sup>guard</td></tr>
  * <tr><td>1 .. size</td></tr>
  * <tr><td><sup>[*]</sup>1 .. guardSize</td></tr>
  * </table>
@@ -53,6 +55,17 @@
  * <p>Items that have the prefix <sup>[*]</sup> are only enabled if memory
  * tracing is enabled.
  *
+ * <p>Free blocks are kept on segregated free lists, one per size class:
+ * sizes below SMALL_BIN_LIMIT get one exact-size list per word, larger
+ * sizes one list per power of two. The first and last words of a free
+ * block's data hold its list links and a copy of its size (the boundary
+ * tag), so that freeing a block merges it with both of its free
+ * neighbours at once and free blocks are never adjacent. Allocation
+ * takes a block from the smallest non-empty class that can satisfy the
+ * request, the lowest fitting one in a power of two class, and the
+ * number of allocated bytes is kept up to date, so neither allocation
+ * nor pcsl_mem_get_free_heap_impl0() has to walk the pool.
+ *
  * @warning This code is not thread safe.
  */
 
@@ -146,19 +159,26 @@ static void print_alloc(const char* what, char* filename, int lineno) {
 typedef struct _pcslMemStruct {
     unsigned short magic;                                    /* magic number */
     char           free;           /* 1 == block is free, 0 == block is used */
-#ifdef PCSL_DEBUG
-    char           guardSize;           /* Size of tail guard data; in bytes */
-#else
-    char           reserved;
-#endif 
+    char           prevFree;     /* 1 == block right below this one is free */
     unsigned int   size;                                    /* size of block */
 #ifdef PCSL_DEBUG
     char*          filename;         /* filename where allocation took place */
     unsigned int   lineno;        /* line number wehre allocation took place */
+    unsigned int   guardSize;           /* Size of tail guard data; in bytes */
     unsigned int   guard;                                    /* memory guard */
 #endif
 } _PcslMemHdr, *_PcslMemHdrPtr;
 
+/**
+ * Free list links, kept at the start of the data of a free block.
+ * Blocks are referred to by their offset from PcslMemoryStart, so that
+ * the links fit in the word-aligned data on 64-bit hosts too.
+ */
+typedef struct _pcslFreeLinks {
+    unsigned int   next;             /* next block in the same size class */
+    unsigned int   prev;         /* previous block in the same size class */
+} _PcslFreeLinks, *_PcslFreeLinksPtr;
+
 /*
  * Default size of pool usable for allocations; in bytes
  */
@@ -185,6 +205,47 @@ typedef struct _pcslMemStruct {
  */
 #define GUARD_SIZE    4
 
+/*
+ * Smallest block data size; a free block must hold its list links
+ * and its boundary tag
+ */
+#define MIN_BLOCK_SIZE (sizeof(_PcslFreeLinks) + sizeof(unsigned int))
+
+/*
+ * Block sizes below this limit have one free list per word-aligned size
+ */
+#define SMALL_BIN_LIMIT 256
+#define NUM_SMALL_BINS  (SMALL_BIN_LIMIT >> 2)
+
+/*
+ * Larger blocks have one free list per power of two, up to 2^31
+ */
+#define NUM_LARGE_BINS  24
+#define NUM_BINS        (NUM_SMALL_BINS + NUM_LARGE_BINS)
+#define BINMAP_WORDS    ((NUM_BINS + 31) >> 5)
+
+/*
+ * An allocation looks at no more than this many blocks of a free list,
+ * in no more than this many non-empty free lists, so that its cost is
+ * bounded however long the lists grow
+ */
+#define FIT_SCAN_BLOCKS 32
+#define FIT_SCAN_BINS   4
+#define FIT_SCAN_ALL    0x7FFFFFFF
+
+/*
+ * End of a free list
+ */
+#define NO_BLOCK      0xFFFFFFFF
+
+#define BLOCK_DATA(hdr)   ((char*)(hdr) + sizeof(_PcslMemHdr))
+#define NEXT_BLOCK(hdr)   ((_PcslMemHdrPtr)(BLOCK_DATA(hdr) + (hdr)->size))
+#define FREE_LINKS(hdr)   ((_PcslFreeLinksPtr)BLOCK_DATA(hdr))
+#define BOUNDARY_TAG(hdr) \
+    (*(unsigned int*)(BLOCK_DATA(hdr) + (hdr)->size - sizeof(unsigned int)))
+#define BLOCK_OFFSET(hdr) ((unsigned int)((char*)(hdr) - PcslMemoryStart))
+#define OFFSET_BLOCK(off) ((_PcslMemHdrPtr)(PcslMemoryStart + (off)))
+
 #ifdef PCSL_MEMORY_USE_STATIC
 /* Cannot allocate dynamic memory on the phone. Use static array. */
 static char PcslMemory[DEFAULT_POOL_SIZE];       /* Where PCSL memory starts */
@@ -196,12 +257,271 @@ static char* PcslMemoryStart;                /* Aligned start of PCSL memory */
 static char* PcslMemoryEnd;                                 /* End of memory */
 
 static int PcslMemoryHighWaterMark;
-static int PcslMemoryAllocated;
+static int PcslMemoryAllocated;              /* Data size of all used blocks */
+
+static unsigned int PcslFreeBins[NUM_BINS];   /* Heads of the free lists */
+static unsigned int PcslFreeBinMap[BINMAP_WORDS];  /* Non-empty free lists */
 
 static int pcsl_end_memory(int* count, int* size);
 
 static int verify_tail_guard_data(_PcslMemHdrPtr pcslMemoryHdr);
 
+/**
+ * @internal
+ *
+ * FUNCTION:      bin_index()
+ * TYPE:          private operation
+ * OVERVIEW:      Get the size class of a block
+ * INTERFACE:
+ *   parameters:  size    word-aligned block data size
+ *   returns:     index of the free list for blocks of that size
+ *                
+ */
+static int
+bin_index(unsigned int size) {
+    int bin;
+
+    if (size < SMALL_BIN_LIMIT) {
+        return size >> 2;
+    }
+
+    bin = NUM_SMALL_BINS;
+    for (size /= (SMALL_BIN_LIMIT << 1); size != 0; size >>= 1) {
+        bin++;
+    }
+    return bin;
+}
+
+/**
+ * @internal
+ *
+ * FUNCTION:      find_free_bin()
+ * TYPE:          private operation
+ * OVERVIEW:      Find the first non-empty free list at or above a
+ *                 size class
+ * INTERFACE:
+ *   parameters:  bin     size class to start from
+ *   returns:     index of the free list, or -1 if all are empty
+ *                
+ */
+static int
+find_free_bin(int bin) {
+    int          word = bin >> 5;
+    unsigned int bits;
+
+    if (word >= BINMAP_WORDS) {
+        return -1;
+    }
+
+    bits = PcslFreeBinMap[word] & (0xFFFFFFFF << (bin & 31));
+    while (bits == 0) {
+        if (++word >= BINMAP_WORDS) {
+            return -1;
+        }
+        bits = PcslFreeBinMap[word];
+    }
+
+    /* index of the lowest set bit */
+    bin = word << 5;
+    if ((bits & 0xFFFF) == 0) { bits >>= 16; bin += 16; }
+    if ((bits & 0xFF) == 0)   { bits >>= 8;  bin += 8; }
+    if ((bits & 0xF) == 0)    { bits >>= 4;  bin += 4; }
+    if ((bits & 0x3) == 0)    { bits >>= 2;  bin += 2; }
+    if ((bits & 0x1) == 0)    { bin += 1; }
+    return bin;
+}
+
+/**
+ * @internal
+ *
+ * FUNCTION:      insert_free_block()
+ * TYPE:          private operation
+ * OVERVIEW:      Mark a block free and put it on the free list of its
+ *                 size class
+ * INTERFACE:
+ *   parameters:  pcslMemoryHdr   Pointer to memory block header
+ *   returns:     <nothing>
+ *                
+ */
+static void
+insert_free_block(_PcslMemHdrPtr pcslMemoryHdr) {
+    int               bin    = bin_index(pcslMemoryHdr->size);
+    unsigned int      offset = BLOCK_OFFSET(pcslMemoryHdr);
+    _PcslFreeLinksPtr links  = FREE_LINKS(pcslMemoryHdr);
+    _PcslMemHdrPtr    nextHdr;
+
+    links->prev = NO_BLOCK;
+    links->next = PcslFreeBins[bin];
+    if (links->next != NO_BLOCK) {
+        FREE_LINKS(OFFSET_BLOCK(links->next))->prev = offset;
+    }
+    PcslFreeBins[bin] = offset;
+    PcslFreeBinMap[bin >> 5] |= 1U << (bin & 31);
+
+    pcslMemoryHdr->free = 1;
+    BOUNDARY_TAG(pcslMemoryHdr) = pcslMemoryHdr->size;
+
+    nextHdr = NEXT_BLOCK(pcslMemoryHdr);
+    if ((char*)nextHdr < PcslMemoryEnd) {
+        nextHdr->prevFree = 1;
+    }
+}
+
+/**
+ * @internal
+ *
+ * FUNCTION:      remove_free_block()
+ * TYPE:          private operation
+ * OVERVIEW:      Take a free block off the free list of its size class
+ * INTERFACE:
+ *   parameters:  pcslMemoryHdr   Pointer to memory block header
+ *   returns:     <nothing>
+ *                
+ */
+static void
+remove_free_block(_PcslMemHdrPtr pcslMemoryHdr) {
+    _PcslFreeLinksPtr links = FREE_LINKS(pcslMemoryHdr);
+    int               bin;
+
+    if (links->next != NO_BLOCK) {
+        FREE_LINKS(OFFSET_BLOCK(links->next))->prev = links->prev;
+    }
+    if (links->prev != NO_BLOCK) {
+        FREE_LINKS(OFFSET_BLOCK(links->prev))->next = links->next;
+    } else {
+        bin = bin_index(pcslMemoryHdr->size);
+        PcslFreeBins[bin] = links->next;
+        if (links->next == NO_BLOCK) {
+            PcslFreeBinMap[bin >> 5] &= ~(1U << (bin & 31));
+        }
+    }
+}
+
+/**
+ * @internal
+ *
+ * FUNCTION:      lowest_fit()
+ * TYPE:          private operation
+ * OVERVIEW:      Find the lowest of the first blocks of a free list
+ *                 that is large enough for an allocation
+ * INTERFACE:
+ *   parameters:  bin     size class to search
+ *                size    word-aligned number of bytes needed
+ *                limit   number of blocks to look at
+ *   returns:     pointer to the block header, or NULL if none of
+ *                 those blocks is large enough
+ *                
+ */
+static _PcslMemHdrPtr
+lowest_fit(int bin, unsigned int size, int limit) {
+    unsigned int   offset;
+    unsigned int   lowest = NO_BLOCK;
+    int            count  = 0;
+
+    for (offset = PcslFreeBins[bin];
+         offset != NO_BLOCK && count < limit;
+         offset = FREE_LINKS(OFFSET_BLOCK(offset))->next, count++) {
+        if (offset < lowest && OFFSET_BLOCK(offset)->size >= size) {
+            lowest = offset;
+        }
+    }
+    return (lowest != NO_BLOCK) ? OFFSET_BLOCK(lowest) : NULL;
+}
+
+/**
+ * @internal
+ *
+ * FUNCTION:      find_free_block()
+ * TYPE:          private operation
+ * OVERVIEW:      Find a free block large enough for an allocation
+ * INTERFACE:
+ *   parameters:  size    word-aligned number of bytes needed
+ *   returns:     pointer to the block header, or NULL if no free
+ *                 block is large enough
+ *                
+ */
+static _PcslMemHdrPtr
+find_free_block(unsigned int size) {
+    _PcslMemHdrPtr lowest = NULL;
+    _PcslMemHdrPtr pcslMemoryHdr;
+    int            first = bin_index(size);
+    int            bin;
+    int            count = 0;
+
+    /*
+     * Taking the lowest fitting block of the first few non-empty size
+     * classes, rather than the first block of the first class, keeps
+     * used blocks packed towards the start of the pool like the address
+     * ordered first fit this replaced did.
+     */
+    for (bin = find_free_bin(first);
+         bin >= 0 && (count < FIT_SCAN_BINS || lowest == NULL);
+         bin = find_free_bin(bin + 1), count++) {
+        pcslMemoryHdr = lowest_fit(bin, size, FIT_SCAN_BLOCKS);
+        if (pcslMemoryHdr != NULL &&
+            (lowest == NULL || pcslMemoryHdr < lowest)) {
+            lowest = pcslMemoryHdr;
+        }
+    }
+
+    /*
+     * Any block of a larger class fits, but sizes within a large class
+     * differ: only when the pool is nearly full does the rest of the
+     * list of the requested class have to be searched
+     */
+    if (lowest == NULL && first >= NUM_SMALL_BINS) {
+        lowest = lowest_fit(first, size, FIT_SCAN_ALL);
+    }
+    return lowest;
+}
+
+/**
+ * @internal
+ *
+ * FUNCTION:      release_block()
+ * TYPE:          private operation
+ * OVERVIEW:      Free a used block, coalescing it with its free
+ *                 neighbours
+ * INTERFACE:
+ *   parameters:  pcslMemoryHdr   Pointer to memory block header
+ *   returns:     <nothing>
+ *                
+ */
+static void
+release_block(_PcslMemHdrPtr pcslMemoryHdr) {
+    _PcslMemHdrPtr tempHdr;
+
+    PcslMemoryAllocated -= pcslMemoryHdr->size;
+
+    tempHdr = NEXT_BLOCK(pcslMemoryHdr);
+    if (((char*)tempHdr < PcslMemoryEnd) &&
+        (tempHdr->free == 1) && (tempHdr->magic == MAGIC)) {
+        REPORT2("DEBUG: Coalescing blocks 0x%p and 0x%p\n",
+                pcslMemoryHdr, tempHdr);
+        remove_free_block(tempHdr);
+        pcslMemoryHdr->size += tempHdr->size + sizeof(_PcslMemHdr);
+    }
+
+    if (pcslMemoryHdr->prevFree == 1) {
+        tempHdr = (_PcslMemHdrPtr)((char*)pcslMemoryHdr 
+                                   - *((unsigned int*)pcslMemoryHdr - 1)
+                                   - sizeof(_PcslMemHdr));
+        REPORT2("DEBUG: Coalescing blocks 0x%p and 0x%p\n",
+                tempHdr, pcslMemoryHdr);
+        remove_free_block(tempHdr);
+        tempHdr->size += pcslMemoryHdr->size + sizeof(_PcslMemHdr);
+        /* the absorbed header stays in memory: a second free of the
+           block must still see it as free */
+        pcslMemoryHdr->free = 1;
+        pcslMemoryHdr = tempHdr;
+    }
+
+#ifdef PCSL_DEBUG
+    pcslMemoryHdr->guardSize = 0;
+#endif
+    insert_free_block(pcslMemoryHdr);
+}
+
 /**
  * @internal
  *
@@ -218,15 +538,18 @@ static int
 pcsl_end_memory(int* count, int* size) {
     _PcslMemHdrPtr pcslMemoryHdr;
     char*          pcslMemoryPtr;
+    unsigned int   blockSize;
 
     *count = 0;
     *size  = 0;
 
     for (pcslMemoryPtr = PcslMemoryStart; 
          pcslMemoryPtr < PcslMemoryEnd;
-         pcslMemoryPtr += pcslMemoryHdr->size + sizeof(_PcslMemHdr)) {
+         pcslMemoryPtr += blockSize + sizeof(_PcslMemHdr)) {
 
         pcslMemoryHdr = (_PcslMemHdrPtr)pcslMemoryPtr;
+        /* freeing a leaked block may merge it with its neighbours */
+        blockSize = pcslMemoryHdr->size;
 
         if (pcslMemoryHdr->magic != MAGIC) {
             REPORT1("ERROR: Corrupted start of memory header: 0x%p\n", 
@@ -261,7 +584,7 @@ pcsl_end_memory(int* count, int* size) {
 #endif
             pcsl_mem_free((void*)((char*)pcslMemoryHdr + sizeof(_PcslMemHdr)));
             *count += 1;
-            *size  += pcslMemoryHdr->size;
+            *size  += blockSize;
         }
     }
     return *count;
@@ -285,6 +608,7 @@ pcsl_end_memory(int* count, int* size) {
 int
 pcsl_mem_initialize_impl0(void *startAddr, int size) {
     _PcslMemHdrPtr pcslMemoryHdr;
+    int            i;
 
     if (PcslMemoryStart != NULL) {
         /* avoid a double init */
@@ -321,13 +645,26 @@ pcsl_mem_initialize_impl0(void *startAddr, int size) {
 
     pcslMemoryHdr = (_PcslMemHdrPtr)PcslMemoryStart;
     pcslMemoryHdr->magic = MAGIC;
-    pcslMemoryHdr->free  = 1;
-    pcslMemoryHdr->size  = (PcslMemory - PcslMemoryStart)
-                           + size - sizeof(_PcslMemHdr);
+    pcslMemoryHdr->prevFree = 0;
+    pcslMemoryHdr->size  = ((PcslMemory - PcslMemoryStart)
+                            + size - sizeof(_PcslMemHdr)) & ~ALIGNMENT;
 #ifdef PCSL_DEBUG
     pcslMemoryHdr->guard = GUARD_WORD;
     pcslMemoryHdr->guardSize = 0;
 #endif
+    /* keep the boundary tag of the last block word-aligned */
+    PcslMemoryEnd = PcslMemoryStart + pcslMemoryHdr->size;
+
+    for (i = 0; i < NUM_BINS; i++) {
+        PcslFreeBins[i] = NO_BLOCK;
+    }
+    for (i = 0; i < BINMAP_WORDS; i++) {
+        PcslFreeBinMap[i] = 0;
+    }
+    PcslMemoryAllocated = 0;
+    PcslMemoryHighWaterMark = 0;
+
+    insert_free_block(pcslMemoryHdr);
     return 0;
 }
 
@@ -385,10 +722,8 @@ pcsl_mem_malloc_impl0(unsigned int size) {
 #endif
     unsigned int   numBytesToAllocate = size;
     void*          loc     = NULL;
-    _PcslMemHdrPtr tempHdr = NULL;
-    char*          temp    = NULL;
-    char*          pcslMemoryPtr;
     _PcslMemHdrPtr pcslMemoryHdr;
+    _PcslMemHdrPtr nextHdr;
 
 #ifdef PCSL_DEBUG
     int   guardSize = 0;
@@ -397,102 +732,79 @@ pcsl_mem_malloc_impl0(unsigned int size) {
     numBytesToAllocate += GUARD_SIZE;
 #endif
 
-    while ( (numBytesToAllocate & ALIGNMENT) != 0 ) {
-        numBytesToAllocate++;
+    numBytesToAllocate = (numBytesToAllocate + ALIGNMENT) & ~ALIGNMENT;
+    if (numBytesToAllocate < size) {
+        /* wrapped around */
+        REPORT1("DEBUG: Unable to allocate %u bytes\n", size);
+        return((void *)0);
+    }
+    if (numBytesToAllocate < MIN_BLOCK_SIZE) {
+        numBytesToAllocate = MIN_BLOCK_SIZE;
     }
 
     /* find a free slot */
-    for (pcslMemoryPtr = PcslMemoryStart;
-         pcslMemoryPtr < PcslMemoryEnd;
-         pcslMemoryPtr += pcslMemoryHdr->size + sizeof(_PcslMemHdr)) {
-        
-        pcslMemoryHdr = (_PcslMemHdrPtr)pcslMemoryPtr;
-        if (pcslMemoryHdr->magic != MAGIC) {
-            REPORT1("ERROR: Memory corruption at 0x%p\n", pcslMemoryPtr); 
-            return((void *) 0);
-        } else {
-            while ( 1 ) {
-                /* coalescing */
-                if (pcslMemoryHdr->free == 1) {
-                    /* if current block is free */
-                    temp = (char*)pcslMemoryHdr;
-                    temp += pcslMemoryHdr->size + sizeof(_PcslMemHdr);
-                    tempHdr = (_PcslMemHdrPtr)temp;
-
-                    if ((temp < PcslMemoryEnd) && 
-                        (tempHdr->free == 1) && (tempHdr->magic == MAGIC)) {
-                        /* and the next block is free too */
-                        /* then coalesce */
-                        pcslMemoryHdr->size += tempHdr->size
-                            + sizeof(_PcslMemHdr);
+    pcslMemoryHdr = find_free_block(numBytesToAllocate);
+    if (pcslMemoryHdr == NULL) {
+        REPORT1("DEBUG: Unable to allocate %d bytes\n", numBytesToAllocate);
+        return((void *)0);
+    }
+    if (pcslMemoryHdr->magic != MAGIC) {
+        REPORT1("ERROR: Memory corruption at 0x%p\n", pcslMemoryHdr); 
+        return((void *) 0);
+    }
+    remove_free_block(pcslMemoryHdr);
+
+    if (pcslMemoryHdr->size >= (numBytesToAllocate 
+                                + sizeof(_PcslMemHdr) + MIN_BLOCK_SIZE)) {
+        /* split block, the tail goes back to the free lists */
+        nextHdr = (_PcslMemHdrPtr)((char *)pcslMemoryHdr
+                                   + numBytesToAllocate
+                                   + sizeof(_PcslMemHdr));
+        nextHdr->magic = MAGIC;
+        nextHdr->prevFree = 0;
+        nextHdr->size = pcslMemoryHdr->size 
+                        - numBytesToAllocate 
+                        - sizeof(_PcslMemHdr);
 #ifdef PCSL_DEBUG
-                        pcslMemoryHdr->guardSize = 0;
+        nextHdr->guard    = GUARD_WORD;
+        nextHdr->guardSize = 0;
 #endif
-                        REPORT2("DEBUG: Coalescing blocks 0x%p and 0x%p\n",
-                                pcslMemoryHdr, tempHdr);
+        pcslMemoryHdr->size     = numBytesToAllocate;
+        insert_free_block(nextHdr);
+    } else {
+        nextHdr = NEXT_BLOCK(pcslMemoryHdr);
+        if ((char*)nextHdr < PcslMemoryEnd) {
+            nextHdr->prevFree = 0;
+        }
+    }
+    pcslMemoryHdr->free     = 0;
+    loc = (void*)((char*)pcslMemoryHdr + sizeof(_PcslMemHdr));
 
-                    } else {
-                        break;
-                    }
-                } else {
-                    break;
-                }
-            } /* while */
-
-            /* allocating */
-            if ((pcslMemoryHdr->free == 1) && 
-                (pcslMemoryHdr->size >= numBytesToAllocate)) {
-                if (pcslMemoryHdr->size > (numBytesToAllocate 
-                                              + sizeof(_PcslMemHdr) + 4)) {
-                    /* split block */
-                    _PcslMemHdrPtr nextHdr;
-                    nextHdr = (_PcslMemHdrPtr)((char *)pcslMemoryPtr
-                                               + numBytesToAllocate
-                                               + sizeof(_PcslMemHdr));
-                    nextHdr->magic = MAGIC;
-                    nextHdr->free = 1;
-                    nextHdr->size = pcslMemoryHdr->size 
-                                    - numBytesToAllocate 
-                                    - sizeof(_PcslMemHdr);
-#ifdef PCSL_DEBUG
-                    nextHdr->guard    = GUARD_WORD;
-                    nextHdr->guardSize = 0;
-#endif
-                    pcslMemoryHdr->size     = numBytesToAllocate;
-                }
-                pcslMemoryHdr->free     = 0;
-                loc = (void*)((char*)pcslMemoryHdr + sizeof(_PcslMemHdr));
+    PcslMemoryAllocated += pcslMemoryHdr->size;
+    if (PcslMemoryAllocated > PcslMemoryHighWaterMark) {
+        PcslMemoryHighWaterMark = PcslMemoryAllocated;
+    }
 
 #ifdef PCSL_DEBUG
-                pcslMemoryHdr->guard    = GUARD_WORD;      /* Add head guard */
-                pcslMemoryHdr->filename = filename;
-                pcslMemoryHdr->lineno   = lineno;
-
-                /* Add tail guard */
-                guardSize = pcslMemoryHdr->size - size;
-
-                pcslMemoryHdr->guardSize = guardSize;
-                guardPos = (void*)((char*)loc + pcslMemoryHdr->size 
-                                   - guardSize);
-                for(i=0; i<guardSize; i++) {
-                    ((unsigned char*)guardPos)[i] = GUARD_BYTE;
-                }
-                
-                PcslMemoryAllocated += numBytesToAllocate;
-                if (PcslMemoryAllocated > PcslMemoryHighWaterMark) {
-                    PcslMemoryHighWaterMark = PcslMemoryAllocated;
-                }
+    pcslMemoryHdr->guard    = GUARD_WORD;      /* Add head guard */
+    pcslMemoryHdr->filename = filename;
+    pcslMemoryHdr->lineno   = lineno;
+
+    /* Add tail guard */
+    guardSize = pcslMemoryHdr->size - size;
+
+    pcslMemoryHdr->guardSize = guardSize;
+    guardPos = (void*)((char*)loc + pcslMemoryHdr->size 
+                       - guardSize);
+    for(i=0; i<guardSize; i++) {
+        ((unsigned char*)guardPos)[i] = GUARD_BYTE;
+    }
 
-                report("DEBUG: Requested %d provided %d at 0x%p\n",
-                       numBytesToAllocate, pcslMemoryHdr->size, loc);
-                print_alloc("allocated", filename, lineno);
+    report("DEBUG: Requested %d provided %d at 0x%p\n",
+           numBytesToAllocate, pcslMemoryHdr->size, loc);
+    print_alloc("allocated", filename, lineno);
 #endif
-                return(loc);
-            } /* end of allocating */
-        } /* end of else */
-    } /* end of for */
-    REPORT1("DEBUG: Unable to allocate %d bytes\n", numBytesToAllocate);
-    return((void *)0);
+    return(loc);
 }
 
 /**
@@ -664,8 +976,8 @@ pcsl_mem_free_impl0(void *ptr, char *filename, int lineno) {
     if (ptr == NULL) {
         report("WARNING: Attempt to free NULL pointer\n");
         print_alloc("freed", filename, lineno);
-    } else if (((char*)ptr > PcslMemoryEnd) || 
-               ((char*)ptr < PcslMemoryStart)) {
+    } else if (((char*)ptr >= PcslMemoryEnd + sizeof(_PcslMemHdr)) || 
+               ((char*)ptr < PcslMemoryStart + sizeof(_PcslMemHdr))) {
         report("ERROR: Attempt to free memory out of scope: 0x%p\n", ptr);
         print_alloc("freed", filename, lineno);
     } else {
@@ -677,7 +989,6 @@ pcsl_mem_free_impl0(void *ptr, char *filename, int lineno) {
             report("ERROR: Attempt to free memory twice: 0x%p\n", ptr);
             print_alloc("freed", filename, lineno);
         } else {
-            PcslMemoryAllocated -= pcslMemoryHdr->size;
             /* The memory block header is valid, now check the guard data */
             if (pcslMemoryHdr->guard != GUARD_WORD) {
                 report("ERROR: Possible memory underrun: 0x%p\n", ptr);
@@ -697,7 +1008,7 @@ pcsl_mem_free_impl0(void *ptr, char *filename, int lineno) {
             print_alloc("allocated", 
                         pcslMemoryHdr->filename, pcslMemoryHdr->lineno);
             print_alloc("freed", filename, lineno);
-            pcslMemoryHdr->free = 1;
+            release_block(pcslMemoryHdr);
         }
     } /* end of else */
 }
@@ -709,14 +1020,14 @@ pcsl_mem_free_impl0(void *ptr) {
     _PcslMemHdrPtr pcslMemoryHdr;
 
     if (ptr == NULL) {
-    } else if (((char*)ptr > PcslMemoryEnd) || 
-               ((char*)ptr < PcslMemoryStart)) {
+    } else if (((char*)ptr >= PcslMemoryEnd + sizeof(_PcslMemHdr)) || 
+               ((char*)ptr < PcslMemoryStart + sizeof(_PcslMemHdr))) {
     } else {
         pcslMemoryHdr = (_PcslMemHdrPtr)((char*)ptr -sizeof(_PcslMemHdr));
         if (pcslMemoryHdr->magic != MAGIC) {
         } else if (pcslMemoryHdr->free != 0) {
         } else {
-            pcslMemoryHdr->free = 1;
+            release_block(pcslMemoryHdr);
         }
     } /* end of else */
 }
@@ -782,17 +1093,18 @@ pcsl_mem_get_total_heap_impl0() {
  */
 int
 pcsl_mem_get_free_heap_impl0() {
+#ifdef PCSL_DEBUG
     _PcslMemHdrPtr pcslMemoryHdr;
     char*          pcslMemoryPtr;
     int            size = 0;
 
+    /* check the pool while at it; the walk is not needed for the result */
     for (pcslMemoryPtr = PcslMemoryStart; 
          pcslMemoryPtr < PcslMemoryEnd;
          pcslMemoryPtr += pcslMemoryHdr->size + sizeof(_PcslMemHdr)) {
 
         pcslMemoryHdr = (_PcslMemHdrPtr)pcslMemoryPtr;
 
-#ifdef PCSL_DEBUG
         if (pcslMemoryHdr->magic != MAGIC) {
             report("ERROR: Corrupted start of memory header: 0x%p\n", 
                    pcslMemoryPtr);
@@ -812,13 +1124,19 @@ pcsl_mem_get_free_heap_impl0() {
                         pcslMemoryHdr->filename, 
                         pcslMemoryHdr->lineno);
         }
-#endif
 
         if (pcslMemoryHdr->free != 1) {
             size += pcslMemoryHdr->size;
         }
     }
-    return (pcsl_mem_get_total_heap_impl0() - size);
+
+    if (size != PcslMemoryAllocated) {
+        report("ERROR: Counted %d allocated bytes, expected %d\n",
+               size, PcslMemoryAllocated);
+    }
+#endif
+
+    return (pcsl_mem_get_total_heap_impl0() - PcslMemoryAllocated);
 }
 
 
@@ -0,0 +1,454 @@
+/*
+ *   
+ *
+ * Copyright  1990-2007 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+
+/**
+ * @file
+ *
+ * Replays an allocation trace against the PCSL memory pool, to compare
+ * pool implementations (e.g. MEMORY_MODULE=heap and MEMORY_MODULE=malloc,
+ * or two revisions of one of them) on the same sequence of requests.
+ *
+ * A trace is a text file with one request per line:
+ * <pre>
+ *   a &lt;id&gt; &lt;size&gt;    pcsl_mem_malloc(size), remembered as id
+ *   r &lt;id&gt; &lt;size&gt;    pcsl_mem_realloc() of block id
+ *   f &lt;id&gt;           pcsl_mem_free() of block id
+ * </pre>
+ * Lines starting with '#' are ignored. <code>memtrace -g</code> writes a
+ * synthetic trace, so a run can be repeated from its seed alone.
+ *
+ * For every trace the tool reports how many allocations failed, the
+ * average time of a request over the fastest of several replays and the
+ * fragmentation of the pool sampled along the way: the share of the free
+ * heap that is not available as one block.
+ *
+ * <p>Build with <code>make memtrace</code> in the heap module directory;
+ * the tool only uses the public pcsl_mem_* interface.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pcsl_memory.h>
+
+/*
+ * Default size of the pool to replay a trace in; in bytes
+ */
+#define DEFAULT_HEAP_SIZE  (2 * 1024 * 1024)
+
+/*
+ * Default number of timed replays, the fastest one is reported
+ */
+#define DEFAULT_REPEAT     5
+
+/*
+ * Number of fragmentation samples taken over one replay
+ */
+#define NUM_SAMPLES        64
+
+/*
+ * Upper bound of the data allocated at once by a synthetic trace
+ */
+#define SYNTHETIC_LIVE_LIMIT (1024 * 1024)
+
+/**
+ * One request of a trace
+ */
+typedef struct _traceOp {
+    char          op;                                 /* 'a', 'r' or 'f' */
+    unsigned int  id;                              /* block the op is for */
+    unsigned int  size;                  /* requested size, for 'a', 'r' */
+} TraceOp;
+
+/**
+ * Result of one replay
+ */
+typedef struct _replayStats {
+    int    failed;               /* allocations that returned NULL */
+    int    samples;                     /* fragmentation samples taken */
+    double fragSum;                     /* sum of sampled fragmentation */
+    double fragMax;                 /* largest sampled fragmentation */
+    int    minFree;                  /* smallest sampled free heap size */
+} ReplayStats;
+
+static unsigned long randomSeed;
+
+/**
+ * Returns the next number of a fixed linear congruential sequence,
+ * so that a synthetic trace is the same on every platform.
+ */
+static unsigned int
+next_random(unsigned int range) {
+    randomSeed = (randomSeed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+    return (unsigned int)((randomSeed >> 8) % range);
+}
+
+/**
+ * Writes a synthetic trace to stdout.
+ *
+ * The sizes follow the native allocations of a MIDP stack: mostly
+ * small structures and strings, some buffers and a few decoded
+ * images. About one small block in eight lives until the end of the
+ * trace, up to a quarter of the data, the others are freed or resized
+ * in random order.
+ *
+ * @param seed start of the random sequence
+ * @param count number of requests to write
+ */
+static void
+generate_trace(unsigned long seed, int count) {
+    unsigned int* live;                           /* blocks freed at random */
+    unsigned int* liveSize;
+    int           numLive = 0;
+    unsigned int* kept;                         /* blocks freed at the end */
+    int           numKept = 0;
+    unsigned int  liveBytes = 0;
+    unsigned int  keptBytes = 0;
+    unsigned int  nextId = 0;
+    unsigned int  size;
+    unsigned int  kind;
+    int           i, j;
+
+    live     = (unsigned int*)malloc(count * sizeof(unsigned int));
+    liveSize = (unsigned int*)malloc(count * sizeof(unsigned int));
+    kept     = (unsigned int*)malloc(count * sizeof(unsigned int));
+    if (live == NULL || liveSize == NULL || kept == NULL) {
+        fprintf(stderr, "memtrace: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    randomSeed = seed;
+    printf("# memtrace -g %lu %d\n", seed, count);
+
+    for (i = 0; i < count; i++) {
+        kind = next_random(100);
+        if (kind < 70) {
+            size = 8 + next_random(121);
+        } else if (kind < 92) {
+            size = 128 + next_random(1921);
+        } else if (kind < 99) {
+            size = 2048 + next_random(30721);
+        } else {
+            size = 32768 + next_random(229377);
+        }
+
+        if (numLive > 0 &&
+            (liveBytes + size > SYNTHETIC_LIVE_LIMIT || 
+             next_random(100) < 45)) {
+            j = next_random(numLive);
+            if (next_random(100) < 10) {
+                /* resize instead of free */
+                printf("r %u %u\n", live[j], size);
+                liveBytes += size - liveSize[j];
+                liveSize[j] = size;
+                continue;
+            }
+            printf("f %u\n", live[j]);
+            liveBytes -= liveSize[j];
+            numLive--;
+            live[j] = live[numLive];
+            liveSize[j] = liveSize[numLive];
+            continue;
+        }
+
+        printf("a %u %u\n", nextId, size);
+        liveBytes += size;
+        if (kind < 92 && next_random(8) == 0 &&
+            keptBytes + size <= SYNTHETIC_LIVE_LIMIT / 4) {
+            kept[numKept++] = nextId;
+            keptBytes += size;
+        } else {
+            live[numLive] = nextId;
+            liveSize[numLive] = size;
+            numLive++;
+        }
+        nextId++;
+    }
+
+    for (j = 0; j < numLive; j++) {
+        printf("f %u\n", live[j]);
+    }
+    for (j = 0; j < numKept; j++) {
+        printf("f %u\n", kept[j]);
+    }
+
+    free(live);
+    free(liveSize);
+    free(kept);
+}
+
+/**
+ * Reads a trace.
+ *
+ * @param filename name of the trace file
+ * @param numOps address to store the number of requests
+ * @param numIds address to store the number of distinct block ids
+ *
+ * @return the requests, or NULL on error
+ */
+static TraceOp*
+load_trace(const char* filename, int* numOps, unsigned int* numIds) {
+    FILE*    f;
+    char     line[128];
+    TraceOp* ops = NULL;
+    TraceOp* grown;
+    int      capacity = 0;
+    int      n = 0;
+    int      fields;
+
+    f = fopen(filename, "r");
+    if (f == NULL) {
+        fprintf(stderr, "memtrace: cannot open %s\n", filename);
+        return NULL;
+    }
+
+    *numIds = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (n == capacity) {
+            capacity = capacity ? capacity * 2 : 4096;
+            grown = (TraceOp*)realloc(ops, capacity * sizeof(TraceOp));
+            if (grown == NULL) {
+                fprintf(stderr, "memtrace: out of memory\n");
+                free(ops);
+                fclose(f);
+                return NULL;
+            }
+            ops = grown;
+        }
+
+        ops[n].size = 0;
+        fields = sscanf(line, "%c %u %u", &ops[n].op, &ops[n].id,
+                        &ops[n].size);
+        if ((ops[n].op == 'f' && fields < 2) ||
+            ((ops[n].op == 'a' || ops[n].op == 'r') && fields < 3) ||
+            (ops[n].op != 'a' && ops[n].op != 'r' && ops[n].op != 'f')) {
+            fprintf(stderr, "memtrace: bad request: %s", line);
+            free(ops);
+            fclose(f);
+            return NULL;
+        }
+        if (ops[n].id >= *numIds) {
+            *numIds = ops[n].id + 1;
+        }
+        n++;
+    }
+
+    fclose(f);
+    *numOps = n;
+    return ops;
+}
+
+/**
+ * Finds the largest block that can be allocated, by bisection.
+ *
+ * @param freeHeap current amount of unused heap
+ *
+ * @return size of the largest block, in bytes
+ */
+static int
+largest_block(int freeHeap) {
+    int   lo = 0;
+    int   hi = freeHeap;
+    int   mid;
+    void* p;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo + 1) / 2;
+        p = pcsl_mem_malloc(mid);
+        if (p != NULL) {
+            pcsl_mem_free(p);
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Replays a trace once in a fresh pool.
+ *
+ * @param ops requests to replay
+ * @param numOps number of requests
+ * @param slots one pointer per block id, all NULL
+ * @param numIds number of block ids
+ * @param heapSize size of the pool
+ * @param sampleEvery take a fragmentation sample every so many
+ *        requests, or 0 to take none
+ * @param stats address to store the results
+ */
+static void
+replay(TraceOp* ops, int numOps, void** slots, unsigned int numIds,
+       int heapSize, int sampleEvery, ReplayStats* stats) {
+    void*        p;
+    int          freeHeap;
+    int          largest;
+    double       frag;
+    int          i;
+    unsigned int id;
+
+    memset(stats, 0, sizeof(ReplayStats));
+    stats->minFree = heapSize;
+
+    pcsl_mem_initialize(NULL, heapSize);
+
+    for (i = 0; i < numOps; i++) {
+        switch (ops[i].op) {
+        case 'a':
+            p = pcsl_mem_malloc(ops[i].size);
+            if (p == NULL) {
+                stats->failed++;
+            } else if (slots[ops[i].id] != NULL) {
+                /* the trace reuses a live id, drop the old block */
+                pcsl_mem_free(slots[ops[i].id]);
+            }
+            slots[ops[i].id] = p;
+            break;
+        case 'r':
+            p = pcsl_mem_realloc(slots[ops[i].id], ops[i].size);
+            if (p == NULL && ops[i].size != 0) {
+                /* the old block is still valid */
+                stats->failed++;
+            } else {
+                slots[ops[i].id] = p;
+            }
+            break;
+        default:
+            if (slots[ops[i].id] != NULL) {
+                pcsl_mem_free(slots[ops[i].id]);
+                slots[ops[i].id] = NULL;
+            }
+            break;
+        }
+
+        if (sampleEvery > 0 && (i + 1) % sampleEvery == 0) {
+            freeHeap = pcsl_mem_get_free_heap();
+            if (freeHeap > 0) {
+                largest = largest_block(freeHeap);
+                frag = 100.0 * (freeHeap - largest) / freeHeap;
+                stats->fragSum += frag;
+                if (frag > stats->fragMax) {
+                    stats->fragMax = frag;
+                }
+                if (freeHeap < stats->minFree) {
+                    stats->minFree = freeHeap;
+                }
+                stats->samples++;
+            }
+        }
+    }
+
+    for (id = 0; id < numIds; id++) {
+        if (slots[id] != NULL) {
+            pcsl_mem_free(slots[id]);
+            slots[id] = NULL;
+        }
+    }
+
+    pcsl_mem_finalize();
+}
+
+static void
+usage() {
+    fprintf(stderr,
+            "usage: memtrace [-m heapsize] [-n repeat] tracefile\n"
+            "       memtrace -g seed count > tracefile\n");
+    exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char** argv) {
+    int          heapSize = DEFAULT_HEAP_SIZE;
+    int          repeat = DEFAULT_REPEAT;
+    TraceOp*     ops;
+    int          numOps;
+    unsigned int numIds;
+    void**       slots;
+    ReplayStats  stats;
+    clock_t      start;
+    clock_t      best = 0;
+    int          i;
+
+    for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+        if (strcmp(argv[i], "-g") == 0 && i + 2 < argc) {
+            generate_trace(strtoul(argv[i + 1], NULL, 10),
+                           atoi(argv[i + 2]));
+            return 0;
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            heapSize = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else {
+            usage();
+        }
+    }
+    if (i != argc - 1 || heapSize <= 0 || repeat <= 0) {
+        usage();
+    }
+
+    ops = load_trace(argv[i], &numOps, &numIds);
+    if (ops == NULL) {
+        return EXIT_FAILURE;
+    }
+    slots = (void**)calloc(numIds ? numIds : 1, sizeof(void*));
+    if (slots == NULL) {
+        fprintf(stderr, "memtrace: out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < repeat; i++) {
+        start = clock();
+        replay(ops, numOps, slots, numIds, heapSize, 0, &stats);
+        start = clock() - start;
+        if (i == 0 || start < best) {
+            best = start;
+        }
+    }
+    printf("requests:         %d\n", numOps);
+    printf("heap size:        %d\n", heapSize);
+    printf("failed:           %d\n", stats.failed);
+    printf("time per request: %.1f ns\n",
+           numOps ? (double)best * 1e9 / CLOCKS_PER_SEC / numOps : 0.0);
+
+    replay(ops, numOps, slots, numIds, heapSize,
+           numOps / NUM_SAMPLES > 0 ? numOps / NUM_SAMPLES : 1, &stats);
+    if (stats.samples > 0) {
+        printf("fragmentation:    %.1f%% mean, %.1f%% max\n",
+               stats.fragSum / stats.samples, stats.fragMax);
+        printf("lowest free heap: %d\n", stats.minFree);
+    } else {
+        printf("fragmentation:    not available\n");
+    }
+
+    free(slots);
+    free(ops);
+    return 0;
+}
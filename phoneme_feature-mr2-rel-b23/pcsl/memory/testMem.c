@@ -274,6 +274,105 @@ void testStrdup() {
     pcsl_mem_free(str2);
 }
 
+/*
+ * Test that blocks freed in an arbitrary order are merged again
+ *
+ * Allocate a row of buffers, free every other one and then the rest
+ * in reverse order, checking that the buffers still in use are intact
+ * and that all of the heap is available again afterwards.
+ */
+void testFreeOrder() {
+    enum { NUM_BUFFERS = 12 };
+    unsigned char *buffers[NUM_BUFFERS];
+    int spcBefore;
+    int spcAfter;
+    int i, j;
+    void *buffer;
+
+    spcBefore = pcsl_mem_get_free_heap();
+
+    for (i = 0; i < NUM_BUFFERS; i++) {
+        buffers[i] = (unsigned char*)pcsl_mem_malloc(40 + i * 24);
+        assertTrue("failed to allocate a buffer", buffers[i] != NULL);
+        memset(buffers[i], i, 40 + i * 24);
+    }
+
+    for (i = 0; i < NUM_BUFFERS; i += 2) {
+        pcsl_mem_free(buffers[i]);
+    }
+
+    for (i = NUM_BUFFERS - 1; i >= 0; i -= 2) {
+        for (j = 0; j < 40 + i * 24; j++) {
+            if (buffers[i][j] != i) {
+                break;
+            }
+        }
+        assertTrue("buffer corrupted by freeing its neighbours",
+                   j == 40 + i * 24);
+        pcsl_mem_free(buffers[i]);
+    }
+
+    spcAfter = pcsl_mem_get_free_heap();
+
+    if (spcAfter != -1) {
+        assertTrue("free heap not restored after freeing all buffers",
+                   spcBefore == spcAfter);
+
+        /* only fits if the freed buffers were merged */
+        buffer = pcsl_mem_malloc(spcAfter / 2);
+        assertTrue("freed buffers were not merged", buffer != NULL);
+        pcsl_mem_free(buffer);
+    }
+}
+
+/*
+ * Test that freeing a block twice does not corrupt the heap when the
+ * first free merged the block with its free left neighbour
+ */
+void testFreeAfterMerge() {
+    unsigned char *a, *b, *c, *d;
+    int spcBefore;
+    int spcAfter;
+    int i;
+
+    spcBefore = pcsl_mem_get_free_heap();
+
+    a = (unsigned char*)pcsl_mem_malloc(40);
+    b = (unsigned char*)pcsl_mem_malloc(40);
+    c = (unsigned char*)pcsl_mem_malloc(40);
+    assertTrue("failed to allocate a buffer",
+               a != NULL && b != NULL && c != NULL);
+    memset(c, 0x5A, 40);
+
+    pcsl_mem_free(a);
+    pcsl_mem_free(b);
+    /* the error is reported in debug mode and must be ignored */
+    pcsl_mem_free(b);
+
+    d = (unsigned char*)pcsl_mem_malloc(100);
+    assertTrue("failed to allocate a buffer", d != NULL);
+    assertTrue("buffer overlaps a buffer in use",
+               d + 100 <= c || d >= c + 40);
+    memset(d, 0xA5, 100);
+
+    for (i = 0; i < 40; i++) {
+        if (c[i] != 0x5A) {
+            break;
+        }
+    }
+    assertTrue("buffer corrupted by freeing its neighbour twice", i == 40);
+
+    pcsl_mem_free(d);
+    pcsl_mem_free(c);
+
+    spcAfter = pcsl_mem_get_free_heap();
+
+    if (spcAfter != -1) {
+        assertTrue("free heap not restored after a double free",
+                   spcBefore == spcAfter);
+    }
+}
+
 /*
  * Unit test framework entry point for this set of unit tests.
  *
@@ -298,6 +397,8 @@ void testMem_runTests() {
   testCalloc();
   testRealloc();
   testStrdup();
+  testFreeOrder();
+  testFreeAfterMerge();
 
   pcsl_mem_finalize();
 }